@@ -74,6 +74,26 @@ static void systmr_interrupt(void)
     }
 }
 
+/// Fetch tick counter (including unserviced ticks) and PIT value that belong together
+static systmr_ticks_t systmr_get_counter_and_count(u32_t *count)
+{
+    systmr_ticks_t ticks;
+    u32_t          piir;
+
+    // Reading PIIR does not acknowledge the interrupt, but the ISR resets 
+    // PICNT when it adds it to the counter. Repeat if the ISR ran in between.
+    do
+    {
+        ticks = systmr_tick_counter;
+        piir  = AT91C_BASE_PITC->PITC_PIIR;
+    }
+    while(ticks != systmr_tick_counter);
+
+    *count = piir & AT91C_PITC_CPIV;
+
+    return ticks + (piir >> 20);
+}
+
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void systmr_init(void)
 {
@@ -81,8 +101,7 @@ void systmr_init(void)
     systmr_tick_counter  = 0;    
 
     // Initialize and enable the PIT
-    AT91C_BASE_PITC->PITC_PIMR  = (  AT91C_PITC_PIV 
-                                   & (DIV_ROUND(DIV_ROUND(BOARD_MCK,16),SYSTMR_TICKS_PER_SEC)-1));
+    AT91C_BASE_PITC->PITC_PIMR  = (AT91C_PITC_PIV & (SYSTMR_COUNTS_PER_TICK-1));
     AT91C_BASE_PITC->PITC_PIMR |= AT91C_PITC_PITEN;    
 
     // Disable the interrupt on the interrupt controller
@@ -111,6 +130,37 @@ systmr_ticks_t systmr_get_counter(void)
     return counter;
 }
 
+systmr_timestamp_t systmr_get_timestamp(void)
+{
+    systmr_ticks_t ticks;
+    u32_t          count;
+
+    ticks = systmr_get_counter_and_count(&count);
+
+    return (systmr_timestamp_t)ticks*SYSTMR_COUNTS_PER_TICK + count;
+}
+
+u32_t systmr_get_timestamp_us(void)
+{
+    systmr_ticks_t ticks;
+    u32_t          count;
+
+    ticks = systmr_get_counter_and_count(&count);
+
+    return ticks*SYSTMR_US_PER_TICK + count*SYSTMR_US_PER_TICK/SYSTMR_COUNTS_PER_TICK;
+}
+
+void systmr_idle(systmr_ticks_t ticks)
+{
+    if(ticks == 0)
+    {
+        return;
+    }
+
+    // Disable processor clock; it is re-enabled by any enabled interrupt
+    AT91C_BASE_PMC->PMC_SCDR = AT91C_PMC_PCK;
+}
+
 /* _____LOG__________________________________________________________________ */
 /*
 
@@ -119,5 +169,9 @@ systmr_ticks_t systmr_get_counter(void)
  
  2010/04/21 : Pieter.Conradie
  - Renamed from pitd to systmr
+
+ 2026/10/19 : agent
+ - Added systmr_idle()
+ - Added systmr_get_timestamp() and systmr_get_timestamp_us()
    
 */
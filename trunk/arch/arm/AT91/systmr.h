@@ -68,10 +68,22 @@
 /// The number of timer ticks per second
 #define SYSTMR_TICKS_PER_SEC 1000ul
 
+/// Number of PIT counts per tick (the PIT is clocked at MCK/16)
+#define SYSTMR_COUNTS_PER_TICK      DIV_ROUND(DIV_ROUND(BOARD_MCK,16),SYSTMR_TICKS_PER_SEC)
+
+/// Number of timestamp counts per second (see systmr_get_timestamp())
+#define SYSTMR_TIMESTAMP_PER_SEC    (SYSTMR_COUNTS_PER_TICK*SYSTMR_TICKS_PER_SEC)
+
+/// Number of microseconds per tick
+#define SYSTMR_US_PER_TICK          (1000000ul/SYSTMR_TICKS_PER_SEC)
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /// Size definition of the tick counter
 typedef u32_t systmr_ticks_t;
 
+/// Timestamp in PIT counts (see systmr_get_timestamp())
+typedef u32_t systmr_timestamp_t;
+
 /* _____DEFINITIONS _________________________________________________________ */
 
 /* _____TYPE DEFINITIONS_____________________________________________________ */
@@ -91,7 +103,53 @@ extern void systmr_init(void);
  */
 extern systmr_ticks_t systmr_get_counter(void);
 
+/**
+ * Stop the processor clock until the next interrupt (wait for interrupt).
+ * 
+ * The PIT interval is not changed (no tickless mode), so the CPU is woken
+ * at least every tick.
+ * 
+ * @param ticks     Number of ticks until the next deadline; 0 returns 
+ *                  immediately
+ */
+extern void systmr_idle(systmr_ticks_t ticks);
+
+/**
+ *  Fetch a high resolution timestamp.
+ *  
+ *  The timestamp is the number of PIT counts since systmr_init(), i.e. 
+ *  the tick counter multiplied with #SYSTMR_COUNTS_PER_TICK plus the current
+ *  PIT (CPIV) value. A tick that has elapsed, but has not been serviced yet, is 
+ *  accounted for. Convert the difference of two timestamps to microseconds 
+ *  with SYSTMR_TIMESTAMP_TO_US().
+ *  
+ *  May be called from an interrupt.
+ *  
+ *  @return systmr_timestamp_t  Timestamp (#SYSTMR_TIMESTAMP_PER_SEC counts
+ *                              per second)
+ */
+extern systmr_timestamp_t systmr_get_timestamp(void);
+
+/**
+ *  Fetch a timestamp in microseconds.
+ *  
+ *  Same as systmr_get_timestamp(), but scaled to microseconds. The value
+ *  wraps after 2^32 us (71 minutes) or when the tick counter wraps, 
+ *  whichever comes first.
+ *  
+ *  @return u32_t   Timestamp in microseconds
+ */
+extern u32_t systmr_get_timestamp_us(void);
+
 /* _____MACROS_______________________________________________________________ */
+/**
+ *  Convert a number of timestamp counts to microseconds.
+ *  
+ *  @param[in] counts   Timestamp difference (evaluated twice)
+ */
+#define SYSTMR_TIMESTAMP_TO_US(counts) \
+    (  ((u32_t)(counts)/SYSTMR_COUNTS_PER_TICK)*SYSTMR_US_PER_TICK \
+     + ((u32_t)(counts)%SYSTMR_COUNTS_PER_TICK)*SYSTMR_US_PER_TICK/SYSTMR_COUNTS_PER_TICK)
 
 /**
  *  @}
@@ -46,6 +46,7 @@
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "usart0.h"
 #include "ring_buffer.h"
+#include "prof.h"
 #include "board.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
@@ -67,12 +68,18 @@ static bool_t        usart0_tx_finished_flag;
 /// List of pins that must be configured for use by the application.
 static const Pin USART0_Pins[] = {PIN_USART0_TXD, PIN_USART0_RXD};
 
+#if USART0_RX_TASK
+/// Task that is made ready when data is received
+static sched_task_t *usart0_rx_task;
+#endif
+
 /* _____LOCAL FUNCTION PROTOTYPES____________________________________________ */
 
 /* _____MACROS_______________________________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
-static void usart0_interrupt(void)
+/// Service USART0 (called by interrupt handler)
+static inline void usart0_service(void)
 {
     u8_t data;
 
@@ -93,6 +100,14 @@ static void usart0_interrupt(void)
         // Read character and buffer it
         data = (char)(AT91C_BASE_US0->US_RHR);
         ring_buffer_write_byte(&usart0_rx_ring_buffer, data);
+
+#if USART0_RX_TASK
+        // Make waiting task ready
+        if(usart0_rx_task != NULL)
+        {
+            SCHED_TASK_READY(usart0_rx_task);
+        }
+#endif
     }
 
     // See if the transmitter is ready
@@ -125,6 +140,14 @@ static void usart0_interrupt(void)
     }
 }
 
+/// Interrupt handler
+static void usart0_interrupt(void)
+{
+    PROF_BEGIN(PROF_ID_UART0);
+    usart0_service();
+    PROF_END(PROF_ID_UART0);
+}
+
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void usart0_init(void)
 {
@@ -244,11 +267,22 @@ u16_t usart0_tx_data(const u8_t* data, u16_t bytes_to_send)
     return u16BytesSent;
 }
 
+#if USART0_RX_TASK
+void usart0_set_rx_task(sched_task_t *task)
+{
+    usart0_rx_task = task;
+}
+#endif
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2008/08/06 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added usart0_set_rx_task() (USART0_RX_TASK)
+ - Added profiler markers (PROF)
    
 */
 
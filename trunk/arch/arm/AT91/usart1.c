@@ -46,6 +46,7 @@
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "usart1.h"
 #include "ring_buffer.h"
+#include "prof.h"
 #include "board.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
@@ -67,12 +68,18 @@ static bool_t        usart1_tx_finished_flag;
 /// List of pins that must be configured for use by the application.
 static const Pin USART1_Pins[] = {PIN_USART1_TXD, PIN_USART1_RXD};
 
+#if USART1_RX_TASK
+/// Task that is made ready when data is received
+static sched_task_t *usart1_rx_task;
+#endif
+
 /* _____LOCAL FUNCTION PROTOTYPES____________________________________________ */
 
 /* _____MACROS_______________________________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
-static void usart1_interrupt(void)
+/// Service USART1 (called by interrupt handler)
+static inline void usart1_service(void)
 {
     u8_t data;
 
@@ -93,6 +100,14 @@ static void usart1_interrupt(void)
         // Read character and buffer it
         data = (char)(AT91C_BASE_US1->US_RHR);
         ring_buffer_write_byte(&usart1_rx_ring_buffer, data);
+
+#if USART1_RX_TASK
+        // Make waiting task ready
+        if(usart1_rx_task != NULL)
+        {
+            SCHED_TASK_READY(usart1_rx_task);
+        }
+#endif
     }
 
     // See if the transmitter is ready
@@ -125,6 +140,14 @@ static void usart1_interrupt(void)
     }
 }
 
+/// Interrupt handler
+static void usart1_interrupt(void)
+{
+    PROF_BEGIN(PROF_ID_UART1);
+    usart1_service();
+    PROF_END(PROF_ID_UART1);
+}
+
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void usart1_init(void)
 {
@@ -244,11 +267,22 @@ u16_t usart1_tx_data(const u8_t* data, u16_t bytes_to_send)
     return u16BytesSent;
 }
 
+#if USART1_RX_TASK
+void usart1_set_rx_task(sched_task_t *task)
+{
+    usart1_rx_task = task;
+}
+#endif
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2008/08/06 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added usart1_set_rx_task() (USART1_RX_TASK)
+ - Added profiler markers (PROF)
    
 */
 
@@ -70,8 +70,16 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
+#if USART1_RX_TASK
+#include "sched.h"
+#endif
 
 /* _____DEFINITIONS _________________________________________________________ */
+#ifndef USART1_RX_TASK
+/// Flag to make a scheduler task ready when data is received (see usart1_set_rx_task())
+#define USART1_RX_TASK 0
+#endif
+
 /// Default BAUD rate
 #ifndef USART1_BAUD
 #define USART1_BAUD           115200ul
@@ -187,6 +195,18 @@ extern bool_t usart1_tx_byte(u8_t data);
 extern u16_t usart1_tx_data(const u8_t *data, 
                             u16_t      bytes_to_send);
 
+#if USART1_RX_TASK
+/**
+ *  Set the task that must be made ready when data is received.
+ * 
+ *  The task can wait for received data with 
+ *  SCHED_WAIT_UNTIL(task, usart1_get_rx_byte(&data)).
+ * 
+ *  @param[in] task     Pointer to task object; NULL to clear
+ */
+extern void usart1_set_rx_task(sched_task_t *task);
+#endif
+
 /* _____MACROS_______________________________________________________________ */
 
 /**
@@ -0,0 +1,64 @@
+#ifndef __BOOT_KEYS_H__
+#define __BOOT_KEYS_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Bootloader firmware image keys
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup AVR_FW_IMAGE
+ *  
+ *  Keys used to decrypt and authenticate firmware images (see fw_image.h). 
+ *  
+ *  The same file is used to build the bootloader and the host tool 
+ *  fw_encrypt.c.
+ *  
+ *  @warning These are example keys that are published with the source code.
+ *           Replace them with your own random keys and keep this file secret.
+ *           Use different keys for encryption and authentication.
+ */
+
+/* _____DEFINITIONS _________________________________________________________ */
+/// 128-bit key for XTEA-CTR encryption of payload
+#define BOOT_KEY_ENC    {0x3a, 0x91, 0x5c, 0x07, 0xe2, 0x4f, 0xb8, 0x16, \
+                         0x6d, 0xc3, 0x28, 0x9e, 0x51, 0xf4, 0x0b, 0x87}
+
+/// 128-bit key for XTEA CBC-MAC
+#define BOOT_KEY_MAC    {0xc5, 0x2e, 0x73, 0xa9, 0x14, 0xdb, 0x60, 0x8f, \
+                         0xb7, 0x49, 0x05, 0xe1, 0x9a, 0x3c, 0xf6, 0x22}
+
+#endif
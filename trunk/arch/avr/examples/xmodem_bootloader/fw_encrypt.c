@@ -0,0 +1,197 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Host tool to create an encrypted firmware image
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Creates an encrypted and authenticated firmware image (see fw_image.h) 
+ * from a binary file for the XMODEM bootloader.
+ * 
+ * Build on a PC (from this directory):
+ *   gcc -O2 -I. -I<trunk>/general -I<trunk>/protocol -I<dir with empty board.h>
+ *       fw_encrypt.c <trunk>/protocol/xtea.c -o fw_encrypt
+ * 
+ * Usage:
+ *   fw_encrypt <version> <application.bin> <application.img>
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "xtea.h"
+#include "fw_image.h"
+#include "boot_keys.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Maximum size of binary file (largest AVR FLASH)
+#define FW_SIZE_MAX (256ul*1024ul)
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static const u8_t fw_key_enc[XTEA_KEY_SIZE] = BOOT_KEY_ENC;
+static const u8_t fw_key_mac[XTEA_KEY_SIZE] = BOOT_KEY_MAC;
+
+static u8_t fw_image[FW_IMAGE_HEADER_SIZE + FW_SIZE_MAX + 1];
+
+static u8_t fw_mac_block[XTEA_BLOCK_SIZE];
+static u8_t fw_mac_index;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static void fw_store_be32(u8_t *p, u32_t val)
+{
+    p[0] = U32_HI8(val);
+    p[1] = U32_MH8(val);
+    p[2] = U32_ML8(val);
+    p[3] = U32_LO8(val);
+}
+
+/// Update CBC-MAC (same as boot_mac_update() in main.c)
+static void fw_mac_update(xtea_ctx_t *ctx, const u8_t *data, size_t length)
+{
+    while(length--)
+    {
+        fw_mac_block[fw_mac_index++] = *data++;
+        if(fw_mac_index == XTEA_BLOCK_SIZE)
+        {
+            xtea_cbc_encrypt(ctx, fw_mac_block, fw_mac_block, XTEA_BLOCK_SIZE);
+            fw_mac_index = 0;
+        }
+    }
+}
+
+static bool_t fw_random(u8_t *data, size_t length)
+{
+    FILE   *f  = fopen("/dev/urandom", "rb");
+    bool_t ok;
+
+    if(f == NULL)
+    {
+        return FALSE;
+    }
+    ok = (fread(data, 1, length, f) == length);
+    fclose(f);
+
+    return ok;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+int main(int argc, char *argv[])
+{
+    FILE       *f;
+    long       version;
+    size_t     length;
+    u8_t       zero_iv[XTEA_BLOCK_SIZE] = {0};
+    u8_t       *header  = &fw_image[0];
+    u8_t       *payload = &fw_image[FW_IMAGE_HEADER_SIZE];
+    xtea_ctx_t ctx;
+
+    if(argc != 4)
+    {
+        fprintf(stderr, "Usage: %s <version> <application.bin> <application.img>\n", argv[0]);
+        return 1;
+    }
+    version = strtol(argv[1], NULL, 0);
+    if((version < 0) || (version > 0xfffe))
+    {
+        fprintf(stderr, "Version must be 0 to 65534\n");
+        return 1;
+    }
+
+    // Read binary file
+    f = fopen(argv[2], "rb");
+    if(f == NULL)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    length = fread(payload, 1, FW_SIZE_MAX + 1, f);
+    fclose(f);
+    if((length == 0) || (length > FW_SIZE_MAX))
+    {
+        fprintf(stderr, "Binary file must be 1 to %lu bytes\n", FW_SIZE_MAX);
+        return 1;
+    }
+
+    // Header
+    header[FW_IMAGE_OFFSET_MAGIC+0]   = FW_IMAGE_MAGIC0;
+    header[FW_IMAGE_OFFSET_MAGIC+1]   = FW_IMAGE_MAGIC1;
+    header[FW_IMAGE_OFFSET_MAGIC+2]   = FW_IMAGE_MAGIC2;
+    header[FW_IMAGE_OFFSET_MAGIC+3]   = FW_IMAGE_MAGIC3;
+    header[FW_IMAGE_OFFSET_VERSION+0] = (u8_t)(version >> 8);
+    header[FW_IMAGE_OFFSET_VERSION+1] = (u8_t)version;
+    fw_store_be32(&header[FW_IMAGE_OFFSET_LENGTH], (u32_t)length);
+    if(!fw_random(&header[FW_IMAGE_OFFSET_IV], XTEA_BLOCK_SIZE))
+    {
+        fprintf(stderr, "Could not generate random IV\n");
+        return 1;
+    }
+
+    // Encrypt payload
+    xtea_ctx_init(&ctx, fw_key_enc, &header[FW_IMAGE_OFFSET_IV]);
+    xtea_ctr_crypt(&ctx, payload, payload, length);
+
+    // CBC-MAC over header (excluding MAC) and encrypted payload padded with zeros
+    xtea_ctx_init(&ctx, fw_key_mac, zero_iv);
+    fw_mac_update(&ctx, header, FW_IMAGE_MAC_HEADER_SIZE);
+    fw_mac_update(&ctx, payload, length);
+    if(fw_mac_index != 0)
+    {
+        fw_mac_update(&ctx, zero_iv, XTEA_BLOCK_SIZE - fw_mac_index);
+    }
+    memcpy(&header[FW_IMAGE_OFFSET_MAC], fw_mac_block, XTEA_BLOCK_SIZE);
+
+    // Write image
+    f = fopen(argv[3], "wb");
+    if(f == NULL)
+    {
+        perror(argv[3]);
+        return 1;
+    }
+    if(fwrite(fw_image, 1, FW_IMAGE_HEADER_SIZE + length, f) != FW_IMAGE_HEADER_SIZE + length)
+    {
+        perror(argv[3]);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    printf("%s: version %ld, %lu bytes\n", argv[3], version, (unsigned long)length);
+
+    return 0;
+}
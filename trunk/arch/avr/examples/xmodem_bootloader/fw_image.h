@@ -0,0 +1,118 @@
+#ifndef __FW_IMAGE_H__
+#define __FW_IMAGE_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Encrypted firmware image format
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup AVR_XMODEM_BOOTLOADER
+ *  @defgroup AVR_FW_IMAGE fw_image.h : Encrypted firmware image format
+ *
+ *  Format of an encrypted and authenticated firmware image that is accepted
+ *  by the XMODEM bootloader. An image is created from a binary file with the
+ *  host tool fw_encrypt.c.
+ *  
+ *  Files: fw_image.h & boot_keys.h
+ *  
+ *  @par Layout
+ *  The image starts with a 32-byte header, followed by the payload. All 
+ *  values are big endian.
+ *  @code
+ *  Offset  Size  Description
+ *  0       4     Magic "PFW1"
+ *  4       2     Version of firmware
+ *  6       2     Reserved (0)
+ *  8       4     Length of payload in bytes
+ *  12      4     Reserved (0)
+ *  16      8     IV (initial counter block for XTEA-CTR); random for each image
+ *  24      8     MAC (XTEA CBC-MAC)
+ *  32      ...   Payload (XTEA-CTR encrypted binary file)
+ *  @endcode
+ *  
+ *  @par Encryption and authentication
+ *  The payload is encrypted in CTR mode with the encryption key and the 
+ *  IV in the header. The MAC is an XTEA CBC-MAC (zero IV) with the 
+ *  separate MAC key, calculated over the first 24 bytes of the header 
+ *  followed by the encrypted payload, padded with zeros to a multiple of 
+ *  8 bytes (encrypt-then-MAC). Plain CBC-MAC is only secure for messages
+ *  of one fixed length. Here every MAC'd message starts with a header of 
+ *  fixed size (24 bytes) that contains the payload length (second 8-byte 
+ *  block) and the bootloader MACs exactly that number of payload bytes, so
+ *  no authenticated image is a prefix of another one and the CBC-MAC is 
+ *  secure for variable length images.
+ *  
+ *  @par Version
+ *  The version (0 to 0xFFFE) is authenticated with the rest of the header.
+ *  The bootloader rejects an image with a lower version than the installed
+ *  image, so that an old image can not be installed again.
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+
+/* _____DEFINITIONS _________________________________________________________ */
+/// Size of image header in bytes
+#define FW_IMAGE_HEADER_SIZE        32
+
+/// @name Offset of header fields
+//@{
+#define FW_IMAGE_OFFSET_MAGIC       0
+#define FW_IMAGE_OFFSET_VERSION     4
+#define FW_IMAGE_OFFSET_LENGTH      8
+#define FW_IMAGE_OFFSET_IV          16
+#define FW_IMAGE_OFFSET_MAC         24
+//@}
+
+/// Number of header bytes that are included in the MAC
+#define FW_IMAGE_MAC_HEADER_SIZE    24
+
+/// @name Magic value
+//@{
+#define FW_IMAGE_MAGIC0             'P'
+#define FW_IMAGE_MAGIC1             'F'
+#define FW_IMAGE_MAGIC2             'W'
+#define FW_IMAGE_MAGIC3             '1'
+//@}
+
+/**
+ * @}
+ */
+#endif
@@ -43,13 +43,43 @@
  * 
  * This is an example of how to implement a bootloader on the Atmel AVR. 
  *  
- * It is a simple bootloader that accepts a new binary application file 
+ * It is a simple bootloader that accepts a new encrypted application image 
  * transferred over the serial port using the XMODEM-CRC protocol. 
  * 
+ * @par Image format
+ * 
+ * The XMODEM CRC only protects each packet against transmission errors. 
+ * To keep the firmware confidential and to make sure that only authentic
+ * firmware is executed, the image is encrypted with XTEA in CTR mode and 
+ * authenticated with an XTEA CBC-MAC (see fw_image.h and boot_keys.h).
+ * 
+ * The payload is decrypted inline in on_rx_data() as packets stream in,
+ * directly into the flash page buffer, and the MAC is updated with the 
+ * encrypted data, so no extra copy of the data is needed. XMODEM waits for 
+ * an ACK after each packet, so decryption and flash writes throttle the 
+ * transfer instead of losing data.
+ * 
+ * The first flash page (with the reset vector) is cleared before any 
+ * other page of the old application is overwritten, so that a reset or 
+ * power failure during the transfer leaves no bootable (partial, 
+ * unauthenticated) image. The new first page is kept in RAM and only 
+ * written once the whole image has been received and the MAC is correct.
+ * This marks the image as bootable. If the MAC is wrong, the bootloader 
+ * waits for a new image instead of executing the application.
+ * 
+ * The version of the installed image is stored in the last two bytes of 
+ * EEPROM. An image with a lower version is rejected to prevent a roll 
+ * back to an older (authentic) image with known flaws. An erased EEPROM 
+ * (0xFFFF) accepts any version.
+ * 
+ * The bootloader is built with XTEA_KEY_SCHEDULE=0 (compact XTEA without 
+ * precomputed round keys) to fit the bootloader section.
+ * 
  * @par How to use the XMODEM-CRC bootloader
  * 
  * 1. Compile and link the firmware application and generate a @b binary programming
- * file (not Intel HEX!)
+ * file (not Intel HEX!). Encrypt it with the host tool fw_encrypt.c, e.g.
+ * "fw_encrypt 1 led_blink.bin led_blink.img"
  * 
  * <em>Use "arch/avr/examples/led_blink/led_blink.bin" as a first test.</em>
  * 
@@ -92,6 +122,7 @@
 #include <string.h>
 #include <avr/io.h>
 #include <avr/pgmspace.h>
+#include <avr/eeprom.h>
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
@@ -99,57 +130,275 @@
 #include "uart_poll.h"
 #include "xmodem.h"
 #include "flash.h"
+#include "xtea.h"
+#include "fw_image.h"
+#include "boot_keys.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 #define FLASH_BOOT_SIZE          (FLASHEND+1-FLASH_BOOT_START)
 #define FLASH_BOOT_PAGE_START    ((FLASHEND+1-FLASH_BOOT_SIZE)/FLASH_PAGE_SIZE)
 #define FLASH_START_PAGE         (0)
 
+/// Maximum size of application in bytes
+#define FLASH_APP_SIZE_MAX       ((u32_t)FLASH_BOOT_PAGE_START*FLASH_PAGE_SIZE)
+
+/// EEPROM address of installed image version (0xFFFF if none)
+#define BOOT_EEPROM_VERSION      ((uint16_t *)(E2END-1))
+
+/// State of image reception
+typedef enum
+{
+    BOOT_STATE_HEADER = 0,  ///< Waiting for image header
+    BOOT_STATE_PAYLOAD,     ///< Receiving payload
+    BOOT_STATE_ERROR,       ///< Invalid header; rest of transfer is ignored
+} boot_state_t;
+
 /* _____MACROS_______________________________________________________________ */
+/// Load big endian 32-bit value from byte array
+#define BOOT_LOAD_BE32(p)  (  (((u32_t)(p)[0])<<24) | (((u32_t)(p)[1])<<16) \
+                            | (((u32_t)(p)[2])<<8)  | ((u32_t)(p)[3])       )
 
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____LOCAL VARIABLES______________________________________________________ */
 static u8_t  flash_buffer[FLASH_PAGE_SIZE];
+static u8_t  flash_first_page[FLASH_PAGE_SIZE];
 static u16_t flash_page;
 static u16_t index;
 
+static boot_state_t boot_state;
+static u32_t        boot_bytes_remaining;
+static u16_t        boot_version;
+static xtea_ctx_t   boot_ctx_enc;
+static xtea_ctx_t   boot_ctx_mac;
+static u8_t         boot_mac_block[XTEA_BLOCK_SIZE];
+static u8_t         boot_mac_index;
+static u8_t         boot_mac_expected[XTEA_BLOCK_SIZE];
+
+static const u8_t   boot_key_enc[XTEA_KEY_SIZE] = BOOT_KEY_ENC;
+static const u8_t   boot_key_mac[XTEA_KEY_SIZE] = BOOT_KEY_MAC;
+
 /* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
-/// Handler function that is called when an XMODEM packet is received
-static void on_rx_data(u8_t* data, u8_t bytes_received)
+/// Update CBC-MAC with (encrypted) data
+static void boot_mac_update(const u8_t* data, u8_t length)
 {
-    u16_t i = index;
+    u8_t i = boot_mac_index;
 
-    // Concatenate received data
-    while(bytes_received--)
+    while(length--)
     {
-        flash_buffer[i++] = *data++;
+        boot_mac_block[i++] = *data++;
+        if(i == XTEA_BLOCK_SIZE)
+        {
+            // Encrypt in place; last result is the MAC
+            xtea_cbc_encrypt(&boot_ctx_mac, boot_mac_block, boot_mac_block, XTEA_BLOCK_SIZE);
+            i = 0;
+        }
     }
-    index = i;
+    boot_mac_index = i;
+}
 
-    // See if enough data has been received for one flash page
-    if(index < FLASH_PAGE_SIZE) return;
+/// Parse and authenticate image header at start of first packet
+static bool_t boot_parse_header(const u8_t* data)
+{
+    u8_t  i;
+    u8_t  zero_iv[XTEA_BLOCK_SIZE];
+    u16_t installed;
 
-    LED_ON();
+    if(  (data[FW_IMAGE_OFFSET_MAGIC+0] != FW_IMAGE_MAGIC0)
+       ||(data[FW_IMAGE_OFFSET_MAGIC+1] != FW_IMAGE_MAGIC1)
+       ||(data[FW_IMAGE_OFFSET_MAGIC+2] != FW_IMAGE_MAGIC2)
+       ||(data[FW_IMAGE_OFFSET_MAGIC+3] != FW_IMAGE_MAGIC3)  )
+    {
+        return FALSE;
+    }
+
+    // Reject roll back to an older version (version is authenticated by MAC)
+    boot_version = ((u16_t)data[FW_IMAGE_OFFSET_VERSION] << 8) | data[FW_IMAGE_OFFSET_VERSION+1];
+    installed    = eeprom_read_word(BOOT_EEPROM_VERSION);
+    if(  (boot_version == 0xFFFF)
+       ||((installed != 0xFFFF) && (boot_version < installed))  )
+    {
+        return FALSE;
+    }
 
-    // Reset receive index
-    index = 0;
+    boot_bytes_remaining = BOOT_LOAD_BE32(&data[FW_IMAGE_OFFSET_LENGTH]);
+    if((boot_bytes_remaining == 0) || (boot_bytes_remaining > FLASH_APP_SIZE_MAX))
+    {
+        return FALSE;
+    }
+
+    for(i=0; i<XTEA_BLOCK_SIZE; i++)
+    {
+        zero_iv[i]           = 0;
+        boot_mac_expected[i] = data[FW_IMAGE_OFFSET_MAC+i];
+    }
+
+    // Payload is decrypted with the IV in the header
+    xtea_ctx_init(&boot_ctx_enc, boot_key_enc, &data[FW_IMAGE_OFFSET_IV]);
+
+    // MAC starts with header (excluding MAC field)
+    xtea_ctx_init(&boot_ctx_mac, boot_key_mac, zero_iv);
+    boot_mac_index = 0;
+    boot_mac_update(data, FW_IMAGE_MAC_HEADER_SIZE);
+
+    return TRUE;
+}
+
+/// Write flash page (except first page, which is written by boot_finish())
+static void boot_write_page(void)
+{
+    if(flash_page == (FLASH_START_PAGE+1))
+    {
+        // Old application is not bootable once it is being overwritten
+        flash_clear_page(FLASH_START_PAGE);
+    }
+
+    LED_ON();
 
     // Write flash page
     flash_write_page(flash_page, flash_buffer);
 
-    // Next page
-    flash_page++;
+    LED_OFF();
+}
+
+/// Handler function that is called when an XMODEM packet is received
+static void on_rx_data(u8_t* data, u8_t bytes_received)
+{
+    u8_t  *buffer;
+    u16_t chunk;
+
+    if(boot_state == BOOT_STATE_HEADER)
+    {
+        // Header is at start of first packet
+        if(!boot_parse_header(data))
+        {
+            boot_state = BOOT_STATE_ERROR;
+            return;
+        }
+        boot_state      = BOOT_STATE_PAYLOAD;
+        data           += FW_IMAGE_HEADER_SIZE;
+        bytes_received -= FW_IMAGE_HEADER_SIZE;
+    }
+
+    if(boot_state != BOOT_STATE_PAYLOAD)
+    {
+        return;
+    }
 
-    // Wrap if in bootloader section
-    if(flash_page >= FLASH_BOOT_PAGE_START)
+    // Discard XMODEM padding after end of payload
+    if(bytes_received > boot_bytes_remaining)
     {
-        flash_page = 0;
+        bytes_received = (u8_t)boot_bytes_remaining;
     }
+    boot_bytes_remaining -= bytes_received;
 
-    LED_OFF();
+    // Authenticate encrypted data
+    boot_mac_update(data, bytes_received);
+
+    while(bytes_received != 0)
+    {
+        // First page is kept in RAM until image has been authenticated
+        buffer = (flash_page == FLASH_START_PAGE) ? flash_first_page : flash_buffer;
+
+        // Decrypt directly into page buffer
+        chunk = FLASH_PAGE_SIZE - index;
+        if(chunk > bytes_received)
+        {
+            chunk = bytes_received;
+        }
+        xtea_ctr_crypt(&boot_ctx_enc, data, &buffer[index], chunk);
+        data           += chunk;
+        bytes_received -= chunk;
+        index          += chunk;
+
+        // See if enough data has been received for one flash page
+        if(index < FLASH_PAGE_SIZE)
+        {
+            break;
+        }
+
+        // Reset receive index
+        index = 0;
+
+        if(flash_page != FLASH_START_PAGE)
+        {
+            boot_write_page();
+        }
+
+        // Next page
+        flash_page++;
+    }
+}
+
+/// Finish reception and write first page if the image is authentic
+static bool_t boot_finish(void)
+{
+    u8_t   i;
+    u8_t   *buffer;
+    bool_t authentic = TRUE;
+
+    if((boot_state != BOOT_STATE_PAYLOAD) || (boot_bytes_remaining != 0))
+    {
+        return FALSE;
+    }
+
+    // Pad last MAC block with zeros
+    if(boot_mac_index != 0)
+    {
+        for(i=boot_mac_index; i<XTEA_BLOCK_SIZE; i++)
+        {
+            boot_mac_block[i] = 0;
+        }
+        xtea_cbc_encrypt(&boot_ctx_mac, boot_mac_block, boot_mac_block, XTEA_BLOCK_SIZE);
+    }
+
+    // Compare all bytes (constant time)
+    for(i=0; i<XTEA_BLOCK_SIZE; i++)
+    {
+        if(boot_mac_block[i] != boot_mac_expected[i])
+        {
+            authentic = FALSE;
+        }
+    }
+    if(!authentic)
+    {
+        return FALSE;
+    }
+
+    // Commit last received page
+    if(index != 0)
+    {
+        // Clear rest of flash page
+        buffer = (flash_page == FLASH_START_PAGE) ? flash_first_page : flash_buffer;
+        while(index < FLASH_PAGE_SIZE)
+        {
+            buffer[index++] = 0xFF;
+        }
+        if(flash_page != FLASH_START_PAGE)
+        {
+            boot_write_page();
+        }
+        flash_page++;
+    }
+
+#ifdef BOOT_CLEAR_REST_OF_FLASH
+    // Clear rest of flash pages
+    while(flash_page < FLASH_BOOT_PAGE_START)
+    {
+        flash_clear_page(flash_page++);
+    }
+#endif
+
+    // Save version of installed image
+    eeprom_write_word(BOOT_EEPROM_VERSION, boot_version);
+    eeprom_busy_wait();
+
+    // Write first page last to mark image as bootable
+    flash_write_page(FLASH_START_PAGE, flash_first_page);
+
+    return TRUE;
 }
 
 /* _____PUBLIC FUNCTIONS_____________________________________________________ */
@@ -168,41 +417,20 @@ int main(void)
     // Wait 50 ms for RS232 driver to charge capacitors
     tmr_poll_wait(TMR_POLL_MS_TO_START_VAL(50));
 
-    // Receive new flash content via XMODEM-CRC protocol
-    flash_page = FLASH_START_PAGE;
-    index      = 0;
-
-    if(xmodem_rx_file(&on_rx_data))
+    do
     {
-        // Commit last received page
-        if(index != 0)
-        {
-
-#ifdef BOOT_CLEAR_REST_OF_FLASH
-            // Clear rest of flash page
-            u16_t i = index;
-            while(i < FLASH_PAGE_SIZE)
-            {
-                flash_buffer[i++] = 0xFF;
-            }
-#endif
-            // Write flash page
-            flash_write_page(flash_page,flash_buffer);
+        // Receive new flash content via XMODEM-CRC protocol
+        flash_page = FLASH_START_PAGE;
+        index      = 0;
+        boot_state = BOOT_STATE_HEADER;
 
-#ifdef BOOT_CLEAR_REST_OF_FLASH
-            // Next page
-            flash_page++;
-#endif
-        }
-
-#ifdef BOOT_CLEAR_REST_OF_FLASH
-        // Clear rest of flash pages
-        while(flash_page < FLASH_BOOT_PAGE_START)
+        if(xmodem_rx_file(&on_rx_data) && boot_finish())
         {
-            flash_clear_page(flash_page++);
+            break;
         }
-#endif
     }
+    // Stay in bootloader while there is no valid application
+    while(pgm_read_word_near(0x0000) == 0xFFFF);
 
     // Execute application
 #if (FLASHEND < 8*1024)
@@ -223,5 +451,10 @@ int main(void)
 
  2007-04-27 : Pieter Conradie
  - First release
+
+ 2026/10/19 : agent
+ - Accept only encrypted and authenticated images (XTEA-CTR + CBC-MAC)
+ - Clear first page before application is overwritten
+ - Reject images with a lower version than the installed image
    
 */
@@ -40,11 +40,33 @@
 /* _____STANDARD INCLUDES____________________________________________________ */
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "systmr.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
+/**
+ * Microseconds per TMR1 count in Q15 fixed point format. It is used to 
+ * convert TCNT1 without a 32-bit division.
+ */
+#define SYSTMR_US_PER_COUNT_Q15 DIV_ROUND(SYSTMR_US_PER_TICK*32768ul, SYSTMR_COUNTS_PER_TICK)
+
+#if (SYSTMR_US_PER_COUNT_Q15 > 65535)
+#error "TMR1 clock too slow for systmr_get_timestamp_us()"
+#endif
+
+#if SYSTMR_TICKLESS
+/**
+ * Minimum number of TMR1 counts before a compare match to safely 
+ * reprogram OCR1A (an update must be written before TCNT1 passes it).
+ */
+#define SYSTMR_TICKLESS_MARGIN  16
+
+#if (SYSTMR_TICKLESS_TICKS_MAX < 2)
+#error "SYSTMR_TICKLESS is not useful with this F_CPU and SYSTMR_TICKS_PER_SEC"
+#endif
+#endif
 
 /* _____MACROS_______________________________________________________________ */
 
@@ -53,6 +75,17 @@
 /* _____LOCAL VARIABLES______________________________________________________ */
 static volatile systmr_ticks_t systmr_tick_counter;
 
+/// Number of TMR1 counts up to the last compare match (see systmr_get_timestamp())
+static volatile systmr_timestamp_t systmr_timestamp_base;
+
+#if SYSTMR_TICKLESS
+/// Number of ticks that will be added to the counter on the next compare match
+static volatile u8_t systmr_irq_ticks = 1;
+
+/// TCNT1 value of the last tick boundary that has been added to the counter
+static volatile u16_t systmr_count_base;
+#endif
+
 /* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
@@ -61,8 +94,122 @@ static volatile systmr_ticks_t systmr_tick_counter;
  */
 ISR(TIMER1_COMPA_vect)
 {
+#if SYSTMR_TICKLESS
+    // Add ticks and counts of interval that has expired
+    systmr_tick_counter   += systmr_irq_ticks;
+    systmr_timestamp_base += OCR1A + 1;
+
+    // Return to one interrupt per tick
+    systmr_irq_ticks  = 1;
+    systmr_count_base = 0;
+    OCR1A             = SYSTMR_COUNTS_PER_TICK - 1;
+#else
     // Increment counter
     systmr_tick_counter++;
+    systmr_timestamp_base += SYSTMR_COUNTS_PER_TICK;
+#endif
+}
+
+#if SYSTMR_TICKLESS
+/// Extend the current timer interval to span up to 'ticks' ticks
+static void systmr_tickless_enter(systmr_ticks_t ticks)
+{
+    if(ticks > SYSTMR_TICKLESS_TICKS_MAX)
+    {
+        ticks = SYSTMR_TICKLESS_TICKS_MAX;
+    }
+
+    // Only extend a single tick interval if a compare match is not pending or imminent
+    if(  (systmr_irq_ticks != 1)
+       ||BIT_IS_HI(TIFR, OCF1A)
+       ||(TCNT1 >= (SYSTMR_COUNTS_PER_TICK - SYSTMR_TICKLESS_MARGIN)))
+    {
+        return;
+    }
+
+    // TMR1 continues counting from the last tick boundary, so no time is lost
+    systmr_irq_ticks = (u8_t)ticks;
+    OCR1A            = (u16_t)ticks*SYSTMR_COUNTS_PER_TICK - 1;
+}
+
+/// Woken early by another interrupt: account for elapsed ticks
+static void systmr_tickless_exit(void)
+{
+    u16_t count;
+    u16_t boundary;
+    u8_t  elapsed;
+
+    // Compare match pending? ISR will add all ticks of interval
+    if((systmr_irq_ticks == 1) || BIT_IS_HI(TIFR, OCF1A))
+    {
+        return;
+    }
+
+    // Count tick boundaries that have passed since the last counted tick
+    count    = TCNT1;
+    boundary = systmr_count_base + SYSTMR_COUNTS_PER_TICK;
+    elapsed  = 0;
+    while(count >= boundary)
+    {
+        boundary += SYSTMR_COUNTS_PER_TICK;
+        elapsed++;
+    }
+
+    /* 
+     * TMR1 continues counting from the start of the interval, so remember
+     * which TCNT1 value belongs to the tick counter. Otherwise the 
+     * timestamp jumps forward now and back on the next compare match.
+     */
+    systmr_tick_counter += elapsed;
+    systmr_count_base    = boundary - SYSTMR_COUNTS_PER_TICK;
+
+    // Next interrupt on next tick boundary (or the one after if too close)
+    if(count >= (boundary - SYSTMR_TICKLESS_MARGIN))
+    {
+        boundary        += SYSTMR_COUNTS_PER_TICK;
+        systmr_irq_ticks = 2;
+    }
+    else
+    {
+        systmr_irq_ticks = 1;
+    }
+    OCR1A = boundary - 1;
+}
+#endif
+
+/// Fetch tick counter and TCNT1 value that belong together
+static systmr_ticks_t systmr_get_counter_and_count(u16_t *count)
+{
+    systmr_ticks_t ticks;
+    u8_t           sreg = SREG;
+
+    cli();
+
+    ticks  = systmr_tick_counter;
+    *count = TCNT1;
+
+    // Compare match pending? TCNT1 has been cleared, but ISR has not run yet
+    if(BIT_IS_HI(TIFR, OCF1A))
+    {
+        // Read TCNT1 again, because it could have been read before clearing
+        *count = TCNT1;
+#if SYSTMR_TICKLESS
+        ticks += systmr_irq_ticks;
+#else
+        ticks++;
+#endif
+    }
+#if SYSTMR_TICKLESS
+    else
+    {
+        // Counts since the last tick that has been added to the counter
+        *count -= systmr_count_base;
+    }
+#endif
+
+    SREG = sreg;
+
+    return ticks;
 }
 
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
@@ -82,7 +229,7 @@ void systmr_init(void)
     // Calculate and set maximum 16-bit TMR1 counter value.
     // When TCNT1 reaches this value, an interrupt is generated
     // and TCNT1 is reset to 0.
-    OCR1A  = DIV_ROUND(F_CPU/8, SYSTMR_TICKS_PER_SEC)-1;
+    OCR1A  = SYSTMR_COUNTS_PER_TICK-1;
 
     // Enable Timer compare match interrupt
     BIT_SET_HI(TIMSK, OCIE1A);
@@ -92,16 +239,80 @@ systmr_ticks_t systmr_get_counter(void)
 {
     systmr_ticks_t counter;
 
-    // Disable timer interrupt to perform atomic access
-    BIT_SET_LO(TIMSK,OCIE1A);
+    // Fetch current time; repeat if ISR changed it during the multi-byte read
+    do
+    {
+        counter = systmr_tick_counter;
+    }
+    while(counter != systmr_tick_counter);
 
-    // Fetch current time
-    counter = systmr_tick_counter;
+    return counter;
+}
 
-    // Enable timer interrupt
-    BIT_SET_HI(TIMSK,OCIE1A);
+systmr_timestamp_t systmr_get_timestamp(void)
+{
+    systmr_timestamp_t timestamp;
+    u16_t              count;
+    u8_t               sreg = SREG;
 
-    return counter;
+    cli();
+
+    timestamp = systmr_timestamp_base;
+    count     = TCNT1;
+
+    // Compare match pending? TCNT1 has been cleared, but ISR has not run yet
+    if(BIT_IS_HI(TIFR, OCF1A))
+    {
+        // Read TCNT1 again, because it could have been read before clearing
+        count      = TCNT1;
+        timestamp += OCR1A + 1;
+    }
+
+    SREG = sreg;
+
+    return timestamp + count;
+}
+
+u32_t systmr_get_timestamp_us(void)
+{
+    systmr_ticks_t ticks;
+    u16_t          count;
+
+    ticks = systmr_get_counter_and_count(&count);
+
+    return   (u32_t)ticks*SYSTMR_US_PER_TICK 
+           + (((u32_t)count*SYSTMR_US_PER_COUNT_Q15) >> 15);
+}
+
+void systmr_idle(systmr_ticks_t ticks)
+{
+    if(ticks == 0)
+    {
+        return;
+    }
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+
+    // Disable interrupts so that a wake-up event is not missed
+    cli();
+#if SYSTMR_TICKLESS
+    if(ticks > 1)
+    {
+        systmr_tickless_enter(ticks);
+    }
+#endif
+    sleep_enable();
+
+    // The instruction after "sei" is always executed before an interrupt
+    sei();
+    sleep_cpu();
+    sleep_disable();
+
+#if SYSTMR_TICKLESS
+    cli();
+    systmr_tickless_exit();
+    sei();
+#endif
 }
 
 /**
@@ -116,5 +327,11 @@ systmr_ticks_t systmr_get_counter(void)
  
  2010-04-21 : Pieter.Conradie
  - Renamed to "systmr"
+
+ 2026/10/19 : agent
+ - Added systmr_idle() and tickless mode (SYSTMR_TICKLESS)
+ - Added systmr_get_timestamp() and systmr_get_timestamp_us()
+ - systmr_get_counter() reads counter twice instead of disabling interrupt
+ - Added optional 32-bit tick counter (SYSTMR_TICKS_32BIT)
    
 */
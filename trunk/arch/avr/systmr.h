@@ -51,10 +51,69 @@
  *  generate an interrupt during which the internal counter @b systmr_tick_counter
  *  is incremented. systmr_get_counter() must be called to fetch a copy of 
  *  @b systmr_tick_counter in an interrupt safe way.
+ *  
+ *  The counter is read without disabling the timer interrupt: it is read 
+ *  until two consecutive copies are equal. A tick is thousands of cycles 
+ *  long, so the second read is only repeated if the interrupt occured 
+ *  during the first read.
+ *  
+ *  By default the counter is 16-bit and wraps after 65536 ticks (11 minutes
+ *  at 100 ticks per second). Set #SYSTMR_TICKS_32BIT to 1 for a 32-bit 
+ *  counter, which wraps after 497 days at 100 ticks per second.
  * 
  *  See @ref TMR which builds on @ref AVR_SYSTMR to provide multiple software
  *  timers.
  *  
+ *  @par Idle and tickless mode
+ *  systmr_idle() puts the CPU in IDLE sleep mode until the next interrupt.
+ *  Without #SYSTMR_TICKLESS the CPU is woken by every tick. With 
+ *  #SYSTMR_TICKLESS enabled, the compare register is reprogrammed so that 
+ *  the timer interrupt only fires when the specified number of ticks have
+ *  elapsed (up to #SYSTMR_TICKLESS_TICKS_MAX at a time), e.g. the next 
+ *  deadline returned by tmr_wheel_next_deadline(). The 16-bit TMR1 limits
+ *  one interval to 65535 counts: at 7.3728 MHz and 100 ticks per second
+ *  (10 ms ticks, 9216 counts per tick) this is 6 ticks or 60 ms, so the 
+ *  CPU is woken at least every 60 ms. If another interrupt wakes the CPU 
+ *  earlier, the tick counter is corrected with the elapsed ticks and the 
+ *  timer returns to one interrupt per tick, so systmr_get_counter() stays
+ *  correct. TMR1 is not cleared when woken 
+ *  early; the TCNT1 value of the last counted tick is remembered, so that
+ *  the timestamps below stay consistent with the tick counter.
+ *  
+ *  @code
+ *  for(;;)
+ *  {
+ *      tmr_ticks_t ticks;
+ *  
+ *      tmr_wheel_service();
+ *      // ...poll other events...
+ *  
+ *      if(!tmr_wheel_next_deadline(&ticks))
+ *      {
+ *          // No timers running; sleep until any interrupt
+ *          ticks = SYSTMR_TICKLESS_TICKS_MAX;
+ *      }
+ *      systmr_idle(ticks);
+ *  }
+ *  @endcode
+ *  
+ *  @par High resolution timestamp
+ *  systmr_get_timestamp() adds the live TCNT1 value to the number of TMR1
+ *  counts up to the last compare match to measure short intervals (ISR 
+ *  latency, SPI transfers, etc.) with a resolution of one TMR1 count 
+ *  (8/F_CPU, e.g. 1.085 us at 7.3728 MHz). A compare match that has 
+ *  occured but has not been serviced yet (OCF1A pending) is accounted for,
+ *  so the timestamp never jumps backwards, also in tickless mode. The 
+ *  count is 32-bit, independent of #SYSTMR_TICKS_32BIT, so the difference
+ *  of two timestamps is correct modulo 2^32 counts (77 minutes at 
+ *  7.3728 MHz).
+ *  
+ *  @code
+ *  systmr_timestamp_t start = systmr_get_timestamp();
+ *  crc = crc16_calc_block(buffer, length);
+ *  printf("%lu us", SYSTMR_TIMESTAMP_TO_US(systmr_get_timestamp() - start));
+ *  @endcode
+ *  
  *  @par Example:
  *  @include tmr_test.c
  * 
@@ -70,9 +129,38 @@
 #define SYSTMR_TICKS_PER_SEC 100ul
 #endif
 
+#ifndef SYSTMR_TICKS_32BIT
+/// Flag to select a 32-bit tick counter instead of a 16-bit tick counter
+#define SYSTMR_TICKS_32BIT 0
+#endif
+
+#ifndef SYSTMR_TICKLESS
+/// Flag to enable tickless idle mode (see systmr_idle())
+#define SYSTMR_TICKLESS 0
+#endif
+
+/// Number of TMR1 counts per tick (TMR1 is clocked at F_CPU/8)
+#define SYSTMR_COUNTS_PER_TICK  DIV_ROUND(F_CPU/8, SYSTMR_TICKS_PER_SEC)
+
+/// Maximum number of ticks that one timer interrupt can span in tickless mode
+#define SYSTMR_TICKLESS_TICKS_MAX   (65535ul/SYSTMR_COUNTS_PER_TICK - 1)
+
+/// Number of timestamp counts per second (see systmr_get_timestamp())
+#define SYSTMR_TIMESTAMP_PER_SEC    (SYSTMR_COUNTS_PER_TICK*SYSTMR_TICKS_PER_SEC)
+
+/// Number of microseconds per tick
+#define SYSTMR_US_PER_TICK          (1000000ul/SYSTMR_TICKS_PER_SEC)
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /// Size definition of the tick counter
+#if SYSTMR_TICKS_32BIT
+typedef u32_t systmr_ticks_t;
+#else
 typedef u16_t systmr_ticks_t;
+#endif
+
+/// Timestamp in TMR1 counts (see systmr_get_timestamp())
+typedef u32_t systmr_timestamp_t;
 
 /* _____DEFINITIONS _________________________________________________________ */
 
@@ -87,11 +175,68 @@ typedef u16_t systmr_ticks_t;
 extern void systmr_init(void);
 
 /**
- *  Fetch counter value atomically (disable interrupt during copy).
+ *  Fetch counter value atomically (without disabling interrupts).
+ *  
+ *  May be called from an interrupt.
  */
 extern systmr_ticks_t systmr_get_counter(void);
 
+/**
+ *  Enter IDLE sleep mode until the next interrupt.
+ *  
+ *  With #SYSTMR_TICKLESS enabled, the timer interrupt is postponed until 
+ *  @b ticks have elapsed (limited to #SYSTMR_TICKLESS_TICKS_MAX). The CPU
+ *  may be woken earlier by any other interrupt.
+ *  
+ *  May be called with global interrupts disabled, e.g. after checking 
+ *  that there is nothing to do (see #SCHED_IDLE()). Interrupts are enabled
+ *  with the instruction before the sleep instruction, so an interrupt that
+ *  is already pending wakes the CPU immediately. Interrupts are enabled on 
+ *  return (unless @b ticks is 0).
+ *  
+ *  @param ticks    Number of ticks until the next deadline; 0 returns 
+ *                  immediately
+ */
+extern void systmr_idle(systmr_ticks_t ticks);
+
+/**
+ *  Fetch a high resolution timestamp.
+ *  
+ *  The timestamp is the number of TMR1 counts since systmr_init() and 
+ *  wraps after 2^32 counts. It is cheap enough to call in hot paths; 
+ *  convert the difference of two timestamps to microseconds with 
+ *  SYSTMR_TIMESTAMP_TO_US().
+ *  
+ *  May be called from an interrupt.
+ *  
+ *  @return systmr_timestamp_t  Timestamp (#SYSTMR_TIMESTAMP_PER_SEC counts
+ *                              per second)
+ */
+extern systmr_timestamp_t systmr_get_timestamp(void);
+
+/**
+ *  Fetch a timestamp in microseconds.
+ *  
+ *  Same as systmr_get_timestamp(), but scaled to microseconds. The value
+ *  wraps after 2^32 us (71 minutes) or when the tick counter wraps, 
+ *  whichever comes first.
+ *  
+ *  @return u32_t   Timestamp in microseconds
+ */
+extern u32_t systmr_get_timestamp_us(void);
+
 /* _____MACROS_______________________________________________________________ */
+/**
+ *  Convert a number of timestamp counts to microseconds.
+ *  
+ *  A 32-bit division is used, so use it to report results and not in 
+ *  time critical code.
+ *  
+ *  @param[in] counts   Timestamp difference (evaluated twice)
+ */
+#define SYSTMR_TIMESTAMP_TO_US(counts) \
+    (  ((u32_t)(counts)/SYSTMR_COUNTS_PER_TICK)*SYSTMR_US_PER_TICK \
+     + ((u32_t)(counts)%SYSTMR_COUNTS_PER_TICK)*SYSTMR_US_PER_TICK/SYSTMR_COUNTS_PER_TICK)
 
 /**
  *  @}
@@ -70,8 +70,15 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
+#if UART0_RX_TASK
+#include "sched.h"
+#endif
 
 /* _____DEFINITIONS__________________________________________________________ */
+#ifndef UART0_RX_TASK
+/// Flag to make a scheduler task ready when data is received (see uart0_set_rx_task())
+#define UART0_RX_TASK 0
+#endif
 
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 typedef enum
@@ -193,6 +200,19 @@ extern bool_t uart0_tx_byte(u8_t data);
  */
 extern u8_t uart0_tx_data(const u8_t *data, 
                           u8_t       bytes_to_send);
+
+#if UART0_RX_TASK
+/**
+ *  Set the task that must be made ready when data is received.
+ * 
+ *  The task can wait for received data with 
+ *  SCHED_WAIT_UNTIL(task, uart0_get_rx_byte(&data)).
+ * 
+ *  @param[in] task     Pointer to task object; NULL to clear
+ */
+extern void uart0_set_rx_task(sched_task_t *task);
+#endif
+
 /* _____MACROS_______________________________________________________________ */
 
 /**
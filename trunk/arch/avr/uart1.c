@@ -44,6 +44,7 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "uart1.h"
+#include "prof.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 /** 
@@ -99,9 +100,14 @@ static          u8_t uart1_tx_in;
 /// Flag that is used by interrupt handler to indicate that transmission is finished (transmit buffer empty)
 static          bool_t  uart1_tx_finished_flag;
 
+#if UART1_RX_TASK
+/// Task that is made ready when data is received
+static sched_task_t *uart1_rx_task;
+#endif
+
 /* _____PRIVATE FUNCTIONS____________________________________________________ */
-/// Received data interrupt handler
-ISR(USART1_RX_vect)
+/// Buffer received data (called by receive interrupt handler)
+static inline void uart1_rx_isr(void)
 {
     u8_t ucsra = UCSR1A;
     u8_t data  = UDR1;
@@ -129,10 +135,26 @@ ISR(USART1_RX_vect)
     
     // Advance pointer
     uart1_rx_in = index;
+
+#if UART1_RX_TASK
+    // Make waiting task ready
+    if(uart1_rx_task != NULL)
+    {
+        SCHED_TASK_READY(uart1_rx_task);
+    }
+#endif
 }
 
-/// Transmit data register empty interrupt handler
-ISR(USART1_UDRE_vect)
+/// Received data interrupt handler
+ISR(USART1_RX_vect)
+{
+    PROF_BEGIN(PROF_ID_UART1);
+    uart1_rx_isr();
+    PROF_END(PROF_ID_UART1);
+}
+
+/// Send buffered data (called by transmit data register empty interrupt handler)
+static inline void uart1_udre_isr(void)
 {
     // See if there is more data to be sent
     if(uart1_tx_out == uart1_tx_in)
@@ -156,14 +178,26 @@ ISR(USART1_UDRE_vect)
     UART1_NEXT_INDEX(uart1_tx_out, UART1_TX_BUFFER_SIZE);
 }
 
+/// Transmit data register empty interrupt handler
+ISR(USART1_UDRE_vect)
+{
+    PROF_BEGIN(PROF_ID_UART1);
+    uart1_udre_isr();
+    PROF_END(PROF_ID_UART1);
+}
+
 /// Transmit complete interrupt handler
 ISR(USART1_TX_vect)
 {
+    PROF_BEGIN(PROF_ID_UART1);
+
     // Set flag to indicate that transmission has finished
     uart1_tx_finished_flag = TRUE;
     
     // Disable interrupt
     BIT_SET_LO(UCSR1B,TXCIE);
+
+    PROF_END(PROF_ID_UART1);
 }
 
 /* _____FUNCTIONS_____________________________________________________ */
@@ -401,10 +435,21 @@ u8_t uart1_tx_data(const u8_t* data, u8_t bytes_to_send)
     return bytes_buffered;
 }
 
+#if UART1_RX_TASK
+void uart1_set_rx_task(sched_task_t *task)
+{
+    uart1_rx_task = task;
+}
+#endif
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2007-03-31 : Pieter Conradie
  - First release
+
+ 2026/10/19 : agent
+ - Added uart1_set_rx_task() (UART1_RX_TASK)
+ - Added profiler markers (PROF)
    
 */
@@ -52,6 +52,9 @@
 /* _____LOCAL VARIABLES______________________________________________________ */
 static volatile systmr_ticks_t systmr_tick_counter;
 
+/// Number of TMR1 counts up to the last period match (see systmr_get_timestamp())
+static volatile systmr_timestamp_t systmr_timestamp_base;
+
 /* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
@@ -64,6 +67,9 @@ void __attribute__((__interrupt__,auto_psv)) _T1Interrupt(void)
     // Increment counter
     systmr_tick_counter++;
 
+    // The 16-bit tick counter wraps too soon for the timestamp
+    systmr_timestamp_base += SYSTMR_COUNTS_PER_TICK;
+
     // Update RTC
     rtc_on_systmr_tick();
 
@@ -71,6 +77,31 @@ void __attribute__((__interrupt__,auto_psv)) _T1Interrupt(void)
     IFS0bits.T1IF = 0;
 }
 
+/// Fetch tick counter and TMR1 value that belong together
+static systmr_ticks_t systmr_get_counter_and_count(u16_t *count)
+{
+    systmr_ticks_t ticks;
+
+    // Timer interrupt has the highest priority and can not be masked by 
+    // the IPL, so repeat if the ISR ran in between.
+    do
+    {
+        ticks  = systmr_tick_counter;
+        *count = TMR1;
+
+        // Period match pending? TMR1 has been cleared, but ISR has not run yet
+        if(IFS0bits.T1IF)
+        {
+            // Read TMR1 again, because it could have been read before clearing
+            *count = TMR1;
+            ticks++;
+        }
+    }
+    while(ticks != (systmr_ticks_t)(systmr_tick_counter + IFS0bits.T1IF));
+
+    return ticks;
+}
+
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void systmr_init(void)
 {
@@ -93,7 +124,7 @@ void systmr_init(void)
     TMR1 = 0;
 
     // Set prescaler so that timer will expire 1/SYSTMR_TICKS_PER_SEC
-    PR1  = DIV_ROUND(F_CY, SYSTMR_TICKS_PER_SEC) - 1;
+    PR1  = SYSTMR_COUNTS_PER_TICK - 1;
 
     // Clear timer interrupt flag
     IFS0bits.T1IF = 0;
@@ -118,10 +149,60 @@ systmr_ticks_t systmr_get_tick_counter(void)
     return counter;
 }
 
+systmr_timestamp_t systmr_get_timestamp(void)
+{
+    systmr_timestamp_t timestamp;
+    u16_t              count;
+
+    // Repeat if the ISR ran in between (see systmr_get_counter_and_count())
+    do
+    {
+        timestamp = systmr_timestamp_base;
+        count     = TMR1;
+
+        // Period match pending? TMR1 has been cleared, but ISR has not run yet
+        if(IFS0bits.T1IF)
+        {
+            // Read TMR1 again, because it could have been read before clearing
+            count      = TMR1;
+            timestamp += SYSTMR_COUNTS_PER_TICK;
+        }
+    }
+    while(timestamp != (systmr_timestamp_base + (IFS0bits.T1IF ? SYSTMR_COUNTS_PER_TICK : 0)));
+
+    return timestamp + count;
+}
+
+u32_t systmr_get_timestamp_us(void)
+{
+    systmr_ticks_t ticks;
+    u16_t          count;
+
+    ticks = systmr_get_counter_and_count(&count);
+
+    return   (u32_t)ticks*SYSTMR_US_PER_TICK 
+           + (u32_t)count*SYSTMR_US_PER_TICK/SYSTMR_COUNTS_PER_TICK;
+}
+
+void systmr_idle(systmr_ticks_t ticks)
+{
+    if(ticks == 0)
+    {
+        return;
+    }
+
+    // Enter IDLE mode (PWRSAV #1)
+    Idle();
+}
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2010/04/12 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added systmr_idle()
+ - Added systmr_get_timestamp() and systmr_get_timestamp_us()
    
 */
@@ -69,10 +69,22 @@
 #define SYSTMR_TICKS_PER_SEC 1000ul
 #endif
 
+/// Number of TMR1 counts per tick (TMR1 is clocked at F_CY)
+#define SYSTMR_COUNTS_PER_TICK      DIV_ROUND(F_CY, SYSTMR_TICKS_PER_SEC)
+
+/// Number of timestamp counts per second (see systmr_get_timestamp())
+#define SYSTMR_TIMESTAMP_PER_SEC    (SYSTMR_COUNTS_PER_TICK*SYSTMR_TICKS_PER_SEC)
+
+/// Number of microseconds per tick
+#define SYSTMR_US_PER_TICK          (1000000ul/SYSTMR_TICKS_PER_SEC)
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /// Size definition of the tick counter
 typedef u16_t systmr_ticks_t;
 
+/// Timestamp in TMR1 counts (see systmr_get_timestamp())
+typedef u32_t systmr_timestamp_t;
+
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
@@ -86,7 +98,55 @@ extern void systmr_init(void);
  */
 extern systmr_ticks_t systmr_get_tick_counter(void);
 
+/**
+ * Enter IDLE mode until the next interrupt.
+ * 
+ * Timer 1 continues to run in IDLE mode (TSIDL = 0), so the CPU is woken 
+ * at least every tick.
+ * 
+ * @param ticks     Number of ticks until the next deadline; 0 returns 
+ *                  immediately
+ */
+extern void systmr_idle(systmr_ticks_t ticks);
+
+/**
+ *  Fetch a high resolution timestamp.
+ *  
+ *  The timestamp is the number of TMR1 counts since systmr_init(), i.e. a
+ *  32-bit count of the TMR1 periods (kept by the ISR, because the 16-bit 
+ *  tick counter wraps too soon) plus the current TMR1 value. It wraps after
+ *  2^32 counts, so the difference of two timestamps is correct modulo 2^32.
+ *  A tick that has elapsed, but has not been serviced yet, is accounted 
+ *  for. Convert the difference of two timestamps to microseconds with 
+ *  SYSTMR_TIMESTAMP_TO_US().
+ *  
+ *  May be called from an interrupt.
+ *  
+ *  @return systmr_timestamp_t  Timestamp (#SYSTMR_TIMESTAMP_PER_SEC counts
+ *                              per second)
+ */
+extern systmr_timestamp_t systmr_get_timestamp(void);
+
+/**
+ *  Fetch a timestamp in microseconds.
+ *  
+ *  Same as systmr_get_timestamp(), but scaled to microseconds. The value
+ *  wraps after 2^32 us (71 minutes) or when the tick counter wraps, 
+ *  whichever comes first.
+ *  
+ *  @return u32_t   Timestamp in microseconds
+ */
+extern u32_t systmr_get_timestamp_us(void);
+
 /* _____MACROS_______________________________________________________________ */
+/**
+ *  Convert a number of timestamp counts to microseconds.
+ *  
+ *  @param[in] counts   Timestamp difference (evaluated twice)
+ */
+#define SYSTMR_TIMESTAMP_TO_US(counts) \
+    (  ((u32_t)(counts)/SYSTMR_COUNTS_PER_TICK)*SYSTMR_US_PER_TICK \
+     + ((u32_t)(counts)%SYSTMR_COUNTS_PER_TICK)*SYSTMR_US_PER_TICK/SYSTMR_COUNTS_PER_TICK)
 
 /**
  *  @}
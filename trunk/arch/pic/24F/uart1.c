@@ -42,6 +42,7 @@
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "uart1.h"
 #include "ring_buffer.h"
+#include "prof.h"
 #include "board.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
@@ -69,6 +70,11 @@ static u8_t          uart1_rx_buffer[UART1_RX_BUFFER_SIZE];
 static ring_buffer_t uart1_tx_ring_buffer;
 static u8_t          uart1_tx_buffer[UART1_TX_BUFFER_SIZE];
 
+#if UART1_RX_TASK
+/// Task that is made ready when data is received
+static sched_task_t *uart1_rx_task;
+#endif
+
 /* _____LOCAL FUNCTION PROTOTYPES____________________________________________ */
 
 /* _____MACROS_______________________________________________________________ */
@@ -79,6 +85,8 @@ void __attribute__((__interrupt__,auto_psv)) _U1RXInterrupt(void)
 {
     u8_t data;
 
+    PROF_BEGIN(PROF_ID_UART1);
+
     // See if Receive FIFO buffer has data
     while(U1STAbits.URXDA == 1)
     {
@@ -102,10 +110,20 @@ void __attribute__((__interrupt__,auto_psv)) _U1RXInterrupt(void)
 
         // Buffer received data
         ring_buffer_write_byte(&uart1_rx_ring_buffer, data);
+
+#if UART1_RX_TASK
+        // Make waiting task ready
+        if(uart1_rx_task != NULL)
+        {
+            SCHED_TASK_READY(uart1_rx_task);
+        }
+#endif
     }
 
     // Clear Receive interrupt flag
     IFS0bits.U1RXIF = 0;
+
+    PROF_END(PROF_ID_UART1);
 }
 
 // UART Transmit interrupt handler
@@ -113,6 +131,8 @@ void __attribute__((__interrupt__,auto_psv)) _U1TXInterrupt(void)
 {
     u8_t data;
 
+    PROF_BEGIN(PROF_ID_UART1);
+
     // See if Transmit FIFO buffer is not full
     while(U1STAbits.UTXBF == 0)
     {
@@ -132,6 +152,8 @@ void __attribute__((__interrupt__,auto_psv)) _U1TXInterrupt(void)
 
     // Clear Transmit interrupt flag
     IFS0bits.U1TXIF = 0;
+
+    PROF_END(PROF_ID_UART1);
 }
 
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
@@ -271,11 +293,22 @@ u16_t uart1_tx_data(const u8_t* data, u16_t bytes_to_send)
     return bytes_sent;
 }
 
+#if UART1_RX_TASK
+void uart1_set_rx_task(sched_task_t *task)
+{
+    uart1_rx_task = task;
+}
+#endif
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2010/04/11 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added uart1_set_rx_task() (UART1_RX_TASK)
+ - Added profiler markers (PROF)
    
 */
 
@@ -67,8 +67,15 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
+#if UART1_RX_TASK
+#include "sched.h"
+#endif
 
 /* _____DEFINITIONS _________________________________________________________ */
+#ifndef UART1_RX_TASK
+/// Flag to make a scheduler task ready when data is received (see uart1_set_rx_task())
+#define UART1_RX_TASK 0
+#endif
 
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 
@@ -173,6 +180,18 @@ extern bool_t uart1_tx_byte(u8_t data);
 extern u16_t uart1_tx_data(const u8_t *data, 
                             u16_t      bytes_to_send);
 
+#if UART1_RX_TASK
+/**
+ *  Set the task that must be made ready when data is received.
+ * 
+ *  The task can wait for received data with 
+ *  SCHED_WAIT_UNTIL(task, uart1_get_rx_byte(&data)).
+ * 
+ *  @param[in] task     Pointer to task object; NULL to clear
+ */
+extern void uart1_set_rx_task(sched_task_t *task);
+#endif
+
 /* _____MACROS_______________________________________________________________ */
 
 /**
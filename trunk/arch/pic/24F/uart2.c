@@ -42,6 +42,7 @@
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "uart2.h"
 #include "ring_buffer.h"
+#include "prof.h"
 #include "board.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
@@ -69,6 +70,11 @@ static u8_t          uart2_rx_buffer[UART2_RX_BUFFER_SIZE];
 static ring_buffer_t uart2_tx_ring_buffer;
 static u8_t          uart2_tx_buffer[UART2_TX_BUFFER_SIZE];
 
+#if UART2_RX_TASK
+/// Task that is made ready when data is received
+static sched_task_t *uart2_rx_task;
+#endif
+
 /* _____LOCAL FUNCTION PROTOTYPES____________________________________________ */
 
 /* _____MACROS_______________________________________________________________ */
@@ -79,6 +85,8 @@ void __attribute__((__interrupt__,auto_psv)) _U2RXInterrupt(void)
 {
     u8_t data;
 
+    PROF_BEGIN(PROF_ID_UART2);
+
     // See if Receive FIFO buffer has data
     while(U2STAbits.URXDA == 1)
     {
@@ -102,10 +110,20 @@ void __attribute__((__interrupt__,auto_psv)) _U2RXInterrupt(void)
 
         // Buffer received data
         ring_buffer_write_byte(&uart2_rx_ring_buffer, data);
+
+#if UART2_RX_TASK
+        // Make waiting task ready
+        if(uart2_rx_task != NULL)
+        {
+            SCHED_TASK_READY(uart2_rx_task);
+        }
+#endif
     }
 
     // Clear Receive interrupt flag
     IFS1bits.U2RXIF = 0;
+
+    PROF_END(PROF_ID_UART2);
 }
 
 // UART Transmit interrupt handler
@@ -113,6 +131,8 @@ void __attribute__((__interrupt__,auto_psv)) _U2TXInterrupt(void)
 {
     u8_t data;
 
+    PROF_BEGIN(PROF_ID_UART2);
+
     // See if Transmit FIFO buffer is not full
     while(U2STAbits.UTXBF == 0)
     {
@@ -132,6 +152,8 @@ void __attribute__((__interrupt__,auto_psv)) _U2TXInterrupt(void)
 
     // Clear Transmit interrupt flag
     IFS1bits.U2TXIF = 0;
+
+    PROF_END(PROF_ID_UART2);
 }
 
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
@@ -271,11 +293,22 @@ u16_t uart2_tx_data(const u8_t* data, u16_t bytes_to_send)
     return bytes_sent;
 }
 
+#if UART2_RX_TASK
+void uart2_set_rx_task(sched_task_t *task)
+{
+    uart2_rx_task = task;
+}
+#endif
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2010/04/11 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added uart2_set_rx_task() (UART2_RX_TASK)
+ - Added profiler markers (PROF)
    
 */
 
@@ -38,20 +38,48 @@
 ============================================================================= */
 
 /* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "dflash_at45d.h"
 #include "spi1.h"
+#include "prof.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
+/**
+ *  Number of address bits of the byte in a page. The page number is 
+ *  shifted by this amount when the 24-bit address is sent.
+ */
+#if   (AT45D_PAGE_SIZE <= 256)
+#define AT45D_PAGE_ADR_BITS 8
+#elif (AT45D_PAGE_SIZE <= 512)
+#define AT45D_PAGE_ADR_BITS 9
+#elif (AT45D_PAGE_SIZE <= 1024)
+#define AT45D_PAGE_ADR_BITS 10
+#else
+#define AT45D_PAGE_ADR_BITS 11
+#endif
+
 #if   defined(AT45DB011D) || defined(AT45DB021D)||defined(AT45DB081D)||defined(AT45DB161D)||defined(AT45DB321D)||defined(AT45DB642D)
 #warning "The driver has not been tested with this device! Please email feedback."
 #endif
 
+/// Value of a page variable if no page is loaded
+#define AT45D_PAGE_NONE     0xffff
+
+#if (AT45D_CACHE_PAGES > 8)
+#error "AT45D_CACHE_PAGES must be 0 to 8"
+#endif
+
+/// Number of consecutive read misses before a page is added to a full cache
+#define AT45D_CACHE_FILL_MISSES (AT45D_PAGE_SIZE / 2)
+
 /// \name Read commands
 //@{
 #define AT45D_CMD_CONTINUOUS_ARRAY_READ        0xE8
 #define AT45D_CMD_MAIN_MEMORY_PAGE_READ        0xD2
+#define AT45D_CMD_BUFFER1_READ                 0xD4
+#define AT45D_CMD_BUFFER2_READ                 0xD6
 #define AT45D_CMD_STATUS_REGISTER_READ         0xD7
 //@}
 
@@ -61,6 +89,8 @@
 #define AT45D_CMD_BUFFER2_WRITE                0x87
 #define AT45D_CMD_BUF1_TO_MAIN_PAGE_PROGRAM    0x83
 #define AT45D_CMD_BUF2_TO_MAIN_PAGE_PROGRAM    0x86
+#define AT45D_CMD_BUF1_TO_MAIN_PAGE_PROG_NO_ER 0x88
+#define AT45D_CMD_BUF2_TO_MAIN_PAGE_PROG_NO_ER 0x89
 #define AT45D_CMD_MAIN_MEM_PROG_THROUGH_BUF1   0x82
 #define AT45D_CMD_MAIN_MEM_PROG_THROUGH_BUF2   0x85
 #define AT45D_CMD_PAGE_ERASE                   0x81
@@ -88,37 +118,585 @@
 /* _____LOCAL VARIABLES______________________________________________________ */
 static bool_t at45d_ready_flag;
 
+/// SRAM buffer (1 or 2) that is being programmed into main memory; 0 if none
+static u8_t   at45d_prog_buffer;
+
+/// SRAM buffer (1 or 2) that is loaded by the next at45d_write_page_seq()
+static u8_t   at45d_seq_buffer;
+
+/// Page that is loaded in buffer 1 by at45d_write(); AT45D_PAGE_NONE if none
+static u16_t  at45d_rmw_page;
+
+/// Flag to indicate that buffer 1 contains changes that are not programmed yet
+static bool_t at45d_rmw_dirty;
+
+/// Flag to indicate that buffer 1 must be programmed with built-in erase
+static bool_t at45d_rmw_erase;
+
+#if AT45D_CACHE_PAGES
+/// Page that SRAM buffer 1 and 2 contains; AT45D_PAGE_NONE if unknown
+static u16_t  at45d_buf_page[2];
+
+/// Data of cached pages
+static u8_t   at45d_cache_data[AT45D_CACHE_PAGES][AT45D_PAGE_SIZE];
+
+/// Page of each cache entry; AT45D_PAGE_NONE if entry is empty
+static u16_t  at45d_cache_page[AT45D_CACHE_PAGES];
+
+/// Cache entries in order of use (most recently used first)
+static u8_t   at45d_cache_lru[AT45D_CACHE_PAGES];
+
+/// Bit mask of cache entries that contain changes that are not programmed yet
+static u8_t   at45d_cache_dirty;
+
+/// Bit mask of cache entries that must be programmed with built-in erase
+static u8_t   at45d_cache_erase;
+
+/// Number of reads that missed the cache since the least recently used entry was used
+static u16_t  at45d_cache_misses;
+#endif
+
+#if AT45D_ASYNC
+/// Queue of asynchronous requests
+static at45d_req_t *at45d_req_first;
+static at45d_req_t *at45d_req_last;
+#endif
+
 /* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
-#if ((AT45D_PAGE_SIZE != 256) && (AT45D_PAGE_SIZE != 264))
-#error "This driver does not work for any other page size yet. See comment!"
-/*
- * Unfortunately this driver still needs work to cater for other page sizes. 
- *  
- * When the address is sent, the specified page value is shifted by a fixed amount, 
- * but actually the amount of shift depends on the page size (?) 
+static void at45d_send_address(u16_t page, u16_t start_byte_in_page)
+{
+    // 24-bit address: page << AT45D_PAGE_ADR_BITS | start_byte_in_page
+    spi1_tx_byte((u8_t)(page >> (16 - AT45D_PAGE_ADR_BITS)));
+    spi1_tx_byte((u8_t)((page << (AT45D_PAGE_ADR_BITS - 8)) | (start_byte_in_page >> 8)));
+    spi1_tx_byte((u8_t)(start_byte_in_page & 0xFF));
+}
+
+/// Convert a linear address to a page and byte in the page
+static void at45d_adr_to_page(at45d_adr_t address,
+                              u16_t       *page,
+                              u16_t       *start_byte_in_page)
+{
+#if VAL_IS_PWR_OF_TWO(AT45D_PAGE_SIZE)
+    *page               = (u16_t)(address >> AT45D_PAGE_ADR_BITS);
+    *start_byte_in_page = (u16_t)(address & (AT45D_PAGE_SIZE - 1));
+#else
+    /* 
+     * Page size is 33 x 2^(AT45D_PAGE_ADR_BITS-6), e.g. 264 = 33 x 8, so 
+     * the page is (address >> (AT45D_PAGE_ADR_BITS-6)) / 33. The quotient 
+     * is estimated with 1/33 = 1/32 - 1/32^2 + 1/32^3 - ... and corrected.
+     */
+    u32_t  x = (u32_t)address >> (AT45D_PAGE_ADR_BITS-6);
+    u16_t  q = (u16_t)((x >> 5) - (x >> 10) + (x >> 15));
+    s16_t  r = (s16_t)(x - (((u32_t)q << 5) + q));
+
+    while(r >= 33)
+    {
+        q++;
+        r -= 33;
+    }
+    while(r < 0)
+    {
+        q--;
+        r += 33;
+    }
+    *page               = q;
+    *start_byte_in_page =  ((u16_t)r << (AT45D_PAGE_ADR_BITS-6))
+                         | ((u16_t)address & ((1 << (AT45D_PAGE_ADR_BITS-6)) - 1));
+#endif
+}
+
+/// Program buffer 1 into main memory and forget page loaded by at45d_write()
+static void at45d_rmw_release(void)
+{
+#if !AT45D_CACHE_PAGES
+    at45d_flush();
+    at45d_rmw_page = AT45D_PAGE_NONE;
+#endif
+    // With the cache, changes made by at45d_write() are in RAM, not in buffer 1
+}
+
+#if AT45D_CACHE_PAGES
+/// Record page that SRAM buffer (1 or 2) contains
+static void at45d_buf_set_page(u8_t buf, u16_t page)
+{
+    // Copy of page in other buffer is stale
+    if(at45d_buf_page[2-buf] == page)
+    {
+        at45d_buf_page[2-buf] = AT45D_PAGE_NONE;
+    }
+    at45d_buf_page[buf-1] = page;
+}
+
+/// Read data from SRAM buffer (1 or 2)
+static void at45d_buf_read(u8_t  buf,
+                           void  *buffer,
+                           u16_t start_byte_in_page,
+                           u16_t number_of_bytes)
+{
+    // Wait until buffer is not being loaded or programmed
+    if(buf == at45d_prog_buffer)
+    {
+        while(!at45d_ready())
+        {
+            ;
+        }
+    }
+
+    // Select serial Flash
+    AT45D_CS_LO();
+
+    // Send command (allowed while the other buffer is being programmed)
+    if(buf == 1)
+    {
+        spi1_tx_byte(AT45D_CMD_BUFFER1_READ);
+    }
+    else
+    {
+        spi1_tx_byte(AT45D_CMD_BUFFER2_READ);
+    }
+
+    // Send address
+    at45d_send_address(0, start_byte_in_page);
+
+    // Send dont-care bits
+    spi1_tx_byte(0x00);
+
+    // Read data
+    spi1_rx_data(buffer, number_of_bytes);
+
+    // Deselect serial Flash
+    AT45D_CS_HI();
+}
+#endif
+
+/// Read data of a page from main memory (or SRAM buffer that contains page)
+static void at45d_mem_read(void  *buffer,
+                           u16_t page,
+                           u16_t start_byte_in_page,
+                           u16_t number_of_bytes)
+{
+#if AT45D_CACHE_PAGES
+    // Buffer contains page?
+    if(at45d_buf_page[0] == page)
+    {
+        at45d_buf_read(1, buffer, start_byte_in_page, number_of_bytes);
+        return;
+    }
+    if(at45d_buf_page[1] == page)
+    {
+        at45d_buf_read(2, buffer, start_byte_in_page, number_of_bytes);
+        return;
+    }
+#endif
+
+    // Wait until Flash is not busy
+    while(!at45d_ready())
+    {
+        ;
+    }
+
+    // Select serial Flash
+    AT45D_CS_LO();
+
+    // Send command
+    spi1_tx_byte(AT45D_CMD_CONTINUOUS_ARRAY_READ);
+
+    // Send address
+    at45d_send_address(page, start_byte_in_page);
+
+    // Send dont-care bits
+    spi1_tx_byte(0x00);
+    spi1_tx_byte(0x00);
+    spi1_tx_byte(0x00);
+    spi1_tx_byte(0x00);
+
+    // Read data
+    spi1_rx_data(buffer, number_of_bytes);    
+
+    // Deselect serial Flash
+    AT45D_CS_HI();
+}
+
+/// Load next buffer of sequence with a page and program it into main memory
+static void at45d_program_seq(const void *buffer, u16_t page, bool_t erase)
+{
+    u8_t buf = at45d_seq_buffer;
+
+    // Wait until buffer is not being programmed into main memory
+    if(buf == at45d_prog_buffer)
+    {
+        while(!at45d_ready())
+        {
+            ;
+        }
+    }
+
+    // Select serial Flash
+    AT45D_CS_LO();
+
+    // Send command (allowed while the other buffer is being programmed)
+    if(buf == 1)
+    {
+        spi1_tx_byte(AT45D_CMD_BUFFER1_WRITE);
+    }
+    else
+    {
+        spi1_tx_byte(AT45D_CMD_BUFFER2_WRITE);
+    }
+
+    // Send address (start of buffer)
+    at45d_send_address(0, 0);
+
+    // Load buffer with data to be written
+    spi1_tx_data(buffer, AT45D_PAGE_SIZE);
+
+    // Deselect serial Flash
+    AT45D_CS_HI();
+
+    // Wait until program of the other buffer has finished
+    while(!at45d_ready())
+    {
+        ;
+    }
+
+    // Select serial Flash
+    AT45D_CS_LO();
+
+    // Send command (program with or without built-in erase)
+    if(buf == 1)
+    {
+        spi1_tx_byte(erase ? AT45D_CMD_BUF1_TO_MAIN_PAGE_PROGRAM
+                           : AT45D_CMD_BUF1_TO_MAIN_PAGE_PROG_NO_ER);
+    }
+    else
+    {
+        spi1_tx_byte(erase ? AT45D_CMD_BUF2_TO_MAIN_PAGE_PROGRAM
+                           : AT45D_CMD_BUF2_TO_MAIN_PAGE_PROG_NO_ER);
+    }
+
+    // Send address
+    at45d_send_address(page, 0);
+
+    // Deselect serial Flash
+    AT45D_CS_HI();
+
+    // Set flag to busy
+    at45d_ready_flag  = FALSE;
+    at45d_prog_buffer = buf;
+
+#if AT45D_CACHE_PAGES
+    at45d_buf_set_page(buf, page);
+#endif
+
+#if (AT45D_BUFFERS == 2)
+    // Use other buffer for next page
+    at45d_seq_buffer  = (buf == 1) ? 2 : 1;
+#endif
+}
+
+#if AT45D_CACHE_PAGES
+/// Find page in cache; returns position in LRU list (AT45D_CACHE_PAGES if not found)
+static u8_t at45d_cache_find(u16_t page)
+{
+    u8_t pos;
+
+    for(pos=0; pos<AT45D_CACHE_PAGES; pos++)
+    {
+        if(at45d_cache_page[at45d_cache_lru[pos]] == page)
+        {
+            break;
+        }
+    }
+
+    return pos;
+}
+
+/// Move entry at position in LRU list to the front and return entry
+static u8_t at45d_cache_use(u8_t pos)
+{
+    u8_t entry = at45d_cache_lru[pos];
+
+    while(pos != 0)
+    {
+        at45d_cache_lru[pos] = at45d_cache_lru[pos-1];
+        pos--;
+    }
+    at45d_cache_lru[0] = entry;
+
+    return entry;
+}
+
+/// Program cache entry into main memory if it contains changes
+static void at45d_cache_write_back(u8_t entry)
+{
+    if(BIT_IS_LO(at45d_cache_dirty, entry))
+    {
+        return;
+    }
+    BIT_SET_LO(at45d_cache_dirty, entry);
+
+    // Overlap with program of previous entry
+    at45d_program_seq(at45d_cache_data[entry], 
+                      at45d_cache_page[entry],
+                      BIT_IS_HI(at45d_cache_erase, entry));
+    BIT_SET_LO(at45d_cache_erase, entry);
+}
+
+/**
+ *  Get cache entry of page. If the page is not cached, the least recently 
+ *  used entry is written back and replaced (and filled with the page if 
+ *  "fill" is TRUE).
  */
+static u8_t at45d_cache_get(u16_t page, bool_t fill)
+{
+    u8_t pos = at45d_cache_find(page);
+    u8_t entry;
+
+    if(pos == AT45D_CACHE_PAGES)
+    {
+        pos   = AT45D_CACHE_PAGES - 1;
+        entry = at45d_cache_lru[pos];
+        at45d_cache_write_back(entry);
+        if(fill)
+        {
+            at45d_mem_read(at45d_cache_data[entry], page, 0, AT45D_PAGE_SIZE);
+        }
+        at45d_cache_page[entry] = page;
+    }
+
+    return at45d_cache_use(pos);
+}
+
+/// Update cached copy of page that is programmed (buffer is NULL if erased)
+static void at45d_cache_update(u16_t page, const void *buffer)
+{
+    u8_t pos = at45d_cache_find(page);
+    u8_t entry;
+
+    if(pos == AT45D_CACHE_PAGES)
+    {
+        return;
+    }
+    entry = at45d_cache_lru[pos];
+    if(buffer != NULL)
+    {
+        memcpy(at45d_cache_data[entry], buffer, AT45D_PAGE_SIZE);
+    }
+    else
+    {
+        memset(at45d_cache_data[entry], 0xff, AT45D_PAGE_SIZE);
+    }
+    BIT_SET_LO(at45d_cache_dirty, entry);
+    BIT_SET_LO(at45d_cache_erase, entry);
+}
+
+/// Write back cached copy of page that is partially programmed and remove it
+static void at45d_cache_discard(u16_t page)
+{
+    u8_t pos = at45d_cache_find(page);
+    u8_t entry;
+
+    if(pos == AT45D_CACHE_PAGES)
+    {
+        return;
+    }
+    entry = at45d_cache_lru[pos];
+    at45d_cache_write_back(entry);
+    at45d_cache_page[entry] = AT45D_PAGE_NONE;
+
+    // Empty entry is used first
+    while(pos != (AT45D_CACHE_PAGES-1))
+    {
+        at45d_cache_lru[pos] = at45d_cache_lru[pos+1];
+        pos++;
+    }
+    at45d_cache_lru[pos] = entry;
+}
 #endif
 
-static void at45d_send_address(u16_t page, u16_t start_byte_in_page)
+#if AT45D_ASYNC
+/// Add request to end of queue
+static void at45d_req_add(at45d_req_t     *req,
+                          u8_t            type,
+                          at45d_on_done_t on_done)
 {
-#if VAL_IS_PWR_OF_TWO(AT45D_PAGE_SIZE)
-    spi1_tx_byte((u8_t)(page>>8)&0xFF);
-    spi1_tx_byte((u8_t)(page&0xFF));
-    spi1_tx_byte((u8_t)(start_byte_in_page&0xFF));
+    req->next    = NULL;
+    req->type    = type;
+    req->started = FALSE;
+    req->on_done = on_done;
+
+    if(at45d_req_first == NULL)
+    {
+        at45d_req_first = req;
+    }
+    else
+    {
+        at45d_req_last->next = req;
+    }
+    at45d_req_last = req;
+}
+#endif
+
+/// Change data in pages (see at45d_write() and at45d_append())
+static u16_t at45d_write_data(const void  *buffer,
+                              at45d_adr_t address,
+                              u16_t       number_of_bytes,
+                              bool_t      erase)
+{
+    const u8_t  *data = (const u8_t *)buffer;
+    at45d_adr_t max_bytes_to_write;
+    u16_t       page;
+    u16_t       start_byte_in_page;
+    u16_t       len;
+    u16_t       bytes_written = 0;
+#if AT45D_CACHE_PAGES
+    u8_t        entry;
+#endif
+
+    // See if specified address is out of bounds
+    if(address > AT45D_ADR_MAX)
+    {
+        return 0;
+    }
+
+    // See if "number of bytes to write" should be clipped
+    max_bytes_to_write = AT45D_ADR_MAX - address + 1;
+    if(number_of_bytes > max_bytes_to_write)
+    {
+        number_of_bytes = max_bytes_to_write;
+    }
+
+    while(bytes_written != number_of_bytes)
+    {
+        // Calculate page, offset and number of bytes to write in page
+        at45d_adr_to_page(address, &page, &start_byte_in_page);
+        len = AT45D_PAGE_SIZE - start_byte_in_page;
+        if(len > (number_of_bytes - bytes_written))
+        {
+            len = number_of_bytes - bytes_written;
+        }
+
+#if AT45D_CACHE_PAGES
+        // Change cached copy of page (not read first if it is overwritten)
+        entry = at45d_cache_get(page, (len != AT45D_PAGE_SIZE));
+        memcpy(&at45d_cache_data[entry][start_byte_in_page], data, len);
+        BIT_SET_HI(at45d_cache_dirty, entry);
+        if(erase)
+        {
+            BIT_SET_HI(at45d_cache_erase, entry);
+        }
 #else
-    spi1_tx_byte((page>>7)&0xFF);
-    spi1_tx_byte(((page<<1)|(start_byte_in_page>>8))&0xFF);
-    spi1_tx_byte(start_byte_in_page&0xFF);
+        // Different page than the one in buffer 1?
+        if(page != at45d_rmw_page)
+        {
+            // Program changes of previous page
+            at45d_flush();
+
+            // Load existing page into buffer 1 (unless it is overwritten)
+            if(len != AT45D_PAGE_SIZE)
+            {
+                // Wait until Flash is not busy
+                while(!at45d_ready())
+                {
+                    ;
+                }
+
+                // Select serial Flash
+                AT45D_CS_LO();
+
+                // Send command
+                spi1_tx_byte(AT45D_CMD_MAIN_MEM_PAGE_TO_BUF1);
+
+                // Send address
+                at45d_send_address(page, 0);
+
+                // Deselect serial Flash
+                AT45D_CS_HI();
+
+                // Set flag to busy
+                at45d_ready_flag  = FALSE;
+                at45d_prog_buffer = 1;
+            }
+            at45d_rmw_page  = page;
+            at45d_rmw_erase = FALSE;
+        }
+
+        // Wait until buffer 1 is not being loaded or programmed
+        if(at45d_prog_buffer == 1)
+        {
+            while(!at45d_ready())
+            {
+                ;
+            }
+        }
+
+        // Select serial Flash
+        AT45D_CS_LO();
+
+        // Send command
+        spi1_tx_byte(AT45D_CMD_BUFFER1_WRITE);
+
+        // Send address
+        at45d_send_address(0, start_byte_in_page);
+
+        // Patch buffer with data
+        spi1_tx_data(data, len);
+
+        // Deselect serial Flash
+        AT45D_CS_HI();
+
+        // Buffer must be programmed
+        at45d_rmw_dirty = TRUE;
+        if(erase)
+        {
+            at45d_rmw_erase = TRUE;
+        }
 #endif
+
+        // Next page
+        data          += len;
+        address       += len;
+        bytes_written += len;
+    }
+
+    return bytes_written;
 }
 
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void at45d_init(void)
 {
+#if AT45D_CACHE_PAGES
+    u8_t i;
+#endif
+
     // Set flag
-    at45d_ready_flag = TRUE;
+    at45d_ready_flag  = TRUE;
+    at45d_prog_buffer = 0;
+    at45d_seq_buffer  = 1;
+    at45d_rmw_page    = AT45D_PAGE_NONE;
+    at45d_rmw_dirty   = FALSE;
+    at45d_rmw_erase   = FALSE;
+
+#if AT45D_CACHE_PAGES
+    // Buffers and cache are empty
+    at45d_buf_page[0] = AT45D_PAGE_NONE;
+    at45d_buf_page[1] = AT45D_PAGE_NONE;
+    for(i=0; i<AT45D_CACHE_PAGES; i++)
+    {
+        at45d_cache_page[i] = AT45D_PAGE_NONE;
+        at45d_cache_lru[i]  = i;
+    }
+    at45d_cache_dirty  = 0;
+    at45d_cache_erase  = 0;
+    at45d_cache_misses = 0;
+#endif
+
+#if AT45D_ASYNC
+    // Empty request queue
+    at45d_req_first   = NULL;
+#endif
 }
 
 extern u16_t at45d_read(void       *buffer,
@@ -128,6 +706,11 @@ extern u16_t at45d_read(void       *buffer,
     at45d_adr_t max_bytes_to_read;
     u16_t       page;
     u16_t       start_byte_in_page;
+#if AT45D_CACHE_PAGES
+    u8_t        *data = (u8_t *)buffer;
+    u16_t       len;
+    u16_t       bytes_read = 0;
+#endif
 
     // See if specified address is out of bounds
     if(address > AT45D_ADR_MAX)
@@ -142,6 +725,39 @@ extern u16_t at45d_read(void       *buffer,
         number_of_bytes = max_bytes_to_read;
     }
 
+    PROF_BEGIN(PROF_ID_AT45D_READ);
+
+#if AT45D_CACHE_PAGES
+    // Read each page through cache
+    at45d_adr_to_page(address, &page, &start_byte_in_page);
+    while(bytes_read != number_of_bytes)
+    {
+        len = AT45D_PAGE_SIZE - start_byte_in_page;
+        if(len > (number_of_bytes - bytes_read))
+        {
+            len = number_of_bytes - bytes_read;
+        }
+        at45d_read_page_offset(data, page, start_byte_in_page, len);
+        data               += len;
+        bytes_read         += len;
+        start_byte_in_page  = 0;
+        page++;
+    }
+#else
+    // Program changes made by at45d_write() if page is read
+    if(at45d_rmw_dirty)
+    {
+        at45d_adr_to_page(address, &page, &start_byte_in_page);
+        if(at45d_rmw_page >= page)
+        {
+            at45d_adr_to_page(address + number_of_bytes - 1, &page, &start_byte_in_page);
+            if(at45d_rmw_page <= page)
+            {
+                at45d_flush();
+            }
+        }
+    }
+
     // Wait until Flash is not busy
     while(!at45d_ready())
     {
@@ -154,15 +770,9 @@ extern u16_t at45d_read(void       *buffer,
     // Send command
     spi1_tx_byte(AT45D_CMD_CONTINUOUS_ARRAY_READ);
 
-    // Calculate page, offset and number of bytes remaining in page
-#if VAL_IS_PWR_OF_TWO(AT45D_PAGE_SIZE)
-    page               = address >> 8;
-    start_byte_in_page = address & 0xff;
-#else
-    page               = address / AT45D_PAGE_SIZE;
-    start_byte_in_page = address % AT45D_PAGE_SIZE;
-#endif
-    
+    // Calculate page and offset
+    at45d_adr_to_page(address, &page, &start_byte_in_page);
+
     // Send address
     at45d_send_address(page, start_byte_in_page);
 
@@ -177,12 +787,34 @@ extern u16_t at45d_read(void       *buffer,
 
     // Deselect serial Flash
     AT45D_CS_HI();
+#endif
+
+    PROF_END(PROF_ID_AT45D_READ);
 
     return number_of_bytes;
 }
 
 void at45d_read_page(void* buffer, u16_t page)
 {
+#if AT45D_CACHE_PAGES
+    u8_t pos = at45d_cache_find(page);
+
+    // Copy from cache (page is not added to cache if it is not cached)
+    if(pos != AT45D_CACHE_PAGES)
+    {
+        memcpy(buffer, at45d_cache_data[at45d_cache_use(pos)], AT45D_PAGE_SIZE);
+    }
+    else
+    {
+        at45d_mem_read(buffer, page, 0, AT45D_PAGE_SIZE);
+    }
+#else
+    // Program changes made by at45d_write() if page is read
+    if(at45d_rmw_dirty && (page == at45d_rmw_page))
+    {
+        at45d_flush();
+    }
+
     // Wait until Flash is not busy
     while(!at45d_ready())
     {
@@ -209,6 +841,7 @@ void at45d_read_page(void* buffer, u16_t page)
 
     // Deselect serial Flash
     AT45D_CS_HI();
+#endif
 }
 
 void at45d_read_page_offset(void *buffer,
@@ -216,6 +849,64 @@ void at45d_read_page_offset(void *buffer,
                             u16_t start_byte_in_page,
                             u16_t number_of_bytes)
 {
+#if AT45D_CACHE_PAGES
+    u8_t pos;
+    u8_t entry;
+
+    // Whole page?
+    if(number_of_bytes == AT45D_PAGE_SIZE)
+    {
+        at45d_read_page(buffer, page);
+        return;
+    }
+
+    /* 
+     * A miss reads directly, because replacing an entry reads a whole page.
+     * The least recently used entry is only replaced if it is empty or if
+     * it has not been used for as many misses as a fill costs.
+     */
+    pos = at45d_cache_find(page);
+    if(pos != AT45D_CACHE_PAGES)
+    {
+        if(pos == (AT45D_CACHE_PAGES-1))
+        {
+            at45d_cache_misses = 0;
+        }
+    }
+    else if(  (at45d_cache_page[at45d_cache_lru[AT45D_CACHE_PAGES-1]] != AT45D_PAGE_NONE)
+            &&(++at45d_cache_misses < AT45D_CACHE_FILL_MISSES)                          )
+    {
+        at45d_mem_read(buffer, page, start_byte_in_page, number_of_bytes);
+        return;
+    }
+    else
+    {
+        at45d_cache_misses = 0;
+    }
+
+    // Copy from cache (page is added to cache)
+    entry = at45d_cache_get(page, TRUE);
+    memcpy(buffer, &at45d_cache_data[entry][start_byte_in_page], number_of_bytes);
+#else
+    // Program changes made by at45d_write() if page is read
+    if(at45d_rmw_dirty && (page == at45d_rmw_page))
+    {
+        at45d_flush();
+    }
+
+    at45d_mem_read(buffer, page, start_byte_in_page, number_of_bytes);
+#endif
+}
+
+void at45d_write_page(const void* buffer, u16_t page)
+{
+    // Buffer 1 is overwritten; program changes made by at45d_write()
+    at45d_rmw_release();
+
+#if AT45D_CACHE_PAGES
+    at45d_cache_update(page, buffer);
+#endif
+
     // Wait until Flash is not busy
     while(!at45d_ready())
     {
@@ -226,31 +917,44 @@ void at45d_read_page_offset(void *buffer,
     AT45D_CS_LO();
 
     // Send command
-    spi1_tx_byte(AT45D_CMD_CONTINUOUS_ARRAY_READ);
+    spi1_tx_byte(AT45D_CMD_MAIN_MEM_PROG_THROUGH_BUF1);
 
     // Send address
-    at45d_send_address(page, start_byte_in_page);
-
-    // Send dont-care bits
-    spi1_tx_byte(0x00);
-    spi1_tx_byte(0x00);
-    spi1_tx_byte(0x00);
-    spi1_tx_byte(0x00);
+    at45d_send_address(page, 0);
 
-    // Read data
-    spi1_rx_data(buffer, number_of_bytes);    
+    // Send data to be written
+    spi1_tx_data(buffer, AT45D_PAGE_SIZE);    
 
     // Deselect serial Flash
     AT45D_CS_HI();
+
+    // Set flag to busy
+    at45d_ready_flag  = FALSE;
+    at45d_prog_buffer = 1;
+
+#if AT45D_CACHE_PAGES
+    // Buffer 1 contains page
+    at45d_buf_set_page(1, page);
+#endif
 }
 
-void at45d_write_page(const void* buffer, u16_t page)
+void at45d_write_page_offset(const void* buffer,
+                             u16_t       page,
+                             u16_t       start_byte_in_page,
+                             u16_t       number_of_bytes)
 {
+    // Buffer 1 is overwritten; program changes made by at45d_write()
+    at45d_rmw_release();
+
+#if AT45D_CACHE_PAGES
+    at45d_cache_discard(page);
+#endif
+
     // Wait until Flash is not busy
     while(!at45d_ready())
     {
         ;
-    }
+    }   
 
     // Select serial Flash
     AT45D_CS_LO();
@@ -259,23 +963,52 @@ void at45d_write_page(const void* buffer, u16_t page)
     spi1_tx_byte(AT45D_CMD_MAIN_MEM_PROG_THROUGH_BUF1);
 
     // Send address
-    at45d_send_address(page, 0);
+    at45d_send_address(page, start_byte_in_page);
 
     // Send data to be written
-    spi1_tx_data(buffer, AT45D_PAGE_SIZE);    
+    spi1_tx_data(buffer, number_of_bytes);    
 
     // Deselect serial Flash
     AT45D_CS_HI();
 
     // Set flag to busy
-    at45d_ready_flag = FALSE;
+    at45d_ready_flag  = FALSE;
+    at45d_prog_buffer = 1;
+
+#if AT45D_CACHE_PAGES
+    // Buffer 1 contains page
+    at45d_buf_set_page(1, page);
+#endif
 }
 
-void at45d_write_page_offset(const void* buffer,
-                             u16_t       page,
-                             u16_t       start_byte_in_page,
-                             u16_t       number_of_bytes)
+void at45d_write_page_seq(const void* buffer, u16_t page)
+{
+    // Buffer 1 may be overwritten; program changes made by at45d_write()
+    at45d_rmw_release();
+
+#if AT45D_CACHE_PAGES
+    at45d_cache_update(page, buffer);
+#endif
+
+    at45d_program_seq(buffer, page, TRUE);
+}
+
+#if AT45D_PBUF
+u16_t at45d_write_page_pbuf(const pbuf_t *p,
+                            u16_t        page,
+                            u16_t        start_byte_in_page)
 {
+    u16_t bytes_free = AT45D_PAGE_SIZE - start_byte_in_page;
+    u16_t bytes_written = 0;
+    u16_t len;
+
+    // Buffer 1 is overwritten; program changes made by at45d_write()
+    at45d_rmw_release();
+
+#if AT45D_CACHE_PAGES
+    at45d_cache_discard(page);
+#endif
+
     // Wait until Flash is not busy
     while(!at45d_ready())
     {
@@ -291,18 +1024,40 @@ void at45d_write_page_offset(const void* buffer,
     // Send address
     at45d_send_address(page, start_byte_in_page);
 
-    // Send data to be written
-    spi1_tx_data(buffer, number_of_bytes);    
+    // Send data of each buffer in chain (up to end of page)
+    while((p != NULL) && (bytes_written != bytes_free))
+    {
+        len = p->len;
+        if(len > (bytes_free - bytes_written))
+        {
+            len = bytes_free - bytes_written;
+        }
+        spi1_tx_data(p->payload, len);
+        bytes_written += len;
+        p              = p->next;
+    }
 
     // Deselect serial Flash
     AT45D_CS_HI();
 
     // Set flag to busy
-    at45d_ready_flag = FALSE;
+    at45d_ready_flag  = FALSE;
+    at45d_prog_buffer = 1;
+
+#if AT45D_CACHE_PAGES
+    // Buffer 1 contains page
+    at45d_buf_set_page(1, page);
+#endif
+
+    return bytes_written;
 }
+#endif
 
 void at45d_erase_page(u16_t page)
 {
+    // Buffer 1 is overwritten; program changes made by at45d_write()
+    at45d_rmw_release();
+
     // Wait until Flash is not busy
     while(!at45d_ready())
     {
@@ -312,6 +1067,19 @@ void at45d_erase_page(u16_t page)
     // Select serial Flash
     AT45D_CS_LO();
 
+#if AT45D_CACHE_PAGES
+    // Buffer copies of page are stale
+    at45d_cache_update(page, NULL);
+    if(at45d_buf_page[0] == page)
+    {
+        at45d_buf_page[0] = AT45D_PAGE_NONE;
+    }
+    if(at45d_buf_page[1] == page)
+    {
+        at45d_buf_page[1] = AT45D_PAGE_NONE;
+    }
+#endif
+
     // Send command
     spi1_tx_byte(AT45D_CMD_PAGE_ERASE);
 
@@ -322,7 +1090,207 @@ void at45d_erase_page(u16_t page)
     AT45D_CS_HI();
 
     // Set flag to busy
-    at45d_ready_flag = FALSE;
+    at45d_ready_flag  = FALSE;
+    at45d_prog_buffer = 0;
+}
+
+#if AT45D_ASYNC
+void at45d_read_async(at45d_req_t     *req,
+                      void            *buffer,
+                      u16_t           page,
+                      u16_t           start_byte_in_page,
+                      u16_t           number_of_bytes,
+                      at45d_on_done_t on_done)
+{
+    req->buffer             = (u8_t *)buffer;
+    req->page               = page;
+    req->start_byte_in_page = start_byte_in_page;
+    req->number_of_bytes    = number_of_bytes;
+
+    at45d_req_add(req, AT45D_REQ_READ, on_done);
+}
+
+void at45d_write_page_async(at45d_req_t     *req,
+                            const void      *buffer,
+                            u16_t           page,
+                            at45d_on_done_t on_done)
+{
+    // Buffer is only read
+    req->buffer = (u8_t *)buffer;
+    req->page   = page;
+
+    at45d_req_add(req, AT45D_REQ_WRITE_PAGE, on_done);
+
+    // Start immediately if this is the only request
+    if(at45d_req_first == req)
+    {
+        at45d_service();
+    }
+}
+
+void at45d_erase_page_async(at45d_req_t     *req,
+                            u16_t           page,
+                            at45d_on_done_t on_done)
+{
+    req->page = page;
+
+    at45d_req_add(req, AT45D_REQ_ERASE_PAGE, on_done);
+
+    // Start immediately if this is the only request
+    if(at45d_req_first == req)
+    {
+        at45d_service();
+    }
+}
+
+void at45d_service(void)
+{
+    at45d_req_t *req;
+#if AT45D_CACHE_PAGES
+    u8_t        pos;
+#endif
+
+    while(at45d_req_first != NULL)
+    {
+        // Wait for next call if DataFlash is busy
+        if(!at45d_ready())
+        {
+            return;
+        }
+
+        req = at45d_req_first;
+        if(!req->started)
+        {
+            // Program changes made by at45d_write() first (without waiting)
+            if(at45d_rmw_dirty)
+            {
+                at45d_flush();
+                return;
+            }
+
+            switch(req->type)
+            {
+            case AT45D_REQ_READ:
+#if AT45D_CACHE_PAGES
+                // Copy from cache if page is cached (a cache miss must not
+                // wait for the write back of a replaced entry)
+                pos = at45d_cache_find(req->page);
+                if(pos != AT45D_CACHE_PAGES)
+                {
+                    memcpy(req->buffer, 
+                           &at45d_cache_data[at45d_cache_use(pos)][req->start_byte_in_page],
+                           req->number_of_bytes);
+                    break;
+                }
+#endif
+                // Finished immediately, because DataFlash is ready
+                at45d_mem_read(req->buffer,
+                               req->page,
+                               req->start_byte_in_page,
+                               req->number_of_bytes);
+                break;
+
+            case AT45D_REQ_WRITE_PAGE:
+                at45d_write_page(req->buffer, req->page);
+                req->started = TRUE;
+                return;
+
+            case AT45D_REQ_ERASE_PAGE:
+                at45d_erase_page(req->page);
+                req->started = TRUE;
+                return;
+
+            default:
+                break;
+            }
+        }
+
+        // Remove finished request before calling handler (may submit new requests)
+        at45d_req_first = req->next;
+        if(req->on_done != NULL)
+        {
+            (*req->on_done)(req);
+        }
+
+        // Limit time spent to one data transfer per call
+        if(req->type == AT45D_REQ_READ)
+        {
+            return;
+        }
+    }
+}
+
+bool_t at45d_busy(void)
+{
+    if(at45d_req_first != NULL)
+    {
+        return TRUE;
+    }
+
+    return !at45d_ready();
+}
+#endif
+
+u16_t at45d_write(const void  *buffer,
+                  at45d_adr_t address,
+                  u16_t       number_of_bytes)
+{
+    return at45d_write_data(buffer, address, number_of_bytes, TRUE);
+}
+
+u16_t at45d_append(const void  *buffer,
+                   at45d_adr_t address,
+                   u16_t       number_of_bytes)
+{
+    return at45d_write_data(buffer, address, number_of_bytes, FALSE);
+}
+
+void at45d_flush(void)
+{
+#if AT45D_CACHE_PAGES
+    u8_t entry;
+
+    // Write back changed cache entries
+    for(entry=0; entry<AT45D_CACHE_PAGES; entry++)
+    {
+        at45d_cache_write_back(entry);
+    }
+#endif
+
+    if(!at45d_rmw_dirty)
+    {
+        return;
+    }
+
+    // Wait until Flash is not busy
+    while(!at45d_ready())
+    {
+        ;
+    }
+
+    // Select serial Flash
+    AT45D_CS_LO();
+
+    // Send command (program with or without built-in erase)
+    if(at45d_rmw_erase)
+    {
+        spi1_tx_byte(AT45D_CMD_BUF1_TO_MAIN_PAGE_PROGRAM);
+    }
+    else
+    {
+        spi1_tx_byte(AT45D_CMD_BUF1_TO_MAIN_PAGE_PROG_NO_ER);
+    }
+
+    // Send address
+    at45d_send_address(at45d_rmw_page, 0);
+
+    // Deselect serial Flash
+    AT45D_CS_HI();
+
+    // Set flag to busy
+    at45d_ready_flag  = FALSE;
+    at45d_prog_buffer = 1;
+    at45d_rmw_dirty   = FALSE;
 }
 
 bool_t at45d_ready(void)
@@ -432,5 +1400,14 @@ extern bool_t at45d_set_page_size_to_pwr_of_two(void)
 
  2010-04-15 : Pieter.Conradie
  - First release
+
+ 2026-10-19 : agent
+ - Added at45d_write_page_pbuf() (AT45D_PBUF)
+ - Added profiler markers (PROF)
+ - Added at45d_write_page_seq() to overlap page load and program
+ - Added asynchronous request queue (AT45D_ASYNC)
+ - Added support for 512/528 and 1024/1056 byte pages
+ - Added at45d_write() and at45d_flush() (read-modify-write via buffer 1)
+ - Added RAM page cache with SRAM buffers as second level (AT45D_CACHE_PAGES)
    
 */
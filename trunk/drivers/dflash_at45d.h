@@ -49,12 +49,125 @@
  *  @par Reference:
  *  - <a href="http://www.atmel.com/dyn/resources/prod_documents/doc3595.pdf">Atmel 4M bit 2.5-Volt or 2.7-Volt DataFlash AT45DB041D datasheet</a>
  *
+ *  @par Packet buffers
+ *  If #AT45D_PBUF is set to 1, at45d_write_page_pbuf() writes a chain of 
+ *  @ref PBUF packet buffers, e.g. a frame received with @ref HDLC, directly
+ *  from the buffers without gathering it into a contiguous buffer first.
+ *
+ *  @par Sequential write
+ *  at45d_write_page() transfers a page through buffer 1 and the next call
+ *  waits until the page has been programmed, so the SPI transfer time and 
+ *  the program time add up. at45d_write_page_seq() alternates between the
+ *  two SRAM buffers of the device: the next page is loaded into one buffer 
+ *  while the other buffer is being programmed into main memory, so that 
+ *  the transfer is hidden behind the program time. When writing a stream
+ *  of pages (e.g. a data log), the time per page drops from transfer time 
+ *  plus program time to the longer of the two, i.e. up to double the 
+ *  sustained write rate with a slow SPI clock. Devices with only one 
+ *  buffer (#AT45D_BUFFERS is 1) always use buffer 1 and do not overlap.
+ *
+ *  @par Byte addressable write
+ *  at45d_write() writes data of any length to any address, like 
+ *  at45d_read(). The page is loaded into buffer 1, only the specified bytes
+ *  are changed in the buffer and the buffer is programmed back, so the 
+ *  rest of the page is preserved and page crossings are handled. The 
+ *  buffer is only programmed when a write moves to another page or when 
+ *  at45d_flush() is called. Consecutive writes to the same page (e.g. 
+ *  appending small records to a log) therefore cost one page program 
+ *  instead of one per write. The other functions program pending changes
+ *  before they access the page or use buffer 1. at45d_flush() must be 
+ *  called before power is removed.
+ *  
+ *  The page program has a built-in erase, so if it is interrupted (e.g. 
+ *  by a power failure), the whole page may be lost, including data that 
+ *  was programmed before. at45d_append() writes only to bytes that are 
+ *  erased (0xFF) and programs the page without the built-in erase: an 
+ *  interrupted program can only corrupt the appended bytes. Logs that 
+ *  must keep records that have already been flushed use at45d_append() 
+ *  on pages that have been erased with at45d_erase_page().
+ *
+ *  @par Page cache
+ *  Each read costs a command, a 3-byte address, 4 dont-care bytes and a 
+ *  chip select toggle, which adds up when small fields (e.g. configuration
+ *  values or lookup tables) on the same few pages are read repeatedly. If 
+ *  #AT45D_CACHE_PAGES is set to 1 to 8, that number of pages is cached in 
+ *  RAM (#AT45D_PAGE_SIZE bytes each). at45d_read() and 
+ *  at45d_read_page_offset() copy from the cache and only access the 
+ *  DataFlash when the page is not cached. A miss reads only the requested
+ *  bytes, because adding a page to the cache reads the whole page. A page
+ *  is only added if there is an empty entry, or if the least recently used
+ *  entry has not been used for (#AT45D_PAGE_SIZE / 2) misses, so a cache 
+ *  that is too small for the pages that are used together does not cost 
+ *  much more than no cache. Whole page reads with at45d_read_page() use the
+ *  cache, but do not add the page to it, so that a scan of the chip does 
+ *  not flush the cache.
+ *  
+ *  at45d_write() changes the cached page in RAM (write-back). Changed pages
+ *  are programmed when they are replaced or when at45d_flush() is called 
+ *  (overlapped using both SRAM buffers as with at45d_write_page_seq()). The 
+ *  page write and erase functions keep the cached copy of only that page 
+ *  consistent; other changed pages stay in the cache.
+ *  
+ *  The driver also remembers which page each SRAM buffer contains after a 
+ *  page has been programmed through it. A page that is not cached in RAM, 
+ *  but is still in an SRAM buffer, is read from the buffer: the read 
+ *  command has one dont-care byte instead of 4 and is allowed while the 
+ *  other buffer is being programmed, so it does not wait for the program 
+ *  to finish.
+ *
+ *  @par Asynchronous operations
+ *  Each function above first waits until the previous page program or 
+ *  erase has finished, which can take up to ~20 ms. If #AT45D_ASYNC is set
+ *  to 1, reads and writes can be submitted as requests instead, e.g. with
+ *  at45d_write_page_async(). The request is added to a queue and the 
+ *  function returns immediately. at45d_service() must be polled from the 
+ *  main loop (or a @ref SCHED task). It never waits: if the DataFlash is 
+ *  busy, it returns and tries again on the next call. When a request is 
+ *  finished (a read has completed or a page has been programmed), it is 
+ *  removed from the queue and its optional completion handler is called 
+ *  from at45d_service(). The request object and data buffer are supplied 
+ *  by the caller and must not be modified until the request is finished.
+ *  @code
+ *  static at45d_req_t req;
+ *  
+ *  static void log_on_written(at45d_req_t *req)
+ *  {
+ *      // Page has been programmed; buffer can be reused
+ *  }
+ *  
+ *  at45d_write_page_async(&req, buffer, page, &log_on_written);
+ *  for(;;)
+ *  {
+ *      at45d_service();
+ *      ...
+ *  }
+ *  @endcode
+ *
  *  @{
  */
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
 
+#ifndef AT45D_PBUF
+/// Flag to add at45d_write_page_pbuf() (see @ref PBUF)
+#define AT45D_PBUF 0
+#endif
+
+#if AT45D_PBUF
+#include "pbuf.h"
+#endif
+
+#ifndef AT45D_ASYNC
+/// Flag to add the asynchronous request queue (see at45d_service())
+#define AT45D_ASYNC 0
+#endif
+
+#ifndef AT45D_CACHE_PAGES
+/// Number of pages cached in RAM (0 to 8); see @ref AT45D "Page cache"
+#define AT45D_CACHE_PAGES 0
+#endif
+
 /* __DEFINITIONS ____________________________________________________________ */
 // Definitions for the benefit of Doxygen
 #ifdef __DOXYGEN__
@@ -62,6 +175,8 @@
 #define AT45DB041D
 #define AT45D_PAGES             2048UL
 #define AT45D_PAGE_SIZE         264
+/// Number of SRAM buffers of the device (1 or 2)
+#define AT45D_BUFFERS           2
 #endif
 
 /*
@@ -83,6 +198,7 @@
 #else
 #define AT45D_PAGE_SIZE         264
 #endif
+#define AT45D_BUFFERS           1
 // AT45DB021D: 2M bit, 2.7-Volt Minimum Serial-Interface Flash with One 264-Byte SRAM Buffer
 #elif defined(AT45DB021D)
 #define AT45D_PAGES             1024UL
@@ -91,6 +207,7 @@
 #else
 #define AT45D_PAGE_SIZE         264
 #endif
+#define AT45D_BUFFERS           1
 // AT45DB041D: 4M bit 2.5-Volt or 2.7-Volt DataFlash
 #elif defined(AT45DB041D)
 #define AT45D_PAGES             2048UL
@@ -99,6 +216,7 @@
 #else
 #define AT45D_PAGE_SIZE         264
 #endif
+#define AT45D_BUFFERS           2
 #define AT45D_DENSITY           0x1C
 // AT45DB081D: 8M bit, 2.5 or 2.7-Volt Only Serial-Interface Flash
 #elif defined(AT45DB081D)
@@ -108,6 +226,7 @@
 #else
 #define AT45D_PAGE_SIZE         264
 #endif
+#define AT45D_BUFFERS           2
 // AT45DB161D: 16M bit, 2.7-Volt Only Serial-Interface Flash with two SRAM Data Buffers
 #elif defined(AT45DB161D)
 #define AT45D_PAGES             4096UL
@@ -116,6 +235,7 @@
 #else
 #define AT45D_PAGE_SIZE         528
 #endif
+#define AT45D_BUFFERS           2
 // AT45DB321D:  32M bit, 2.7-Volt Only Serial Interface Flash
 #elif defined(AT45DB321D)
 #define AT45D_PAGES             8192UL
@@ -124,6 +244,7 @@
 #else
 #define AT45D_PAGE_SIZE         528
 #endif
+#define AT45D_BUFFERS           2
 // AT45DB642D: 64M bit, 2.7-Volt Dual-Interface Flash with two 1056-Byte SRAM
 #elif defined(AT45DB642D)
 #define AT45D_PAGES             8192UL
@@ -132,6 +253,7 @@
 #else
 #define AT45D_PAGE_SIZE         1056
 #endif
+#define AT45D_BUFFERS           2
 
 #else
 #error "No compatible AT45D device selected"
@@ -163,6 +285,39 @@ typedef u16_t at45d_adr_t;
 typedef u32_t at45d_adr_t;
 #endif
 
+#if AT45D_ASYNC
+/// Request type
+typedef enum
+{
+    AT45D_REQ_READ = 0,         ///< Read part of a page
+    AT45D_REQ_WRITE_PAGE,       ///< Write a page
+    AT45D_REQ_ERASE_PAGE        ///< Erase a page
+} at45d_req_type_t;
+
+///@cond
+struct at45d_req_s;
+///@endcond
+
+/**
+ * Definition for a pointer to a function that will be called when a 
+ * request is finished.
+ */
+typedef void (*at45d_on_done_t)(struct at45d_req_s *req);
+
+/// Asynchronous request (see at45d_service())
+typedef struct at45d_req_s
+{
+    struct at45d_req_s *next;           ///< Next request in queue
+    u8_t               *buffer;         ///< Buffer to read into or write from
+    u16_t              page;            ///< 0 to (#AT45D_PAGES-1)
+    u16_t              start_byte_in_page; ///< Index of first byte to read
+    u16_t              number_of_bytes; ///< Number of bytes to read
+    u8_t               type;            ///< See #at45d_req_type_t
+    bool_t             started;         ///< Write/erase has been started
+    at45d_on_done_t    on_done;         ///< Completion handler; NULL if none
+} at45d_req_t;
+#endif
+
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
@@ -265,6 +420,92 @@ extern void at45d_write_page_offset(const void *buffer,
                                     u16_t      start_byte_in_page,                                    
                                     u16_t      number_of_bytes);
 
+/**
+ *  Write a page to DataFlash as part of a sequence of page writes.
+ * 
+ *  The page is loaded into the SRAM buffer that is not being programmed 
+ *  into main memory (without waiting for the program to finish) and then 
+ *  programmed into the specified page. The function returns as soon as 
+ *  the page program has been started. Consecutive calls alternate between
+ *  the two buffers; see @ref AT45D "Sequential write".
+ * 
+ *  Sequential writes may be mixed with other functions of the driver and 
+ *  the pages do not need to be consecutive.
+ * 
+ *  @param[in] buffer  Buffer containing #AT45D_PAGE_SIZE bytes of data
+ *  @param[in] page    0 to (#AT45D_PAGES-1)
+ */
+extern void at45d_write_page_seq(const void *buffer,
+                                 u16_t      page);
+
+#if AT45D_PBUF
+/**
+ *  Partial write of a chain of packet buffers in a page of DataFlash.
+ * 
+ *  The data of each buffer in the chain is sent to the DataFlash in turn,
+ *  so the packet is written without copying it to a contiguous buffer. The
+ *  chain is not released.
+ * 
+ *  @note Data beyond the end of the page is not written.
+ * 
+ *  @param[in]  p                   First buffer of chain
+ *  @param[in]  page                0 to (#AT45D_PAGES-1)
+ *  @param[in]  start_byte_in_page  Index of first byte to write (0 to
+ *                                  #AT45D_PAGE_SIZE - 1)
+ * 
+ *  @return u16_t                   Number of bytes written
+ */
+extern u16_t at45d_write_page_pbuf(const pbuf_t *p,
+                                   u16_t        page,
+                                   u16_t        start_byte_in_page);
+#endif
+
+/**
+ *  Write data to DataFlash.
+ *  
+ *  The data may cross page boundaries. Existing data in the pages outside
+ *  the specified range is preserved. The changes of the last page are kept
+ *  in buffer 1 until a write to another page or at45d_flush(); see 
+ *  @ref AT45D "Byte addressable write".
+ * 
+ *  @param[in] buffer           Buffer containing data to be written
+ *  @param[in] address          0 to AT45D_ADR_MAX
+ *  @param[in] number_of_bytes  Number of bytes to write
+ *  
+ *  @return u16_t               Number of bytes actually written
+ */
+extern u16_t at45d_write(const void  *buffer,
+                         at45d_adr_t address,
+                         u16_t       number_of_bytes);
+
+/**
+ *  Write data to erased bytes (0xFF) at any address.
+ *  
+ *  Same as at45d_write(), but the page is programmed without the built-in
+ *  erase, so that the data that is already in the page is not lost if 
+ *  the program is interrupted. If the page is also changed with 
+ *  at45d_write() before it is programmed, it is programmed with erase.
+ *  See @ref AT45D "Byte addressable write".
+ * 
+ *  @param[in] buffer           Buffer containing data to be written
+ *  @param[in] address          0 to AT45D_ADR_MAX
+ *  @param[in] number_of_bytes  Number of bytes to write
+ *  
+ *  @return u16_t               Number of bytes actually written
+ */
+extern u16_t at45d_append(const void  *buffer,
+                          at45d_adr_t address,
+                          u16_t       number_of_bytes);
+
+/**
+ *  Program changes made by at45d_write() and at45d_append() into main 
+ *  memory.
+ *  
+ *  The function returns as soon as the page program has been started. 
+ *  It does nothing if there are no pending changes.
+ */
+extern void at45d_flush(void);
+
 /**
  *  Erase a page of DataFlash.
  *  
@@ -288,6 +529,73 @@ extern void at45d_erase_page(u16_t page);
  */
 extern bool_t at45d_ready(void);
 
+#if AT45D_ASYNC
+/**
+ *  Submit a request to read part of a page.
+ * 
+ *  @param[in]  req                 Request object (supplied by caller)
+ *  @param[out] buffer              Buffer to store read data
+ *  @param[in]  page                0 to (#AT45D_PAGES-1)
+ *  @param[in]  start_byte_in_page  Index of first byte to read (0 to
+ *                                  #AT45D_PAGE_SIZE - 1)
+ *  @param[in]  number_of_bytes     Number of bytes to read
+ *  @param[in]  on_done             Completion handler; NULL if none
+ */
+extern void at45d_read_async(at45d_req_t     *req,
+                             void            *buffer,
+                             u16_t           page,
+                             u16_t           start_byte_in_page,
+                             u16_t           number_of_bytes,
+                             at45d_on_done_t on_done);
+
+/**
+ *  Submit a request to write a page.
+ * 
+ *  The request is finished when the page has been programmed.
+ * 
+ *  @param[in] req      Request object (supplied by caller)
+ *  @param[in] buffer   Buffer containing #AT45D_PAGE_SIZE bytes of data
+ *  @param[in] page     0 to (#AT45D_PAGES-1)
+ *  @param[in] on_done  Completion handler; NULL if none
+ */
+extern void at45d_write_page_async(at45d_req_t     *req,
+                                   const void      *buffer,
+                                   u16_t           page,
+                                   at45d_on_done_t on_done);
+
+/**
+ *  Submit a request to erase a page.
+ * 
+ *  The request is finished when the page has been erased.
+ * 
+ *  @param[in] req      Request object (supplied by caller)
+ *  @param[in] page     0 to (#AT45D_PAGES-1)
+ *  @param[in] on_done  Completion handler; NULL if none
+ */
+extern void at45d_erase_page_async(at45d_req_t     *req,
+                                   u16_t           page,
+                                   at45d_on_done_t on_done);
+
+/**
+ *  Service the request queue without waiting.
+ * 
+ *  Poll this function from the main loop or a task. Requests are started
+ *  in the order that they were submitted, as soon as the DataFlash is 
+ *  ready. At most one page of data is transferred per call, so the time 
+ *  spent does not depend on the program time. Completion handlers are called from this function and may submit
+ *  new requests.
+ */
+extern void at45d_service(void);
+
+/**
+ *  See if the DataFlash is busy or requests are pending.
+ * 
+ *  @retval TRUE    DataFlash is busy or request queue is not empty
+ *  @retval FALSE   DataFlash is ready and request queue is empty
+ */
+extern bool_t at45d_busy(void);
+#endif
+
 /**
  *  Read the status register of the DataFlash.
  * 
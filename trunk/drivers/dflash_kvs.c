@@ -0,0 +1,685 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Log-structured key-value store on DataFlash
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dflash_kvs.h"
+#include "crc16_ccitt.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Size of page header: [SEQ (4)] [CRC (2)]
+#define KVS_PAGE_HDR_SIZE   6
+
+/// Size of record header: [KEY (2)] [LEN (1)] [TYPE (1)] [CRC (2)]
+#define KVS_REC_HDR_SIZE    6
+
+/// Maximum size of a record
+#define KVS_REC_SIZE_MAX    (KVS_REC_HDR_SIZE + KVS_VALUE_SIZE_MAX)
+
+/// Number of entries in RAM index
+#define KVS_INDEX_SIZE      (1ul << KVS_INDEX_BITS)
+
+/// Mask to wrap index position
+#define KVS_INDEX_MASK      ((u16_t)(KVS_INDEX_SIZE - 1))
+
+/// \name Record types
+//@{
+#define KVS_REC_SET         0x01
+#define KVS_REC_DELETE      0x02
+//@}
+
+/// \name State of a page (see kvs_page_state())
+//@{
+#define KVS_PAGE_ERASED     0
+#define KVS_PAGE_USED       1
+#define KVS_PAGE_INVALID    2
+//@}
+
+#if (KVS_PAGES < 3)
+#error "KVS_PAGES must be at least 3"
+#endif
+
+#if ((KVS_PAGE_FIRST + KVS_PAGES) > AT45D_PAGES)
+#error "KVS region is larger than DataFlash"
+#endif
+
+#if (KVS_VALUE_SIZE_MAX > 255) || ((KVS_PAGE_HDR_SIZE + KVS_REC_SIZE_MAX) > AT45D_PAGE_SIZE)
+#error "KVS_VALUE_SIZE_MAX is too large"
+#endif
+
+#if (KVS_INDEX_BITS < 1) || (KVS_INDEX_BITS > 15)
+#error "KVS_INDEX_BITS must be 1 to 15"
+#endif
+
+/// Entry of RAM index
+typedef struct
+{
+    u16_t key;      ///< Key; KVS_KEY_NONE if entry is empty
+    u16_t page;     ///< Page of newest record (0 to KVS_PAGES-1)
+    u16_t offset;   ///< Offset of newest record in page
+} kvs_index_t;
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// RAM index: location of newest record of each key
+static kvs_index_t kvs_index[KVS_INDEX_SIZE];
+
+/// Number of keys in index
+static u16_t       kvs_nr_keys;
+
+/// Oldest and newest page of log (0 to KVS_PAGES-1)
+static u16_t       kvs_tail;
+static u16_t       kvs_head;
+
+/// Number of pages in log (from tail to head)
+static u16_t       kvs_used;
+
+/// Offset in head page where next record is appended
+static u16_t       kvs_head_offset;
+
+/// Sequence number of head page
+static u32_t       kvs_head_seq;
+
+/// Record that is read or appended
+static u8_t        kvs_buf[KVS_REC_SIZE_MAX];
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// DataFlash address of offset in page of region
+static at45d_adr_t kvs_adr(u16_t page, u16_t offset)
+{
+    return (at45d_adr_t)(KVS_PAGE_FIRST + page) * AT45D_PAGE_SIZE + offset;
+}
+
+/// Next page of circular log
+static u16_t kvs_next_page(u16_t page)
+{
+    if(++page == KVS_PAGES)
+    {
+        page = 0;
+    }
+    return page;
+}
+
+/// Home position of key in index (Fibonacci hashing)
+static u16_t kvs_hash(u16_t key)
+{
+    return (u16_t)(key * 40503u) >> (16 - KVS_INDEX_BITS);
+}
+
+/**
+ *  Find entry of key in index. If the key is not found, the empty entry 
+ *  where it can be added is returned (NULL if the index is full).
+ */
+static kvs_index_t *kvs_index_find(u16_t key)
+{
+    u16_t       pos = kvs_hash(key);
+    u16_t       i;
+    kvs_index_t *entry;
+
+    for(i=0; i<=KVS_INDEX_MASK; i++)
+    {
+        entry = &kvs_index[pos];
+        if((entry->key == key) || (entry->key == KVS_KEY_NONE))
+        {
+            return entry;
+        }
+        pos = (pos + 1) & KVS_INDEX_MASK;
+    }
+
+    return NULL;
+}
+
+/// Remove entry from index (entries that follow are moved back to close the gap)
+static void kvs_index_remove(kvs_index_t *entry)
+{
+    u16_t pos  = (u16_t)(entry - kvs_index);
+    u16_t next = pos;
+    u16_t home;
+
+    for(;;)
+    {
+        next = (next + 1) & KVS_INDEX_MASK;
+        if(kvs_index[next].key == KVS_KEY_NONE)
+        {
+            break;
+        }
+        // Move entry if the gap is between its home position and itself
+        home = kvs_hash(kvs_index[next].key);
+        if(((next - home) & KVS_INDEX_MASK) >= ((next - pos) & KVS_INDEX_MASK))
+        {
+            kvs_index[pos] = kvs_index[next];
+            pos            = next;
+        }
+    }
+    kvs_index[pos].key = KVS_KEY_NONE;
+    kvs_nr_keys--;
+}
+
+/// Calculate CRC of record in kvs_buf
+static u16_t kvs_rec_crc(void)
+{
+    u16_t crc;
+
+    crc = crc16_ccitt_calc_data(CRC16_CCITT_INIT_VAL, kvs_buf, 4);
+    crc = crc16_ccitt_calc_data(crc, &kvs_buf[KVS_REC_HDR_SIZE], kvs_buf[2]);
+
+    return crc;
+}
+
+/**
+ *  Read record at offset in page into kvs_buf. Returns the size of the 
+ *  record or 0 if there are no more valid records in the page.
+ */
+static u8_t kvs_rec_read(u16_t page, u16_t offset)
+{
+    u16_t len = AT45D_PAGE_SIZE - offset;
+    u8_t  size;
+
+    if(len < KVS_REC_HDR_SIZE)
+    {
+        return 0;
+    }
+    if(len > KVS_REC_SIZE_MAX)
+    {
+        len = KVS_REC_SIZE_MAX;
+    }
+
+    // Read header and value with one read
+    at45d_read(kvs_buf, kvs_adr(page, offset), len);
+
+    // Erased (end of records)?
+    if((kvs_buf[0] == 0xff) && (kvs_buf[1] == 0xff))
+    {
+        return 0;
+    }
+
+    // Valid record?
+    if(kvs_buf[2] > KVS_VALUE_SIZE_MAX)
+    {
+        return 0;
+    }
+    size = KVS_REC_HDR_SIZE + kvs_buf[2];
+    if(size > len)
+    {
+        return 0;
+    }
+    if(kvs_rec_crc() != (kvs_buf[4] | ((u16_t)kvs_buf[5] << 8)))
+    {
+        return 0;
+    }
+
+    return size;
+}
+
+/// Get key of record in kvs_buf
+static u16_t kvs_rec_key(void)
+{
+    return kvs_buf[0] | ((u16_t)kvs_buf[1] << 8);
+}
+
+/// Build record in kvs_buf; returns size of record
+static u8_t kvs_rec_build(u16_t key, u8_t type, const void *value, u8_t len)
+{
+    u16_t crc;
+
+    kvs_buf[0] = (u8_t)(key & 0xff);
+    kvs_buf[1] = (u8_t)(key >> 8);
+    kvs_buf[2] = len;
+    kvs_buf[3] = type;
+    if(len != 0)
+    {
+        memcpy(&kvs_buf[KVS_REC_HDR_SIZE], value, len);
+    }
+    crc        = kvs_rec_crc();
+    kvs_buf[4] = (u8_t)(crc & 0xff);
+    kvs_buf[5] = (u8_t)(crc >> 8);
+
+    return KVS_REC_HDR_SIZE + len;
+}
+
+/// Read header of page and return state of page (and sequence number if used)
+static u8_t kvs_page_state(u16_t page, u32_t *seq)
+{
+    u8_t  hdr[KVS_PAGE_HDR_SIZE];
+    u8_t  i;
+    u16_t crc;
+
+    at45d_read(hdr, kvs_adr(page, 0), KVS_PAGE_HDR_SIZE);
+
+    for(i=0; i<KVS_PAGE_HDR_SIZE; i++)
+    {
+        if(hdr[i] != 0xff)
+        {
+            break;
+        }
+    }
+    if(i == KVS_PAGE_HDR_SIZE)
+    {
+        return KVS_PAGE_ERASED;
+    }
+
+    crc = crc16_ccitt_calc_data(CRC16_CCITT_INIT_VAL, hdr, 4);
+    if(crc != (hdr[4] | ((u16_t)hdr[5] << 8)))
+    {
+        return KVS_PAGE_INVALID;
+    }
+
+    *seq =   (u32_t)hdr[0]         | ((u32_t)hdr[1] << 8) 
+           | ((u32_t)hdr[2] << 16) | ((u32_t)hdr[3] << 24);
+
+    return KVS_PAGE_USED;
+}
+
+/// Check that page is erased from offset up to end of page
+static bool_t kvs_page_is_erased(u16_t page, u16_t offset)
+{
+    u8_t  data[16];
+    u16_t len;
+    u8_t  i;
+
+    while(offset < AT45D_PAGE_SIZE)
+    {
+        len = AT45D_PAGE_SIZE - offset;
+        if(len > sizeof(data))
+        {
+            len = sizeof(data);
+        }
+        at45d_read(data, kvs_adr(page, offset), len);
+        for(i=0; i<len; i++)
+        {
+            if(data[i] != 0xff)
+            {
+                return FALSE;
+            }
+        }
+        offset += len;
+    }
+
+    return TRUE;
+}
+
+/// Add a free page to the head of the log
+static void kvs_page_start(u16_t page)
+{
+    u8_t  hdr[KVS_PAGE_HDR_SIZE];
+    u16_t crc;
+
+    // Page may contain the remains of an interrupted program
+    if(!kvs_page_is_erased(page, 0))
+    {
+        at45d_erase_page(KVS_PAGE_FIRST + page);
+    }
+
+    kvs_head_seq++;
+    hdr[0] = (u8_t)(kvs_head_seq & 0xff);
+    hdr[1] = (u8_t)(kvs_head_seq >> 8);
+    hdr[2] = (u8_t)(kvs_head_seq >> 16);
+    hdr[3] = (u8_t)(kvs_head_seq >> 24);
+    crc    = crc16_ccitt_calc_data(CRC16_CCITT_INIT_VAL, hdr, 4);
+    hdr[4] = (u8_t)(crc & 0xff);
+    hdr[5] = (u8_t)(crc >> 8);
+    at45d_append(hdr, kvs_adr(page, 0), KVS_PAGE_HDR_SIZE);
+
+    kvs_head        = page;
+    kvs_head_offset = KVS_PAGE_HDR_SIZE;
+    kvs_used++;
+}
+
+/**
+ *  Append record in kvs_buf to head of log. If it does not fit in the head
+ *  page, a free page is added to the log. The record is programmed without
+ *  erase, so that records that have been synced are not lost if the 
+ *  program is interrupted.
+ */
+static void kvs_rec_append(u8_t size)
+{
+    if((kvs_head_offset + size) > AT45D_PAGE_SIZE)
+    {
+        kvs_page_start(kvs_next_page(kvs_head));
+    }
+    at45d_append(kvs_buf, kvs_adr(kvs_head, kvs_head_offset), size);
+    kvs_head_offset += size;
+}
+
+/// Append records of tail page that are still in use again and erase tail page
+static void kvs_gc(void)
+{
+    u16_t       offset = KVS_PAGE_HDR_SIZE;
+    u16_t       key;
+    u8_t        size;
+    kvs_index_t *entry;
+
+    while((size = kvs_rec_read(kvs_tail, offset)) != 0)
+    {
+        // Newest record of key? (a delete record is never in use)
+        key   = kvs_rec_key();
+        entry = kvs_index_find(key);
+        if(  (kvs_buf[3] == KVS_REC_SET) && (entry != NULL) && (entry->key == key)
+           &&(entry->page == kvs_tail)   && (entry->offset == offset)             )
+        {
+            kvs_rec_append(size);
+            entry->page   = kvs_head;
+            entry->offset = kvs_head_offset - size;
+        }
+        offset += size;
+    }
+
+    // Records must be programmed before the tail page is erased
+    at45d_flush();
+    at45d_erase_page(KVS_PAGE_FIRST + kvs_tail);
+    kvs_tail = kvs_next_page(kvs_tail);
+    kvs_used--;
+}
+
+/**
+ *  Make sure that a record can be appended, keeping one free page for 
+ *  garbage collection. Returns FALSE if the store is full.
+ */
+static bool_t kvs_make_room(u8_t size)
+{
+    u16_t i;
+
+    if((kvs_head_offset + size) <= AT45D_PAGE_SIZE)
+    {
+        return TRUE;
+    }
+
+    for(i=0; (KVS_PAGES - kvs_used) < 2; i++)
+    {
+        // All of the records are in use?
+        if(i == KVS_PAGES)
+        {
+            return FALSE;
+        }
+        kvs_gc();
+    }
+
+    return TRUE;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void kvs_format(void)
+{
+    u16_t page;
+
+    for(page=0; page<KVS_PAGES; page++)
+    {
+        at45d_erase_page(KVS_PAGE_FIRST + page);
+    }
+
+    kvs_mount();
+}
+
+bool_t kvs_mount(void)
+{
+    u16_t       i;
+    u16_t       page;
+    u16_t       offset;
+    u16_t       key;
+    u8_t        size;
+    u32_t       seq;
+    u32_t       seq_min = 0;
+    kvs_index_t *entry;
+    bool_t      found   = FALSE;
+    bool_t      result  = TRUE;
+
+    // Empty index
+    for(i=0; i<=KVS_INDEX_MASK; i++)
+    {
+        kvs_index[i].key = KVS_KEY_NONE;
+    }
+    kvs_nr_keys = 0;
+
+    // Find tail (oldest) and head (newest) page; erase invalid pages
+    for(page=0; page<KVS_PAGES; page++)
+    {
+        switch(kvs_page_state(page, &seq))
+        {
+        case KVS_PAGE_USED:
+            if((!found) || (seq < seq_min))
+            {
+                seq_min  = seq;
+                kvs_tail = page;
+            }
+            if((!found) || (seq > kvs_head_seq))
+            {
+                kvs_head_seq = seq;
+                kvs_head     = page;
+            }
+            found = TRUE;
+            break;
+
+        case KVS_PAGE_INVALID:
+            at45d_erase_page(KVS_PAGE_FIRST + page);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Empty store?
+    if(!found)
+    {
+        kvs_head_seq = 0;
+        kvs_used     = 0;
+        kvs_tail     = 0;
+        kvs_page_start(0);
+        return TRUE;
+    }
+    kvs_used = ((kvs_head + KVS_PAGES - kvs_tail) % KVS_PAGES) + 1;
+
+    // Build index from records, oldest first
+    page = kvs_tail;
+    for(;;)
+    {
+        offset = KVS_PAGE_HDR_SIZE;
+        while((size = kvs_rec_read(page, offset)) != 0)
+        {
+            key   = kvs_rec_key();
+            entry = kvs_index_find(key);
+            if(kvs_buf[3] == KVS_REC_SET)
+            {
+                if(entry == NULL)
+                {
+                    // Index is full
+                    result = FALSE;
+                }
+                else
+                {
+                    if(entry->key != key)
+                    {
+                        entry->key = key;
+                        kvs_nr_keys++;
+                    }
+                    entry->page   = page;
+                    entry->offset = offset;
+                }
+            }
+            else if((entry != NULL) && (entry->key == key))
+            {
+                kvs_index_remove(entry);
+            }
+            offset += size;
+        }
+        if(page == kvs_head)
+        {
+            break;
+        }
+        page = kvs_next_page(page);
+    }
+
+    /* 
+     * Records are appended after the last valid record of the head page, 
+     * unless the rest of the page is not erased (interrupted program); then
+     * the next record starts a new page.
+     */
+    kvs_head_offset = offset;
+    if(!kvs_page_is_erased(kvs_head, offset))
+    {
+        kvs_head_offset = AT45D_PAGE_SIZE;
+    }
+
+    return result;
+}
+
+u8_t kvs_get(u16_t key, void *value, u8_t size)
+{
+    kvs_index_t *entry;
+
+    if(key == KVS_KEY_NONE)
+    {
+        return 0;
+    }
+
+    entry = kvs_index_find(key);
+    if((entry == NULL) || (entry->key != key))
+    {
+        return 0;
+    }
+
+    if(kvs_rec_read(entry->page, entry->offset) == 0)
+    {
+        return 0;
+    }
+    if(size > kvs_buf[2])
+    {
+        size = kvs_buf[2];
+    }
+    memcpy(value, &kvs_buf[KVS_REC_HDR_SIZE], size);
+
+    return kvs_buf[2];
+}
+
+bool_t kvs_set(u16_t key, const void *value, u8_t len)
+{
+    kvs_index_t *entry;
+    u8_t        size = KVS_REC_HDR_SIZE + len;
+
+    if((key == KVS_KEY_NONE) || (len == 0) || (len > KVS_VALUE_SIZE_MAX))
+    {
+        return FALSE;
+    }
+
+    entry = kvs_index_find(key);
+    if(entry == NULL)
+    {
+        return FALSE;
+    }
+
+    // Same value? Then nothing is written
+    if(  (entry->key == key)
+       &&(kvs_rec_read(entry->page, entry->offset) == size)
+       &&(memcmp(&kvs_buf[KVS_REC_HDR_SIZE], value, len) == 0)  )
+    {
+        return TRUE;
+    }
+
+    if(!kvs_make_room(size))
+    {
+        return FALSE;
+    }
+
+    kvs_rec_build(key, KVS_REC_SET, value, len);
+    kvs_rec_append(size);
+
+    // Update index (garbage collection does not move index entries)
+    if(entry->key != key)
+    {
+        entry->key = key;
+        kvs_nr_keys++;
+    }
+    entry->page   = kvs_head;
+    entry->offset = kvs_head_offset - size;
+
+    return TRUE;
+}
+
+bool_t kvs_delete(u16_t key)
+{
+    kvs_index_t *entry;
+    u8_t        size;
+
+    if(key == KVS_KEY_NONE)
+    {
+        return FALSE;
+    }
+
+    entry = kvs_index_find(key);
+    if((entry == NULL) || (entry->key != key))
+    {
+        return FALSE;
+    }
+
+    if(!kvs_make_room(KVS_REC_HDR_SIZE))
+    {
+        return FALSE;
+    }
+
+    size = kvs_rec_build(key, KVS_REC_DELETE, NULL, 0);
+    kvs_rec_append(size);
+    kvs_index_remove(entry);
+
+    return TRUE;
+}
+
+void kvs_sync(void)
+{
+    at45d_flush();
+}
+
+u16_t kvs_nr_of_keys(void)
+{
+    return kvs_nr_keys;
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
@@ -0,0 +1,203 @@
+#ifndef __DFLASH_KVS_H__
+#define __DFLASH_KVS_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Log-structured key-value store on DataFlash
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup DRIVERS
+ *  @defgroup KVS dflash_kvs.h : Log-structured key-value store on DataFlash
+ *
+ *  Stores small values (configuration, calibration) by 16-bit key in a 
+ *  region of @ref AT45D DataFlash pages.
+ *  
+ *  Files: dflash_kvs.h & dflash_kvs.c
+ *  
+ *  @par
+ *  Rewriting a fixed page in place for every update wears out that page 
+ *  and costs a page program per update. Instead, each update (or delete) 
+ *  is appended as a record to the head page of a circular log, so that the
+ *  programs are spread evenly over the region. The records are written with
+ *  at45d_append(), so consecutive updates to the same head page are 
+ *  combined into one page program; call kvs_sync() (at45d_flush()) to make
+ *  them durable. The page is programmed without built-in erase, so if a 
+ *  later program of the same page is interrupted (e.g. by a power 
+ *  failure), only the records that were appended since the last 
+ *  kvs_sync() are lost; records that have been synced are not touched.
+ *  
+ *  @par
+ *  Each page starts with a header with a sequence number and CRC. Each 
+ *  record consists of the key, value length, type, a CRC16-CCITT over the 
+ *  record and the value:
+ *  @code
+ *  Page   : [SEQ (4)] [CRC (2)] [record] [record] ... [0xff ...]
+ *  Record : [KEY (2)] [LEN (1)] [TYPE (1)] [CRC (2)] [VALUE (LEN)]
+ *  @endcode
+ *  kvs_mount() reads the page headers, finds the tail (oldest) and head 
+ *  (newest) page and reads all of the records from tail to head to build 
+ *  a hash table in RAM of the location of the newest record of each key. 
+ *  A lookup therefore costs one DataFlash read. A record with a bad CRC 
+ *  (the remains of an interrupted program) ends the scan of a page. If the
+ *  rest of the head page is not erased, new records are appended to the 
+ *  next page. A page that is added to the log is erased first if needed.
+ *  The scan reads each record separately; with #AT45D_CACHE_PAGES set to 
+ *  1 or more, each page is transferred only once.
+ *  
+ *  @par
+ *  When fewer than 2 pages are free, the tail page is garbage collected:
+ *  records that are still the newest of their key are appended again at 
+ *  the head and the tail page is erased. Pages that are not part of the 
+ *  log are kept erased. At least KVS_PAGES - 2 pages are available for 
+ *  data, so the region must be sized to about double the data to keep the 
+ *  garbage collection cost low.
+ *  
+ *  @par
+ *  The RAM index has 2^#KVS_INDEX_BITS entries of 6 bytes. Lookups use 
+ *  linear probing, so the table should not be more than ~75% full.
+ *  
+ *  Example:
+ *  @include test/dflash_kvs_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "dflash_at45d.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef KVS_PAGE_FIRST
+/// First DataFlash page of region
+#define KVS_PAGE_FIRST      0
+#endif
+
+#ifndef KVS_PAGES
+/// Number of DataFlash pages in region (at least 3)
+#define KVS_PAGES           16
+#endif
+
+#ifndef KVS_INDEX_BITS
+/// Size of RAM index (2^KVS_INDEX_BITS entries); limits number of keys
+#define KVS_INDEX_BITS      6
+#endif
+
+#ifndef KVS_VALUE_SIZE_MAX
+/// Maximum size of a value
+#define KVS_VALUE_SIZE_MAX  32
+#endif
+
+/// Key that may not be used (erased DataFlash)
+#define KVS_KEY_NONE        0xffff
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Erase region and start an empty store.
+ */
+extern void kvs_format(void);
+
+/**
+ * Build RAM index from records in DataFlash.
+ * 
+ * Must be called once after at45d_init() before the store is used. A 
+ * region that has never been formatted is formatted (pages without a 
+ * valid header are erased).
+ * 
+ * @retval TRUE     Store is ready
+ * @retval FALSE    RAM index is too small for the number of keys
+ */
+extern bool_t kvs_mount(void);
+
+/**
+ * Get value of key.
+ * 
+ * @param key       Key (not KVS_KEY_NONE)
+ * @param value     Buffer to receive value
+ * @param size      Size of buffer; a longer value is truncated
+ * 
+ * @return u8_t     Length of value; 0 if key does not exist
+ */
+extern u8_t kvs_get(u16_t key, void *value, u8_t size);
+
+/**
+ * Set value of key.
+ * 
+ * A record is appended to the log, unless the value has not changed.
+ * 
+ * @param key       Key (not KVS_KEY_NONE)
+ * @param value     Value
+ * @param len       Length of value (1 to #KVS_VALUE_SIZE_MAX)
+ * 
+ * @retval TRUE     Value has been set
+ * @retval FALSE    Invalid parameters, RAM index full or store full
+ */
+extern bool_t kvs_set(u16_t key, const void *value, u8_t len);
+
+/**
+ * Delete key.
+ * 
+ * @param key       Key
+ * 
+ * @retval TRUE     Key has been deleted
+ * @retval FALSE    Key does not exist or store is full
+ */
+extern bool_t kvs_delete(u16_t key);
+
+/**
+ * Program appended records into DataFlash (see at45d_flush()).
+ */
+extern void kvs_sync(void);
+
+/**
+ * Get number of keys in store.
+ * 
+ * @return u16_t    Number of keys
+ */
+extern u16_t kvs_nr_of_keys(void);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ * @}
+ */
+#endif
@@ -0,0 +1,610 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Circular data logger on DataFlash
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dflash_log.h"
+#include "crc16_ccitt.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Size of page header: [SEQ (4)] [TIME (4)] [CRC (2)]
+#define DLOG_PAGE_HDR_SIZE  10
+
+/// Size of record header: [LEN (1)] [TIME (4)] [CRC (2)]
+#define DLOG_REC_HDR_SIZE   7
+
+/// Maximum size of a record
+#define DLOG_REC_SIZE_MAX   (DLOG_REC_HDR_SIZE + DLOG_DATA_SIZE_MAX)
+
+/// Length byte that marks the end of the records in a page (erased)
+#define DLOG_END            0xff
+
+/// Number of pages from one index entry to the next
+#define DLOG_INDEX_STEP     (DLOG_PAGES / DLOG_INDEX_SIZE)
+
+/// Value of a page variable if there is no page
+#define DLOG_PAGE_NONE      0xffff
+
+#if (DLOG_PAGES < 3)
+#error "DLOG_PAGES must be at least 3"
+#endif
+
+#if ((DLOG_PAGE_FIRST + DLOG_PAGES) > AT45D_PAGES)
+#error "DLOG region is larger than DataFlash"
+#endif
+
+#if ((DLOG_PAGES % DLOG_INDEX_SIZE) != 0)
+#error "DLOG_PAGES must be a multiple of DLOG_INDEX_SIZE"
+#endif
+
+#if (DLOG_DATA_SIZE_MAX >= DLOG_END) || ((DLOG_PAGE_HDR_SIZE + DLOG_REC_SIZE_MAX) > AT45D_PAGE_SIZE)
+#error "DLOG_DATA_SIZE_MAX is too large"
+#endif
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Oldest and newest page of log (0 to DLOG_PAGES-1)
+static u16_t dlog_tail;
+static u16_t dlog_head;
+
+/// Number of pages in log (0 if empty)
+static u16_t dlog_used;
+
+/// Offset in head page where next record is appended
+static u16_t dlog_head_offset;
+
+/// Sequence number of head page
+static u32_t dlog_head_seq;
+
+/// Timestamp of last record
+static u32_t dlog_last_time;
+
+/// Timestamp of first record of every DLOG_INDEX_STEPth page
+static u32_t dlog_index[DLOG_INDEX_SIZE];
+
+/// Record that is read or appended
+static u8_t  dlog_buf[DLOG_REC_SIZE_MAX];
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// DataFlash address of offset in page of region
+static at45d_adr_t dlog_adr(u16_t page, u16_t offset)
+{
+    return (at45d_adr_t)(DLOG_PAGE_FIRST + page) * AT45D_PAGE_SIZE + offset;
+}
+
+/// Next page of circular log
+static u16_t dlog_next_page(u16_t page)
+{
+    if(++page == DLOG_PAGES)
+    {
+        page = 0;
+    }
+    return page;
+}
+
+/// Page at position in log (0 is the tail)
+static u16_t dlog_page_at(u16_t pos)
+{
+    return (u16_t)(((u32_t)dlog_tail + pos) % DLOG_PAGES);
+}
+
+/// Convert 4 bytes (little endian) to a 32-bit value
+static u32_t dlog_get_u32(const u8_t *data)
+{
+    return   (u32_t)data[0]         | ((u32_t)data[1] << 8)
+           | ((u32_t)data[2] << 16) | ((u32_t)data[3] << 24);
+}
+
+/// Convert a 32-bit value to 4 bytes (little endian)
+static void dlog_put_u32(u8_t *data, u32_t val)
+{
+    data[0] = (u8_t)(val & 0xff);
+    data[1] = (u8_t)(val >> 8);
+    data[2] = (u8_t)(val >> 16);
+    data[3] = (u8_t)(val >> 24);
+}
+
+/// Read page header; returns FALSE if page does not have a valid header
+static bool_t dlog_page_hdr(u16_t page, u32_t *seq, u32_t *time)
+{
+    u8_t  hdr[DLOG_PAGE_HDR_SIZE];
+    u16_t crc;
+
+    at45d_read(hdr, dlog_adr(page, 0), DLOG_PAGE_HDR_SIZE);
+
+    crc = crc16_ccitt_calc_data(CRC16_CCITT_INIT_VAL, hdr, 8);
+    if(crc != (hdr[8] | ((u16_t)hdr[9] << 8)))
+    {
+        return FALSE;
+    }
+    *seq  = dlog_get_u32(&hdr[0]);
+    *time = dlog_get_u32(&hdr[4]);
+
+    // Erased?
+    if(*seq == 0xffffffff)
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/// Timestamp of first record of page at position in log
+static u32_t dlog_pos_time(u16_t pos)
+{
+    u16_t page = dlog_page_at(pos);
+    u32_t seq;
+    u32_t time;
+
+    // Index entry?
+    if((page % DLOG_INDEX_STEP) == 0)
+    {
+        return dlog_index[page / DLOG_INDEX_STEP];
+    }
+
+    if(!dlog_page_hdr(page, &seq, &time))
+    {
+        time = 0;
+    }
+
+    return time;
+}
+
+/// Calculate CRC of record in dlog_buf
+static u16_t dlog_rec_crc(void)
+{
+    u16_t crc;
+
+    crc = crc16_ccitt_calc_data(CRC16_CCITT_INIT_VAL, dlog_buf, 5);
+    crc = crc16_ccitt_calc_data(crc, &dlog_buf[DLOG_REC_HDR_SIZE], dlog_buf[0]);
+
+    return crc;
+}
+
+/**
+ *  Read record at offset in page into dlog_buf. Returns FALSE if there are
+ *  no more valid records in the page (end marker or the remains of an 
+ *  interrupted program).
+ */
+static bool_t dlog_rec_read(u16_t page, u16_t offset)
+{
+    u16_t len = AT45D_PAGE_SIZE - offset;
+
+    // Room for a record?
+    if(len < (DLOG_REC_HDR_SIZE + 1))
+    {
+        return FALSE;
+    }
+    if(len > DLOG_REC_SIZE_MAX)
+    {
+        len = DLOG_REC_SIZE_MAX;
+    }
+
+    // Read header and data with one read
+    at45d_read(dlog_buf, dlog_adr(page, offset), len);
+
+    // End marker (or invalid length)?
+    if(  (dlog_buf[0] == 0) || (dlog_buf[0] > DLOG_DATA_SIZE_MAX) 
+       ||((DLOG_REC_HDR_SIZE + dlog_buf[0]) > len)                )
+    {
+        return FALSE;
+    }
+
+    // Valid record?
+    if(dlog_rec_crc() != (dlog_buf[5] | ((u16_t)dlog_buf[6] << 8)))
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/// Check that page is erased from offset up to end of page
+static bool_t dlog_page_is_erased(u16_t page, u16_t offset)
+{
+    u8_t  data[16];
+    u16_t len;
+    u8_t  i;
+
+    while(offset < AT45D_PAGE_SIZE)
+    {
+        len = AT45D_PAGE_SIZE - offset;
+        if(len > sizeof(data))
+        {
+            len = sizeof(data);
+        }
+        at45d_read(data, dlog_adr(page, offset), len);
+        for(i=0; i<len; i++)
+        {
+            if(data[i] != 0xff)
+            {
+                return FALSE;
+            }
+        }
+        offset += len;
+    }
+
+    return TRUE;
+}
+
+/// Start a new head page (the oldest page is overwritten if the log is full)
+static void dlog_page_start(u32_t time)
+{
+    u8_t  hdr[DLOG_PAGE_HDR_SIZE];
+    u16_t crc;
+
+    dlog_head = dlog_next_page(dlog_head);
+
+    // Records are appended without erase (oldest page is overwritten)
+    if(!dlog_page_is_erased(dlog_head, 0))
+    {
+        at45d_erase_page(DLOG_PAGE_FIRST + dlog_head);
+    }
+
+    if((dlog_used != 0) && (dlog_head == dlog_tail))
+    {
+        dlog_tail = dlog_next_page(dlog_tail);
+    }
+    else
+    {
+        dlog_used++;
+    }
+
+    dlog_head_seq++;
+    dlog_put_u32(&hdr[0], dlog_head_seq);
+    dlog_put_u32(&hdr[4], time);
+    crc    = crc16_ccitt_calc_data(CRC16_CCITT_INIT_VAL, hdr, 8);
+    hdr[8] = (u8_t)(crc & 0xff);
+    hdr[9] = (u8_t)(crc >> 8);
+    at45d_append(hdr, dlog_adr(dlog_head, 0), DLOG_PAGE_HDR_SIZE);
+
+    dlog_head_offset = DLOG_PAGE_HDR_SIZE;
+
+    // Update index
+    if((dlog_head % DLOG_INDEX_STEP) == 0)
+    {
+        dlog_index[dlog_head / DLOG_INDEX_STEP] = time;
+    }
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void dlog_init(void)
+{
+    u16_t lo;
+    u16_t hi;
+    u16_t mid;
+    u16_t page;
+    u16_t i;
+    u32_t seq0;
+    u32_t seq;
+    u32_t time;
+
+    // Empty log; first page is page 0
+    dlog_used        = 0;
+    dlog_tail        = 0;
+    dlog_head        = DLOG_PAGES - 1;
+    dlog_head_offset = AT45D_PAGE_SIZE;
+    dlog_head_seq    = 0;
+    dlog_last_time   = 0;
+
+    // Find head page
+    if(dlog_page_hdr(0, &seq0, &time))
+    {
+        /* 
+         * Binary search for last page of current lap: page i has the 
+         * sequence number of page 0 plus i. Pages after it have a sequence
+         * number of the previous lap or are erased.
+         */
+        lo = 0;
+        hi = DLOG_PAGES - 1;
+        while(lo != hi)
+        {
+            mid = lo + (hi - lo + 1) / 2;
+            if(dlog_page_hdr(mid, &seq, &time) && (seq == (seq0 + mid)))
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        dlog_head = lo;
+    }
+    else if(dlog_page_hdr(DLOG_PAGES - 1, &seq, &time))
+    {
+        // Page 0 was not programmed when the log wrapped
+        dlog_head = DLOG_PAGES - 1;
+    }
+    else
+    {
+        // Empty
+        return;
+    }
+    dlog_page_hdr(dlog_head, &dlog_head_seq, &dlog_last_time);
+
+    /*
+     * Tail is the page after the head if it is from the previous lap. The
+     * page after the head may have been corrupted by a power failure; 
+     * otherwise the log has not wrapped yet.
+     */
+    page = dlog_next_page(dlog_head);
+    if(!(dlog_page_hdr(page, &seq, &time) && (seq < dlog_head_seq)))
+    {
+        page = dlog_next_page(page);
+        if(!(dlog_page_hdr(page, &seq, &time) && (seq < dlog_head_seq)))
+        {
+            page = 0;
+        }
+    }
+    dlog_tail = page;
+    dlog_used = (u16_t)((dlog_head + DLOG_PAGES - dlog_tail) % DLOG_PAGES) + 1;
+
+    // Find end of records in head page
+    dlog_head_offset = DLOG_PAGE_HDR_SIZE;
+    while(dlog_rec_read(dlog_head, dlog_head_offset))
+    {
+        dlog_last_time    = dlog_get_u32(&dlog_buf[1]);
+        dlog_head_offset += DLOG_REC_HDR_SIZE + dlog_buf[0];
+    }
+
+    // Rest of head page not erased (interrupted program)? Start new page
+    if(!dlog_page_is_erased(dlog_head, dlog_head_offset))
+    {
+        dlog_head_offset = AT45D_PAGE_SIZE;
+    }
+
+    // Build sparse index
+    for(i=0; i<DLOG_INDEX_SIZE; i++)
+    {
+        if(!dlog_page_hdr(i * DLOG_INDEX_STEP, &seq, &dlog_index[i]))
+        {
+            dlog_index[i] = 0;
+        }
+    }
+}
+
+void dlog_erase(void)
+{
+    u16_t page;
+
+    for(page=0; page<DLOG_PAGES; page++)
+    {
+        at45d_erase_page(DLOG_PAGE_FIRST + page);
+    }
+
+    dlog_init();
+}
+
+bool_t dlog_append(u32_t time, const void *data, u8_t len)
+{
+    const u8_t *src  = (const u8_t *)data;
+    u8_t       size  = DLOG_REC_HDR_SIZE + len;
+    u8_t       i;
+    u16_t      crc;
+
+    if((len == 0) || (len > DLOG_DATA_SIZE_MAX))
+    {
+        return FALSE;
+    }
+    if((dlog_used != 0) && (time < dlog_last_time))
+    {
+        return FALSE;
+    }
+
+    // Start new page if record does not fit
+    if((dlog_head_offset + size) > AT45D_PAGE_SIZE)
+    {
+        dlog_page_start(time);
+    }
+
+    // Build record
+    dlog_buf[0] = len;
+    dlog_put_u32(&dlog_buf[1], time);
+    for(i=0; i<len; i++)
+    {
+        dlog_buf[DLOG_REC_HDR_SIZE + i] = src[i];
+    }
+    crc = dlog_rec_crc();
+    dlog_buf[5] = (u8_t)crc;
+    dlog_buf[6] = (u8_t)(crc >> 8);
+
+    // Program without erase; erased bytes after record mark the end
+    at45d_append(dlog_buf, dlog_adr(dlog_head, dlog_head_offset), size);
+
+    dlog_head_offset += size;
+    dlog_last_time    = time;
+
+    return TRUE;
+}
+
+void dlog_sync(void)
+{
+    at45d_flush();
+}
+
+void dlog_query(dlog_query_t *query, u32_t time_start, u32_t time_end)
+{
+    u16_t lo;
+    u16_t hi;
+    u16_t mid;
+    u16_t first;
+    u16_t n;
+    u16_t i;
+
+    query->page       = DLOG_PAGE_NONE;
+    query->offset     = DLOG_PAGE_HDR_SIZE;
+    query->time_start = time_start;
+    query->time_end   = time_end;
+
+    if(dlog_used == 0)
+    {
+        return;
+    }
+
+    /*
+     * Find last page (position in log) of which the first record is before
+     * T1. Records from T1 start in this page or later. The tail is used if 
+     * there is no such page.
+     */
+    lo = 0;
+    hi = dlog_used - 1;
+
+    // Binary search of index (positions first, first + STEP, ...)
+    first = (DLOG_INDEX_STEP - (dlog_tail % DLOG_INDEX_STEP)) % DLOG_INDEX_STEP;
+    if(first < dlog_used)
+    {
+        if(dlog_pos_time(first) < time_start)
+        {
+            // Find last index entry before T1
+            i = 0;
+            n = (dlog_used - 1 - first) / DLOG_INDEX_STEP;
+            while(i != n)
+            {
+                mid = i + (n - i + 1) / 2;
+                if(dlog_pos_time(first + mid * DLOG_INDEX_STEP) < time_start)
+                {
+                    i = mid;
+                }
+                else
+                {
+                    n = mid - 1;
+                }
+            }
+            lo = first + i * DLOG_INDEX_STEP;
+            if((u32_t)lo + DLOG_INDEX_STEP < dlog_used)
+            {
+                hi = lo + DLOG_INDEX_STEP - 1;
+            }
+        }
+        else if(first != 0)
+        {
+            hi = first - 1;
+        }
+        else
+        {
+            hi = 0;
+        }
+    }
+
+    // Binary search of page headers between index entries
+    while(lo != hi)
+    {
+        mid = lo + (hi - lo + 1) / 2;
+        if(dlog_pos_time(mid) < time_start)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+
+    query->page = dlog_page_at(lo);
+}
+
+u8_t dlog_read_next(dlog_query_t *query, 
+                    u32_t        *time,
+                    void         *data,
+                    u8_t         size)
+{
+    u8_t  len;
+    u8_t  i;
+
+    while(query->page != DLOG_PAGE_NONE)
+    {
+        if(!dlog_rec_read(query->page, query->offset))
+        {
+            // End of log?
+            if(query->page == dlog_head)
+            {
+                query->page = DLOG_PAGE_NONE;
+                break;
+            }
+            // Next page
+            query->page   = dlog_next_page(query->page);
+            query->offset = DLOG_PAGE_HDR_SIZE;
+            continue;
+        }
+
+        len            = dlog_buf[0];
+        *time          = dlog_get_u32(&dlog_buf[1]);
+        query->offset += DLOG_REC_HDR_SIZE + len;
+
+        // Before T1?
+        if(*time < query->time_start)
+        {
+            continue;
+        }
+        // After T2?
+        if(*time > query->time_end)
+        {
+            query->page = DLOG_PAGE_NONE;
+            break;
+        }
+
+        if(size > len)
+        {
+            size = len;
+        }
+        for(i=0; i<size; i++)
+        {
+            ((u8_t *)data)[i] = dlog_buf[DLOG_REC_HDR_SIZE + i];
+        }
+
+        return len;
+    }
+
+    return 0;
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
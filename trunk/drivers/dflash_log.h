@@ -0,0 +1,213 @@
+#ifndef __DFLASH_LOG_H__
+#define __DFLASH_LOG_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Circular data logger on DataFlash
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup DRIVERS
+ *  @defgroup DLOG dflash_log.h : Circular data logger on DataFlash
+ *
+ *  Appends timestamped records (e.g. sensor or GPS records) to a circular 
+ *  region of @ref AT45D DataFlash pages and finds the records between two
+ *  timestamps without scanning the whole region.
+ *  
+ *  Files: dflash_log.h & dflash_log.c
+ *  
+ *  @par Format
+ *  Records of 1 to #DLOG_DATA_SIZE_MAX bytes are packed into pages; a 
+ *  record does not cross a page boundary. Each page starts with a header
+ *  with a sequence number that increments with every page, the timestamp 
+ *  of the first record and a CRC16-CCITT over the header:
+ *  @code
+ *  Page   : [SEQ (4)] [TIME (4)] [CRC (2)] [record] [record] ... [0xff]
+ *  Record : [LEN (1)] [TIME (4)] [CRC (2)] [DATA (LEN)]
+ *  @endcode
+ *  A page is erased when it is started and the records are then written 
+ *  with at45d_append(), so consecutive records are combined into one page 
+ *  program without erase. The erased bytes (0xff) after the last record 
+ *  mark the end. The CRC16-CCITT of a record covers LEN, TIME and DATA. 
+ *  When the last page is full, the log wraps and the oldest page is 
+ *  overwritten. Timestamps must not decrease; the unit is chosen by the 
+ *  application (e.g. seconds).
+ *  
+ *  @par Recovery
+ *  Because the sequence number increments by one per page, page i of the 
+ *  current lap has the sequence number of page 0 plus i, while pages 
+ *  after the head still have a sequence number of the previous lap (or are
+ *  erased). dlog_init() therefore finds the head page with a binary search
+ *  over the page headers (11 header reads for 2048 pages) instead of a 
+ *  linear scan, and then scans the records of only the head page. A page 
+ *  that was corrupted by a power failure while it was being started is 
+ *  skipped. 
+ *  
+ *  A program without erase can only clear bits, so a power failure during
+ *  a program can only corrupt the bytes being appended; the records synced 
+ *  before it stay intact. Only the records appended since the last 
+ *  dlog_sync() can be lost. The remains of an interrupted program fail the
+ *  record CRC and end the records of the page; dlog_init() starts a new 
+ *  page if the rest of the head page is not erased.
+ *  
+ *  @par Timestamp index
+ *  dlog_init() also reads the header of every (#DLOG_PAGES / 
+ *  #DLOG_INDEX_SIZE)th page into a sparse index in RAM, which is updated as
+ *  pages are written. dlog_query() does a binary search of the index (no
+ *  DataFlash reads) followed by a binary search of the page headers between
+ *  two index entries to find the page that contains the first record at or
+ *  after T1. dlog_read_next() then returns the records up to T2:
+ *  @code
+ *  dlog_query_t q;
+ *  u32_t        time;
+ *  u8_t         data[DLOG_DATA_SIZE_MAX];
+ *  u8_t         len;
+ *  
+ *  dlog_query(&q, t1, t2);
+ *  while((len = dlog_read_next(&q, &time, data, sizeof(data))) != 0)
+ *  {
+ *      ...
+ *  }
+ *  @endcode
+ *  
+ *  Example:
+ *  @include test/dflash_log_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "dflash_at45d.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef DLOG_PAGE_FIRST
+/// First DataFlash page of region
+#define DLOG_PAGE_FIRST     0
+#endif
+
+#ifndef DLOG_PAGES
+/// Number of DataFlash pages in region (at least 3)
+#define DLOG_PAGES          (AT45D_PAGES - DLOG_PAGE_FIRST)
+#endif
+
+#ifndef DLOG_INDEX_SIZE
+/// Number of entries in sparse timestamp index (DLOG_PAGES must be a multiple)
+#define DLOG_INDEX_SIZE     32
+#endif
+
+#ifndef DLOG_DATA_SIZE_MAX
+/// Maximum size of the data of a record
+#define DLOG_DATA_SIZE_MAX  32
+#endif
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Position of a query (see dlog_query())
+typedef struct
+{
+    u16_t page;         ///< Page of next record; 0xffff if query is finished
+    u16_t offset;       ///< Offset of next record in page
+    u32_t time_start;   ///< Records before this time are skipped (T1)
+    u32_t time_end;     ///< Records after this time end the query (T2)
+} dlog_query_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Find head of log and build timestamp index.
+ * 
+ * Must be called once after at45d_init(). A region that does not contain a
+ * log yet is used from the first page.
+ */
+extern void dlog_init(void);
+
+/**
+ * Erase region and start an empty log.
+ */
+extern void dlog_erase(void);
+
+/**
+ * Append a record to the log.
+ * 
+ * @param time      Timestamp (not less than timestamp of previous record)
+ * @param data      Data of record
+ * @param len       Length of data (1 to #DLOG_DATA_SIZE_MAX)
+ * 
+ * @retval TRUE     Record has been appended
+ * @retval FALSE    Invalid length or timestamp
+ */
+extern bool_t dlog_append(u32_t time, const void *data, u8_t len);
+
+/**
+ * Program appended records into DataFlash (see at45d_flush()).
+ * 
+ * The records appended before this call survive a power failure.
+ */
+extern void dlog_sync(void);
+
+/**
+ * Start a query for the records from T1 to T2 (inclusive).
+ * 
+ * @param query     Query object that is initialised
+ * @param time_start  First timestamp (T1)
+ * @param time_end    Last timestamp (T2)
+ */
+extern void dlog_query(dlog_query_t *query, u32_t time_start, u32_t time_end);
+
+/**
+ * Read next record of a query.
+ * 
+ * @param query     Query object (see dlog_query())
+ * @param time      Timestamp of record
+ * @param data      Buffer to receive data of record
+ * @param size      Size of buffer; longer data is truncated
+ * 
+ * @return u8_t     Length of data; 0 if there are no more records
+ */
+extern u8_t dlog_read_next(dlog_query_t *query, 
+                           u32_t        *time,
+                           void         *data,
+                           u8_t         size);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ * @}
+ */
+#endif
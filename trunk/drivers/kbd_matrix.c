@@ -80,6 +80,7 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "kbd_matrix.h"
+#include "prof.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 
@@ -555,11 +556,15 @@ void kbd_matrix_init(kbd_matrix_t               *matrix,
 
 void kbd_matrix_scan(kbd_matrix_t *matrix)
 {
+    PROF_BEGIN(PROF_ID_KBD_SCAN);
+
     kbd_matrix_sample(matrix);
 
     kbd_matrix_debounce(matrix);
 
     kbd_matrix_repeat(matrix);
+
+    PROF_END(PROF_ID_KBD_SCAN);
 }
 
 /* _____LOG__________________________________________________________________ */
@@ -567,5 +572,8 @@ void kbd_matrix_scan(kbd_matrix_t *matrix)
 
  2008/11/21 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added profiler markers (PROF)
    
 */
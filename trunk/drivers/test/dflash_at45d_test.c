@@ -0,0 +1,647 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          dflash_at45d.h host simulator test
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Runs the driver against a simulated DataFlash on a PC. The simulator 
+ * decodes the 24-bit address as specified in the datasheet for each page 
+ * size and reports commands that are sent while the device is busy.
+ * 
+ * Build and run for each device and page size (from the "trunk/drivers" 
+ * directory), with a host "board.h" (may be empty) and a host "spi1.h" that
+ * declares spi1_tx_byte(), spi1_rx_byte(), spi1_tx_data() and spi1_rx_data()
+ * and defines board_flash_cs_lo() and board_flash_cs_hi() as 
+ * at45d_sim_cs_lo() and at45d_sim_cs_hi():
+ *   for dev in AT45DB011D AT45DB021D AT45DB041D AT45DB081D \
+ *              AT45DB161D AT45DB321D AT45DB642D; do
+ *     for pwr2 in 0 1; do
+ *       gcc -O2 -I. -I../general -I<host dir> -D$dev \
+ *           -DAT45D_POWER_OF_TWO_PAGE_SIZE=$pwr2 -DAT45D_ASYNC=1 \
+ *           test/dflash_at45d_test.c dflash_at45d.c -o at45d_test
+ *       ./at45d_test || echo "$dev $pwr2 FAILED"
+ *     done
+ *   done
+ * 
+ * Add -DAT45D_CACHE_PAGES=1 (up to 8) to test the page cache. The number of 
+ * SPI bytes per read of a small field is reported to compare cache sizes.
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dflash_at45d.h"
+#include "spi1.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Number of SPI byte transfers that a page program or erase takes
+#define SIM_PROG_TIME       (2*AT45D_PAGE_SIZE)
+
+/// Number of SPI byte transfers that a page to buffer transfer takes
+#define SIM_LOAD_TIME       (AT45D_PAGE_SIZE/8)
+
+/// Number of address bits of the byte in a page (see datasheets)
+#if   (AT45D_PAGE_SIZE == 256)
+#define SIM_BYTE_BITS       8
+#elif (AT45D_PAGE_SIZE == 264) || (AT45D_PAGE_SIZE == 512)
+#define SIM_BYTE_BITS       9
+#elif (AT45D_PAGE_SIZE == 528) || (AT45D_PAGE_SIZE == 1024)
+#define SIM_BYTE_BITS       10
+#elif (AT45D_PAGE_SIZE == 1056)
+#define SIM_BYTE_BITS       11
+#endif
+
+/// Test pattern of a byte in a page
+#define PATTERN(page, byte) ((u8_t)((page) * 7 + (byte)))
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Main memory and SRAM buffers
+static u8_t  sim_mem[AT45D_PAGES][AT45D_PAGE_SIZE];
+static u8_t  sim_buf[2][AT45D_PAGE_SIZE];
+
+/// Time in SPI byte transfers and end of page program or erase
+static u32_t sim_time;
+static u32_t sim_busy_until;
+
+/// Buffer (0 or 1) that is being programmed; -1 if none
+static int   sim_busy_buf = -1;
+
+/// Command being received
+static u8_t  sim_cmd[4];
+static u32_t sim_cmd_len;
+static u16_t sim_page;
+static u16_t sim_byte;
+
+/// Number of page programs and erases
+static u32_t sim_prog_count;
+
+/// Number of page programs without built-in erase
+static u32_t sim_prog_no_erase_count;
+
+static int   sim_errors;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static bool_t sim_busy(void)
+{
+    return (sim_time < sim_busy_until);
+}
+
+static void sim_error(const char *msg)
+{
+    printf("Error: %s (command 0x%02X)\n", msg, sim_cmd[0]);
+    sim_errors++;
+}
+
+/// Decode address bytes
+static void sim_decode_address(void)
+{
+    u32_t adr = ((u32_t)sim_cmd[1] << 16) | ((u32_t)sim_cmd[2] << 8) | sim_cmd[3];
+
+    sim_page = (u16_t)(adr >> SIM_BYTE_BITS);
+    sim_byte = (u16_t)(adr & ((1ul << SIM_BYTE_BITS) - 1));
+    if(sim_page >= AT45D_PAGES)
+    {
+        sim_error("page out of range");
+        sim_page = 0;
+    }
+    if(sim_byte >= AT45D_PAGE_SIZE)
+    {
+        sim_error("byte out of range");
+        sim_byte = 0;
+    }
+    // Check access to buffer while it is being programmed
+    if(sim_busy())
+    {
+        switch(sim_cmd[0])
+        {
+        case 0x84:
+        case 0xD4:
+            if(sim_busy_buf != 0) return;
+            break;
+        case 0x87:
+        case 0xD6:
+            if(sim_busy_buf != 1) return;
+            break;
+        default:
+            break;
+        }
+        sim_error("command while busy");
+    }
+}
+
+/// Start page program or erase
+static void sim_program(int buf)
+{
+    if(buf >= 0)
+    {
+        memcpy(sim_mem[sim_page], sim_buf[buf], AT45D_PAGE_SIZE);
+    }
+    else
+    {
+        memset(sim_mem[sim_page], 0xff, AT45D_PAGE_SIZE);
+    }
+    sim_busy_until = sim_time + SIM_PROG_TIME;
+    sim_busy_buf   = buf;
+    sim_prog_count++;
+}
+
+/// Start page program without built-in erase (bits can only be cleared)
+static void sim_program_no_erase(int buf)
+{
+    u16_t i;
+
+    for(i=0; i<AT45D_PAGE_SIZE; i++)
+    {
+        if((sim_buf[buf][i] & ~sim_mem[sim_page][i]) != 0)
+        {
+            sim_error("program without erase of byte that is not erased");
+            break;
+        }
+    }
+    for(i=0; i<AT45D_PAGE_SIZE; i++)
+    {
+        sim_mem[sim_page][i] &= sim_buf[buf][i];
+    }
+    sim_busy_until = sim_time + SIM_PROG_TIME;
+    sim_busy_buf   = buf;
+    sim_prog_count++;
+    sim_prog_no_erase_count++;
+}
+
+/// Start main memory page to buffer transfer
+static void sim_load(int buf)
+{
+    memcpy(sim_buf[buf], sim_mem[sim_page], AT45D_PAGE_SIZE);
+    sim_busy_until = sim_time + SIM_LOAD_TIME;
+    sim_busy_buf   = buf;
+}
+
+/// Advance byte index in page (wraps to start of page)
+static void sim_next_byte(void)
+{
+    if(++sim_byte == AT45D_PAGE_SIZE)
+    {
+        sim_byte = 0;
+    }
+}
+
+/// Test at45d_read() at each page boundary
+static void test_read(void)
+{
+    static u8_t  data[AT45D_PAGE_SIZE + 2];
+    u16_t        page;
+    u16_t        i;
+    at45d_adr_t  adr;
+
+    for(page=0; page<AT45D_PAGES; page++)
+    {
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            sim_mem[page][i] = PATTERN(page, i);
+        }
+    }
+    for(page=1; page<AT45D_PAGES; page++)
+    {
+        // Read last byte of previous page, whole page and first byte of next
+        adr = (at45d_adr_t)page * AT45D_PAGE_SIZE - 1;
+        if(at45d_read(data, adr, sizeof(data)) != sizeof(data))
+        {
+            // Last page; clipped
+            if(page != (AT45D_PAGES-1))
+            {
+                sim_error("at45d_read() clipped");
+            }
+        }
+        if(data[0] != PATTERN(page-1, AT45D_PAGE_SIZE-1))
+        {
+            sim_error("at45d_read() previous page");
+        }
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            if(data[i+1] != PATTERN(page, i))
+            {
+                sim_error("at45d_read() page");
+                break;
+            }
+        }
+        if((page != (AT45D_PAGES-1)) && (data[AT45D_PAGE_SIZE+1] != PATTERN(page+1, 0)))
+        {
+            sim_error("at45d_read() next page");
+        }
+    }
+}
+
+/// Test writes and reads of pages
+static void test_write(void)
+{
+    static u8_t data[AT45D_PAGE_SIZE];
+    static u16_t pages[] = {0, 1, AT45D_PAGES/2 + 3, AT45D_PAGES-1};
+    u8_t        j;
+    u16_t       i;
+#if AT45D_ASYNC
+    at45d_req_t req;
+#endif
+
+    for(j=0; j<sizeof(pages)/sizeof(pages[0]); j++)
+    {
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            data[i] = (u8_t)(i ^ j ^ 0x5a);
+        }
+        switch(j)
+        {
+        case 0:
+            at45d_write_page(data, pages[j]);
+            break;
+        case 1:
+            at45d_write_page_seq(data, pages[j]);
+            break;
+#if AT45D_ASYNC
+        case 2:
+            at45d_write_page_async(&req, data, pages[j], NULL);
+            while(at45d_busy())
+            {
+                at45d_service();
+            }
+            break;
+#endif
+        default:
+            at45d_write_page_offset(data, pages[j], 0, AT45D_PAGE_SIZE);
+            break;
+        }
+        memset(data, 0, sizeof(data));
+        at45d_read_page(data, pages[j]);
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            if(data[i] != (u8_t)(i ^ j ^ 0x5a))
+            {
+                sim_error("write/read page");
+                break;
+            }
+        }
+        at45d_read_page_offset(data, pages[j], AT45D_PAGE_SIZE-1, 1);
+        if(data[0] != (u8_t)((AT45D_PAGE_SIZE-1) ^ j ^ 0x5a))
+        {
+            sim_error("read page offset");
+        }
+    }
+
+    at45d_erase_page(AT45D_PAGES-1);
+    at45d_read_page(data, AT45D_PAGES-1);
+    if((data[0] != 0xff) || (data[AT45D_PAGE_SIZE-1] != 0xff))
+    {
+        sim_error("erase");
+    }
+}
+
+/// Test at45d_write() across page boundaries and coalescing of small writes
+static void test_write_rmw(void)
+{
+    static u8_t data[AT45D_PAGE_SIZE + 2];
+    u16_t       page = AT45D_PAGES/4;
+    at45d_adr_t adr  = (at45d_adr_t)page * AT45D_PAGE_SIZE;
+    u32_t       prog_count;
+    u16_t       i;
+    u8_t        j;
+
+    for(j=0; j<3; j++)
+    {
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            data[i] = PATTERN(page+j, i);
+        }
+        at45d_write_page(data, page+j);
+    }
+
+    // Write that straddles page boundary; rest of pages must be preserved
+    memset(data, 0xa5, 10);
+    if(at45d_write(data, adr + AT45D_PAGE_SIZE - 5, 10) != 10)
+    {
+        sim_error("at45d_write() length");
+    }
+    at45d_read(data, adr, sizeof(data));
+    for(i=0; i<sizeof(data); i++)
+    {
+        if((i >= (AT45D_PAGE_SIZE - 5)) && (i < (AT45D_PAGE_SIZE + 5)))
+        {
+            j = 0xa5;
+        }
+        else if(i < AT45D_PAGE_SIZE)
+        {
+            j = PATTERN(page, i);
+        }
+        else
+        {
+            j = PATTERN(page+1, i - AT45D_PAGE_SIZE);
+        }
+        if(data[i] != j)
+        {
+            sim_error("at45d_write() across page boundary");
+            break;
+        }
+    }
+
+    // Append single bytes to a page; must cost one page program
+    adr += 2 * AT45D_PAGE_SIZE;
+    at45d_flush();
+    prog_count = sim_prog_count;
+    for(i=0; i<100; i++)
+    {
+        j = (u8_t)i;
+        at45d_write(&j, adr + 10 + i, 1);
+    }
+    at45d_flush();
+    at45d_flush();
+    if(sim_prog_count != (prog_count + 1))
+    {
+        sim_error("at45d_write() not coalesced");
+    }
+    at45d_read(data, adr, AT45D_PAGE_SIZE);
+    for(i=0; i<AT45D_PAGE_SIZE; i++)
+    {
+        if((i >= 10) && (i < 110))
+        {
+            j = (u8_t)(i - 10);
+        }
+        else
+        {
+            j = PATTERN(page+2, i);
+        }
+        if(data[i] != j)
+        {
+            sim_error("at45d_write() coalesced data");
+            break;
+        }
+    }
+
+    // Changes must be programmed before another function uses buffer 1
+    j = 0x3c;
+    at45d_write(&j, adr, 1);
+    at45d_erase_page(page);
+    at45d_read_page(data, page+2);
+    if(data[0] != 0x3c)
+    {
+        sim_error("at45d_write() not flushed");
+    }
+
+    // Append records to an erased page (programmed without erase)
+    at45d_erase_page(page);
+    prog_count = sim_prog_no_erase_count;
+    for(i=0; i<100; i++)
+    {
+        j = (u8_t)(i ^ 0x55);
+        at45d_append(&j, (at45d_adr_t)page * AT45D_PAGE_SIZE + i, 1);
+        if((i % 10) == 9)
+        {
+            at45d_flush();
+        }
+    }
+    at45d_read_page(data, page);
+    for(i=0; i<AT45D_PAGE_SIZE; i++)
+    {
+        j = (i < 100) ? (u8_t)(i ^ 0x55) : 0xff;
+        if(data[i] != j)
+        {
+            sim_error("at45d_append() data");
+            break;
+        }
+    }
+    if(sim_prog_no_erase_count != (prog_count + 10))
+    {
+        sim_error("at45d_append() not programmed without erase");
+    }
+
+#if AT45D_CACHE_PAGES
+    // A page write must not write back other changed pages in the cache
+    at45d_flush();
+    j = 0x5a;
+    at45d_write(&j, adr, 1);
+    prog_count = sim_prog_count;
+    at45d_write_page(data, page+1);
+    at45d_erase_page(page);
+    if(sim_prog_count != (prog_count + 2))
+    {
+        sim_error("cache written back by page write");
+    }
+    at45d_flush();
+#endif
+}
+
+/// Measure SPI bytes per read of small fields spread over a number of pages
+static void bench_read(u16_t nr_of_pages)
+{
+    u8_t  data[4];
+    u16_t page;
+    u16_t i;
+    u32_t seed = 1;
+    u32_t time = sim_time;
+
+    for(i=0; i<10000; i++)
+    {
+        // Pages of configuration and lookup tables; first one is hot
+        seed = seed * 1103515245ul + 12345;
+        page = AT45D_PAGES/8 + (u16_t)((seed >> 16) % (2 * nr_of_pages));
+        if(page >= (AT45D_PAGES/8 + nr_of_pages))
+        {
+            page = AT45D_PAGES/8;
+        }
+        at45d_read(data, 
+                   (at45d_adr_t)page * AT45D_PAGE_SIZE + (seed >> 8) % (AT45D_PAGE_SIZE - 4),
+                   sizeof(data));
+    }
+
+    time = (sim_time - time) / 100;
+    printf("%u cached pages: %lu.%02lu SPI bytes per read of %u bytes from %u pages\n",
+           (unsigned)AT45D_CACHE_PAGES, 
+           (unsigned long)time / 100, 
+           (unsigned long)time % 100,
+           (unsigned)sizeof(data),
+           (unsigned)nr_of_pages);
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void at45d_sim_cs_lo(void)
+{
+    sim_cmd_len = 0;
+}
+
+void at45d_sim_cs_hi(void)
+{
+    if(sim_cmd_len < 4)
+    {
+        return;
+    }
+    switch(sim_cmd[0])
+    {
+    case 0x82:
+    case 0x83:
+        sim_program(0);
+        break;
+    case 0x85:
+    case 0x86:
+        sim_program(1);
+        break;
+    case 0x88:
+        sim_program_no_erase(0);
+        break;
+    case 0x89:
+        sim_program_no_erase(1);
+        break;
+    case 0x81:
+        sim_program(-1);
+        break;
+    case 0x53:
+        sim_load(0);
+        break;
+    case 0x55:
+        sim_load(1);
+        break;
+    default:
+        break;
+    }
+}
+
+void spi1_tx_byte(u8_t data)
+{
+    sim_time++;
+
+    if(sim_cmd_len < 4)
+    {
+        sim_cmd[sim_cmd_len++] = data;
+        if(sim_cmd_len == 4)
+        {
+            sim_decode_address();
+        }
+        return;
+    }
+    sim_cmd_len++;
+
+    // Data for buffer
+    switch(sim_cmd[0])
+    {
+    case 0x82:
+    case 0x84:
+        sim_buf[0][sim_byte] = data;
+        sim_next_byte();
+        break;
+    case 0x85:
+    case 0x87:
+        sim_buf[1][sim_byte] = data;
+        sim_next_byte();
+        break;
+    default:
+        // Don't care bytes of read commands
+        break;
+    }
+}
+
+u8_t spi1_rx_byte(void)
+{
+    u8_t data;
+
+    sim_time++;
+
+    switch(sim_cmd[0])
+    {
+    case 0xD7:
+        // Status: ready flag, density and page size flag
+        return   (sim_busy() ? 0x00 : 0x80) 
+               | (AT45D_POWER_OF_TWO_PAGE_SIZE ? 0x01 : 0x00);
+    case 0xD2:
+        data = sim_mem[sim_page][sim_byte];
+        sim_next_byte();
+        return data;
+    case 0xD4:
+    case 0xD6:
+        data = sim_buf[(sim_cmd[0] == 0xD4) ? 0 : 1][sim_byte];
+        sim_next_byte();
+        return data;
+    case 0xE8:
+        // Continuous read crosses into next page
+        data = sim_mem[sim_page][sim_byte];
+        if(++sim_byte == AT45D_PAGE_SIZE)
+        {
+            sim_byte = 0;
+            if(++sim_page == AT45D_PAGES)
+            {
+                sim_page = 0;
+            }
+        }
+        return data;
+    default:
+        sim_error("unexpected read");
+        return 0;
+    }
+}
+
+void spi1_tx_data(const void *data, size_t length)
+{
+    const u8_t *p = (const u8_t *)data;
+
+    while(length--)
+    {
+        spi1_tx_byte(*p++);
+    }
+}
+
+void spi1_rx_data(void *data, size_t length)
+{
+    u8_t *p = (u8_t *)data;
+
+    while(length--)
+    {
+        *p++ = spi1_rx_byte();
+    }
+}
+
+int main(void)
+{
+    at45d_init();
+
+    test_read();
+    test_write();
+    test_write_rmw();
+    bench_read(4);
+    bench_read(64);
+
+    printf("%lu pages of %u bytes: %d errors\n", 
+           (unsigned long)AT45D_PAGES, (unsigned)AT45D_PAGE_SIZE, sim_errors);
+
+    return (sim_errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,466 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          dflash_kvs.h benchmark on a file-backed DataFlash simulator
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Stores 10000 keys, updates and deletes keys until the log has wrapped a 
+ * few times, simulates a power failure and then measures the mount time 
+ * and lookup cost. The DataFlash is simulated with a file ("kvs_test.bin"). 
+ * The simulator keeps changes of one page in a RAM "SRAM buffer" until 
+ * at45d_flush() or a write to another page, like at45d_append(). A power 
+ * failure interrupts the program of the page in the buffer: bytes that are
+ * being programmed are corrupted (and the whole page if it would have been
+ * programmed with erase). More power failures follow with kvs_sync() 
+ * between updates to check that synced updates are never lost.
+ * 
+ * Build on a PC (from the "trunk/drivers" directory), with a host "board.h"
+ * (may be empty):
+ *   gcc -O2 -I. -I../general -I../protocol -I<host dir> -DAT45DB161D \
+ *       -DAT45D_POWER_OF_TWO_PAGE_SIZE=0 -DKVS_PAGES=1024 -DKVS_INDEX_BITS=14 \
+ *       test/dflash_kvs_test.c dflash_kvs.c ../protocol/crc16_ccitt.c \
+ *       -o kvs_test
+ * 
+ * SPI bytes are counted as the driver would transfer them (command, 
+ * address and dont-care bytes included), e.g. at a 8 MHz SPI clock one 
+ * byte takes 1 us.
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dflash_kvs.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#define NR_OF_KEYS      10000
+#define NR_OF_UPDATES   100000ul
+#define NR_OF_DELETES   1000
+#define NR_OF_LOOKUPS   100000ul
+#define NR_OF_POWER_FAILS 50
+
+/// Value of key at version: [VERSION (2)] [pattern ...] (4 to 16 bytes)
+#define VALUE_LEN(key, version)     (4 + ((key) + (version)) % 13)
+#define VALUE_BYTE(key, version, i) ((u8_t)((key) ^ ((version) * 31) ^ (i)))
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static FILE          *sim_file;
+
+/// Page with changes in simulated SRAM buffer; 0xffff if none
+static u16_t         sim_page = 0xffff;
+static u8_t          sim_buf[AT45D_PAGE_SIZE];
+static bool_t        sim_dirty;
+
+/// Statistics
+static unsigned long sim_spi_bytes;
+static unsigned long sim_reads;
+static unsigned long sim_programs;
+static unsigned long sim_erases[AT45D_PAGES];
+
+/// Version of value of each key (0 if deleted) and last synced version
+static u16_t         key_version[NR_OF_KEYS];
+static u16_t         key_synced[NR_OF_KEYS];
+
+static int           errors;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static double seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static void sim_file_read(void *buffer, at45d_adr_t address, u16_t n)
+{
+    fseek(sim_file, (long)address, SEEK_SET);
+    if(fread(buffer, 1, n, sim_file) != n)
+    {
+        printf("Error: file read\n");
+        exit(1);
+    }
+}
+
+static void sim_file_write(const void *buffer, at45d_adr_t address, u16_t n)
+{
+    fseek(sim_file, (long)address, SEEK_SET);
+    fwrite(buffer, 1, n, sim_file);
+}
+
+/// Power failure: program of SRAM buffer is interrupted
+static void sim_power_fail(void)
+{
+    u8_t  data[AT45D_PAGE_SIZE];
+    u16_t i;
+
+    if(sim_dirty)
+    {
+        // Only some of the bits that must be cleared have been cleared
+        sim_file_read(data, (at45d_adr_t)sim_page * AT45D_PAGE_SIZE, AT45D_PAGE_SIZE);
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            data[i] &= sim_buf[i] | (u8_t)rand();
+        }
+        sim_file_write(data, (at45d_adr_t)sim_page * AT45D_PAGE_SIZE, AT45D_PAGE_SIZE);
+    }
+    sim_dirty = FALSE;
+    sim_page  = 0xffff;
+}
+
+/// Key number (0 to NR_OF_KEYS-1) to store key
+static u16_t key_of(u16_t i)
+{
+    return (u16_t)(i * 3 + 100);
+}
+
+static void set_key(u16_t i, u16_t version)
+{
+    u8_t value[16];
+    u8_t len = VALUE_LEN(i, version);
+    u8_t j;
+
+    value[0] = (u8_t)(version & 0xff);
+    value[1] = (u8_t)(version >> 8);
+    for(j=2; j<len; j++)
+    {
+        value[j] = VALUE_BYTE(i, version, j);
+    }
+    if(!kvs_set(key_of(i), value, len))
+    {
+        printf("Error: kvs_set(%u) failed\n", key_of(i));
+        errors++;
+    }
+    key_version[i] = version;
+}
+
+/// Check value of each key; the version must be between synced and last
+static void check_keys(void)
+{
+    u8_t     value[KVS_VALUE_SIZE_MAX];
+    u8_t     len;
+    u8_t     j;
+    u16_t    i;
+    u16_t    version;
+    unsigned nr_of_keys = 0;
+
+    for(i=0; i<NR_OF_KEYS; i++)
+    {
+        len = kvs_get(key_of(i), value, sizeof(value));
+        if(len == 0)
+        {
+            if((key_version[i] != 0) || (key_synced[i] != 0))
+            {
+                printf("Error: key %u missing\n", key_of(i));
+                errors++;
+            }
+            continue;
+        }
+        nr_of_keys++;
+        version = value[0] | ((u16_t)value[1] << 8);
+        if((version < key_synced[i]) || (version > key_version[i]))
+        {
+            printf("Error: key %u has version %u (%u to %u)\n",
+                   key_of(i), version, key_synced[i], key_version[i]);
+            errors++;
+            continue;
+        }
+        if(len != VALUE_LEN(i, version))
+        {
+            printf("Error: key %u length\n", key_of(i));
+            errors++;
+            continue;
+        }
+        for(j=2; j<len; j++)
+        {
+            if(value[j] != VALUE_BYTE(i, version, j))
+            {
+                printf("Error: key %u value\n", key_of(i));
+                errors++;
+                break;
+            }
+        }
+        // Accept version found after a power failure
+        key_version[i] = version;
+        key_synced[i]  = version;
+    }
+    if(nr_of_keys != kvs_nr_of_keys())
+    {
+        printf("Error: %u keys, but kvs_nr_of_keys() = %u\n",
+               nr_of_keys, kvs_nr_of_keys());
+        errors++;
+    }
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+u16_t at45d_read(void *buffer, at45d_adr_t address, u16_t number_of_bytes)
+{
+    u8_t  *data = (u8_t *)buffer;
+    u16_t page  = (u16_t)(address / AT45D_PAGE_SIZE);
+
+    // Changes must be programmed if page is read (see at45d_write())
+    if(sim_dirty && (page <= sim_page) && 
+       (sim_page <= (address + number_of_bytes - 1) / AT45D_PAGE_SIZE))
+    {
+        at45d_flush();
+    }
+    sim_file_read(data, address, number_of_bytes);
+
+    // Command, address, dont-care bytes and data
+    sim_spi_bytes += 8 + number_of_bytes;
+    sim_reads++;
+
+    return number_of_bytes;
+}
+
+u16_t at45d_append(const void  *buffer,
+                   at45d_adr_t address,
+                   u16_t       number_of_bytes)
+{
+    const u8_t *data  = (const u8_t *)buffer;
+    u16_t      page   = (u16_t)(address / AT45D_PAGE_SIZE);
+    u16_t      offset = (u16_t)(address % AT45D_PAGE_SIZE);
+
+    if((offset + number_of_bytes) > AT45D_PAGE_SIZE)
+    {
+        printf("Error: write crosses page\n");
+        errors++;
+        return 0;
+    }
+
+    if(page != sim_page)
+    {
+        // Program previous page and load page into buffer
+        at45d_flush();
+        sim_file_read(sim_buf, (at45d_adr_t)page * AT45D_PAGE_SIZE, AT45D_PAGE_SIZE);
+        sim_page       = page;
+        sim_spi_bytes += 4;
+    }
+    memcpy(&sim_buf[offset], data, number_of_bytes);
+    sim_dirty      = TRUE;
+    sim_spi_bytes += 4 + number_of_bytes;
+
+    return number_of_bytes;
+}
+
+void at45d_flush(void)
+{
+    u8_t  data[AT45D_PAGE_SIZE];
+    u16_t i;
+
+    if(!sim_dirty)
+    {
+        return;
+    }
+
+    // Program without erase can only clear bits
+    sim_file_read(data, (at45d_adr_t)sim_page * AT45D_PAGE_SIZE, AT45D_PAGE_SIZE);
+    for(i=0; i<AT45D_PAGE_SIZE; i++)
+    {
+        if((sim_buf[i] & ~data[i]) != 0)
+        {
+            printf("Error: append to page %u that is not erased\n", sim_page);
+            errors++;
+            break;
+        }
+    }
+    sim_file_write(sim_buf, (at45d_adr_t)sim_page * AT45D_PAGE_SIZE, AT45D_PAGE_SIZE);
+    sim_dirty      = FALSE;
+    sim_spi_bytes += 4;
+    sim_programs++;
+    sim_erases[sim_page]++;
+}
+
+void at45d_erase_page(u16_t page)
+{
+    static u8_t erased[AT45D_PAGE_SIZE];
+
+    at45d_flush();
+    if(page == sim_page)
+    {
+        sim_page = 0xffff;
+    }
+    memset(erased, 0xff, sizeof(erased));
+    sim_file_write(erased, (at45d_adr_t)page * AT45D_PAGE_SIZE, AT45D_PAGE_SIZE);
+    sim_spi_bytes += 4;
+    sim_erases[page]++;
+}
+
+int main(void)
+{
+    u8_t          value[KVS_VALUE_SIZE_MAX];
+    u16_t         i;
+    u16_t         page;
+    unsigned long n;
+    unsigned long spi_bytes;
+    unsigned long reads;
+    unsigned long erases_min;
+    unsigned long erases_max;
+    double        t;
+    int           fail;
+
+    // Blank DataFlash
+    sim_file = fopen("kvs_test.bin", "w+b");
+    if(sim_file == NULL)
+    {
+        printf("Error: could not create file\n");
+        return 1;
+    }
+    memset(sim_buf, 0xff, sizeof(sim_buf));
+    for(page=0; page<AT45D_PAGES; page++)
+    {
+        fwrite(sim_buf, 1, AT45D_PAGE_SIZE, sim_file);
+    }
+
+    // Mount formats blank region
+    if(!kvs_mount())
+    {
+        printf("Error: mount blank\n");
+        errors++;
+    }
+
+    // Add keys, update random keys and delete keys
+    srand(1);
+    for(i=0; i<NR_OF_KEYS; i++)
+    {
+        set_key(i, 1);
+    }
+    for(n=0; n<NR_OF_UPDATES; n++)
+    {
+        i = (u16_t)(rand() % NR_OF_KEYS);
+        set_key(i, key_version[i] + 1);
+    }
+    for(n=0; n<NR_OF_DELETES; n++)
+    {
+        i = (u16_t)(rand() % NR_OF_KEYS);
+        if(key_version[i] != 0)
+        {
+            kvs_delete(key_of(i));
+            key_version[i] = 0;
+        }
+    }
+    kvs_sync();
+    memcpy(key_synced, key_version, sizeof(key_synced));
+
+    // Updates that are not synced are lost
+    for(n=0; n<1000; n++)
+    {
+        i = (u16_t)(rand() % NR_OF_KEYS);
+        if(key_version[i] != 0)
+        {
+            set_key(i, key_version[i] + 1);
+        }
+    }
+    sim_power_fail();
+
+    // Mount
+    spi_bytes = sim_spi_bytes;
+    reads     = sim_reads;
+    t         = seconds();
+    if(!kvs_mount())
+    {
+        printf("Error: mount\n");
+        errors++;
+    }
+    t = seconds() - t;
+    printf("%u keys in %u pages of %u bytes, %lu page programs\n",
+           kvs_nr_of_keys(), (unsigned)KVS_PAGES, (unsigned)AT45D_PAGE_SIZE, sim_programs);
+    printf("Mount : %lu reads, %lu SPI bytes, %.1f ms (PC)\n",
+           sim_reads - reads, sim_spi_bytes - spi_bytes, t * 1e3);
+
+    check_keys();
+
+    // Power failures with updates that are synced in between
+    for(fail=0; fail<NR_OF_POWER_FAILS; fail++)
+    {
+        for(n=0; n<200; n++)
+        {
+            i = (u16_t)(rand() % NR_OF_KEYS);
+            if(key_version[i] != 0)
+            {
+                set_key(i, key_version[i] + 1);
+            }
+            if((rand() % 8) == 0)
+            {
+                kvs_sync();
+                memcpy(key_synced, key_version, sizeof(key_synced));
+            }
+        }
+        sim_power_fail();
+        if(!kvs_mount())
+        {
+            printf("Error: mount after power failure %d\n", fail);
+            errors++;
+        }
+        check_keys();
+    }
+
+    // Lookup
+    spi_bytes = sim_spi_bytes;
+    t         = seconds();
+    for(n=0; n<NR_OF_LOOKUPS; n++)
+    {
+        kvs_get(key_of((u16_t)(rand() % NR_OF_KEYS)), value, sizeof(value));
+    }
+    t = seconds() - t;
+    printf("Lookup: %lu SPI bytes, %.2f us (PC) per key\n",
+           (sim_spi_bytes - spi_bytes) / NR_OF_LOOKUPS, t * 1e6 / NR_OF_LOOKUPS);
+
+    // Wear
+    erases_min = 0xffffffff;
+    erases_max = 0;
+    for(page=KVS_PAGE_FIRST; page<(KVS_PAGE_FIRST + KVS_PAGES); page++)
+    {
+        if(sim_erases[page] < erases_min)
+        {
+            erases_min = sim_erases[page];
+        }
+        if(sim_erases[page] > erases_max)
+        {
+            erases_max = sim_erases[page];
+        }
+    }
+    printf("Wear  : %lu to %lu erase/program cycles per page\n", erases_min, erases_max);
+
+    fclose(sim_file);
+    printf("%d errors\n", errors);
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,404 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          dflash_log.h test on a RAM DataFlash simulator
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Appends variable size records until the log has wrapped a few times, 
+ * with dlog_sync() every 4 records on average and power failures at random
+ * points. A power failure interrupts the program of the page in the 
+ * buffer: bytes that are being programmed are corrupted. After each power 
+ * failure the log is recovered with dlog_init() and all records are 
+ * checked; no synced record may be lost. Then random time range queries 
+ * are compared with a linear scan of the records that were appended.
+ * 
+ * The DataFlash is simulated in RAM. The simulator keeps changes of one 
+ * page in a "SRAM buffer" until at45d_flush() or a write to another page, 
+ * like at45d_append().
+ * 
+ * Build on a PC (from the "trunk/drivers" directory), with a host "board.h"
+ * (may be empty):
+ *   gcc -O2 -I. -I../general -I../protocol -I<host dir> -DAT45DB041D \
+ *       -DAT45D_POWER_OF_TWO_PAGE_SIZE=0 \
+ *       test/dflash_log_test.c dflash_log.c ../protocol/crc16_ccitt.c \
+ *       -o log_test
+ * 
+ * SPI bytes are counted as the driver would transfer them (command, 
+ * address and dont-care bytes included), e.g. at a 8 MHz SPI clock one 
+ * byte takes 1 us.
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dflash_log.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#define NR_OF_RECORDS       80000ul
+#define NR_OF_POWER_FAILS   50
+#define NR_OF_QUERIES       1000
+
+/// Data of record: [ID (4)] [pattern ...] (4 to DLOG_DATA_SIZE_MAX bytes)
+#define DATA_BYTE(id, i)    ((u8_t)((id) * 7 + (i)))
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static u8_t          sim_mem[AT45D_PAGES][AT45D_PAGE_SIZE];
+
+/// Page with changes in simulated SRAM buffer; 0xffff if none
+static u16_t         sim_page = 0xffff;
+static u8_t          sim_buf[AT45D_PAGE_SIZE];
+static bool_t        sim_dirty;
+
+/// Statistics
+static unsigned long sim_spi_bytes;
+static unsigned long sim_reads;
+
+/// Timestamp and length of each record that was appended (index is ID)
+static u32_t         rec_time[NR_OF_RECORDS];
+static u8_t          rec_len[NR_OF_RECORDS];
+static unsigned long nr_of_records;
+
+/// IDs of the oldest record in the log and the last record programmed
+static unsigned long id_first;
+static unsigned long id_synced;
+
+static int           errors;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Power failure: program of SRAM buffer is interrupted
+static void sim_power_fail(void)
+{
+    u16_t i;
+
+    if(sim_dirty)
+    {
+        // Only some of the bits that must be cleared have been cleared
+        for(i=0; i<AT45D_PAGE_SIZE; i++)
+        {
+            sim_mem[sim_page][i] &= sim_buf[i] | (u8_t)rand();
+        }
+    }
+    sim_dirty = FALSE;
+    sim_page  = 0xffff;
+}
+
+static void append(u32_t time)
+{
+    u8_t          data[DLOG_DATA_SIZE_MAX];
+    u8_t          len = (u8_t)(4 + rand() % (DLOG_DATA_SIZE_MAX - 3));
+    u8_t          i;
+    unsigned long id  = nr_of_records;
+
+    for(i=0; i<4; i++)
+    {
+        data[i] = (u8_t)(id >> (8*i));
+    }
+    for(; i<len; i++)
+    {
+        data[i] = DATA_BYTE(id, i);
+    }
+    if(!dlog_append(time, data, len))
+    {
+        printf("Error: dlog_append(%lu) failed\n", id);
+        errors++;
+        return;
+    }
+    rec_time[id] = time;
+    rec_len[id]  = len;
+    nr_of_records++;
+}
+
+/// Read record of query and check it; returns ID or -1 if there are no more
+static long read_next(dlog_query_t *query)
+{
+    u8_t          data[DLOG_DATA_SIZE_MAX];
+    u8_t          len;
+    u8_t          i;
+    u32_t         time;
+    unsigned long id;
+
+    len = dlog_read_next(query, &time, data, sizeof(data));
+    if(len == 0)
+    {
+        return -1;
+    }
+    id =   (unsigned long)data[0]         | ((unsigned long)data[1] << 8)
+         | ((unsigned long)data[2] << 16) | ((unsigned long)data[3] << 24);
+    if((id >= nr_of_records) || (len != rec_len[id]) || (time != rec_time[id]))
+    {
+        printf("Error: record %lu\n", id);
+        errors++;
+        return (long)id;
+    }
+    for(i=4; i<len; i++)
+    {
+        if(data[i] != DATA_BYTE(id, i))
+        {
+            printf("Error: record %lu data\n", id);
+            errors++;
+            break;
+        }
+    }
+
+    return (long)id;
+}
+
+/// Read all records and check that they are consecutive up to the last one
+static void check_log(void)
+{
+    dlog_query_t  query;
+    long          id;
+    long          id_prev = -1;
+
+    dlog_query(&query, 0, 0xffffffff);
+    while((id = read_next(&query)) >= 0)
+    {
+        if(id_prev < 0)
+        {
+            if((unsigned long)id < id_first)
+            {
+                printf("Error: first record %ld < %lu\n", id, id_first);
+                errors++;
+            }
+            id_first = (unsigned long)id;
+        }
+        else if(id != id_prev + 1)
+        {
+            printf("Error: record %ld after %ld\n", id, id_prev);
+            errors++;
+        }
+        id_prev = id;
+    }
+    if((id_prev < 0) || ((unsigned long)id_prev + 1 < id_synced))
+    {
+        printf("Error: last record %ld (%lu synced)\n", id_prev, id_synced);
+        errors++;
+    }
+
+    // Records that were lost are appended again
+    nr_of_records = (unsigned long)(id_prev + 1);
+    id_synced     = nr_of_records;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+u16_t at45d_read(void *buffer, at45d_adr_t address, u16_t number_of_bytes)
+{
+    u16_t page = (u16_t)(address / AT45D_PAGE_SIZE);
+
+    // Changes must be programmed if page is read (see at45d_append())
+    if(sim_dirty && (page <= sim_page) && 
+       (sim_page <= (address + number_of_bytes - 1) / AT45D_PAGE_SIZE))
+    {
+        at45d_flush();
+    }
+    memcpy(buffer, &sim_mem[0][0] + address, number_of_bytes);
+
+    // Command, address, dont-care bytes and data
+    sim_spi_bytes += 8 + number_of_bytes;
+    sim_reads++;
+
+    return number_of_bytes;
+}
+
+u16_t at45d_append(const void  *buffer,
+                   at45d_adr_t address,
+                   u16_t       number_of_bytes)
+{
+    u16_t page   = (u16_t)(address / AT45D_PAGE_SIZE);
+    u16_t offset = (u16_t)(address % AT45D_PAGE_SIZE);
+
+    if((offset + number_of_bytes) > AT45D_PAGE_SIZE)
+    {
+        printf("Error: write crosses page\n");
+        errors++;
+        return 0;
+    }
+
+    if(page != sim_page)
+    {
+        // Program previous page and load page into buffer
+        at45d_flush();
+        memcpy(sim_buf, sim_mem[page], AT45D_PAGE_SIZE);
+        sim_page       = page;
+        sim_spi_bytes += 4;
+    }
+    memcpy(&sim_buf[offset], buffer, number_of_bytes);
+    sim_dirty      = TRUE;
+    sim_spi_bytes += 4 + number_of_bytes;
+
+    return number_of_bytes;
+}
+
+void at45d_flush(void)
+{
+    u16_t i;
+
+    if(!sim_dirty)
+    {
+        return;
+    }
+
+    // Program without erase can only clear bits
+    for(i=0; i<AT45D_PAGE_SIZE; i++)
+    {
+        if((sim_buf[i] & ~sim_mem[sim_page][i]) != 0)
+        {
+            printf("Error: append to page %u that is not erased\n", sim_page);
+            errors++;
+            break;
+        }
+    }
+    memcpy(sim_mem[sim_page], sim_buf, AT45D_PAGE_SIZE);
+    sim_dirty      = FALSE;
+    sim_spi_bytes += 4;
+}
+
+void at45d_erase_page(u16_t page)
+{
+    at45d_flush();
+    if(page == sim_page)
+    {
+        sim_page = 0xffff;
+    }
+    memset(sim_mem[page], 0xff, AT45D_PAGE_SIZE);
+    sim_spi_bytes += 4;
+}
+
+int main(void)
+{
+    dlog_query_t  query;
+    u32_t         time = 0;
+    u32_t         t1;
+    u32_t         t2;
+    unsigned long id;
+    unsigned long n;
+    unsigned long count;
+    unsigned long spi_bytes;
+    unsigned long reads;
+    unsigned long init_reads = 0;
+    unsigned long query_reads = 0;
+    unsigned long query_spi_bytes = 0;
+    long          id_read;
+    int           i;
+
+    // Blank DataFlash
+    memset(sim_mem, 0xff, sizeof(sim_mem));
+    dlog_init();
+    dlog_query(&query, 0, 0xffffffff);
+    if(read_next(&query) >= 0)
+    {
+        printf("Error: blank log is not empty\n");
+        errors++;
+    }
+
+    // Append records (some with the same timestamp) with power failures
+    srand(1);
+    for(i=0; i<NR_OF_POWER_FAILS; i++)
+    {
+        n = (NR_OF_RECORDS - 1000) / NR_OF_POWER_FAILS;
+        while(n-- != 0)
+        {
+            time += (u32_t)(rand() % 4);
+            append(time);
+            if((rand() % 4) == 0)
+            {
+                dlog_sync();
+                id_synced = nr_of_records;
+            }
+        }
+        sim_power_fail();
+
+        reads = sim_reads;
+        dlog_init();
+        init_reads += sim_reads - reads;
+
+        check_log();
+    }
+    printf("%lu records in log (%lu appended), %u pages of %u bytes\n",
+           nr_of_records - id_first, nr_of_records, 
+           (unsigned)DLOG_PAGES, (unsigned)AT45D_PAGE_SIZE);
+    printf("Init  : %lu reads (linear scan: %u)\n",
+           init_reads / NR_OF_POWER_FAILS, (unsigned)DLOG_PAGES);
+
+    // Queries
+    for(i=0; i<NR_OF_QUERIES; i++)
+    {
+        t1 = rec_time[id_first] + (u32_t)rand() % (time - rec_time[id_first] + 1);
+        t2 = t1 + (u32_t)(rand() % 200);
+
+        spi_bytes = sim_spi_bytes;
+        reads     = sim_reads;
+        dlog_query(&query, t1, t2);
+        id_read   = read_next(&query);
+        query_reads     += sim_reads - reads;
+        query_spi_bytes += sim_spi_bytes - spi_bytes;
+
+        // Compare with linear scan
+        count = 0;
+        for(id=id_first; id<nr_of_records; id++)
+        {
+            if((rec_time[id] < t1) || (rec_time[id] > t2))
+            {
+                continue;
+            }
+            if((long)id != id_read)
+            {
+                printf("Error: query %lu to %lu: record %ld instead of %lu\n",
+                       (unsigned long)t1, (unsigned long)t2, id_read, id);
+                errors++;
+                break;
+            }
+            count++;
+            id_read = read_next(&query);
+        }
+        if(id_read >= 0)
+        {
+            printf("Error: query %lu to %lu: extra record %ld\n",
+                   (unsigned long)t1, (unsigned long)t2, id_read);
+            errors++;
+        }
+    }
+    printf("Query : %lu reads, %lu SPI bytes to first record\n",
+           query_reads / NR_OF_QUERIES, query_spi_bytes / NR_OF_QUERIES);
+
+    printf("%d errors\n", errors);
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Debug module
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dbg.h"
+
+#if DBG && DBG_RUNTIME_MASK
+#include "cmd_line.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Size of string that lists the mask of each module
+#define DBG_CMD_STR_SIZE    64
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+u8_t dbg_mask[DBG_NR_OF_MODULES] = 
+{
+    [0 ... (DBG_NR_OF_MODULES-1)] = DBG_LEVEL_ALL
+};
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+#ifdef DBG_MODULE_NAMES
+/// Module names
+static const char * const dbg_module_names[DBG_NR_OF_MODULES] = 
+{
+    DBG_MODULE_NAMES
+};
+#endif
+
+/// String returned by dbg_cmd_handler()
+static char dbg_cmd_str[DBG_CMD_STR_SIZE];
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Find module by name or number
+static bool_t dbg_find_module(const char *str, u8_t *module)
+{
+    long val;
+
+#ifdef DBG_MODULE_NAMES
+    for(*module=0; *module<DBG_NR_OF_MODULES; (*module)++)
+    {
+        if(strcmp(str, dbg_module_names[*module]) == 0)
+        {
+            return TRUE;
+        }
+    }
+#endif
+
+    if(!cmd_line_strtol(str, &val, 0, DBG_NR_OF_MODULES-1))
+    {
+        return FALSE;
+    }
+    *module = (u8_t)val;
+
+    return TRUE;
+}
+
+/// Append a string to dbg_cmd_str (truncated if full)
+static u8_t dbg_cmd_str_append(u8_t index, const char *str)
+{
+    while((*str != '\0') && (index < (DBG_CMD_STR_SIZE-1)))
+    {
+        dbg_cmd_str[index++] = *str++;
+    }
+    dbg_cmd_str[index] = '\0';
+
+    return index;
+}
+
+/// List mask of each module
+static const char* dbg_cmd_list(void)
+{
+    u8_t module;
+    u8_t index = 0;
+    char str[4];
+
+    for(module=0; module<DBG_NR_OF_MODULES; module++)
+    {
+#ifdef DBG_MODULE_NAMES
+        index = dbg_cmd_str_append(index, dbg_module_names[module]);
+#else
+        str[0] = '0' + (module / 10);
+        str[1] = '0' + (module % 10);
+        str[2] = '\0';
+        index  = dbg_cmd_str_append(index, (module < 10) ? &str[1] : str);
+#endif
+        str[0] = '=';
+        str[1] = '0' + (dbg_mask[module] & 0x07);
+        str[2] = ' ';
+        str[3] = '\0';
+        index  = dbg_cmd_str_append(index, str);
+    }
+
+    return dbg_cmd_str;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void dbg_set_mask(u8_t module, u8_t mask)
+{
+    if(module >= DBG_NR_OF_MODULES)
+    {
+        memset(dbg_mask, mask, sizeof(dbg_mask));
+    }
+    else
+    {
+        dbg_mask[module] = mask;
+    }
+}
+
+const char* dbg_cmd_handler(int argc, char* argv[])
+{
+    long val;
+    u8_t module = DBG_NR_OF_MODULES;
+
+    switch(argc)
+    {
+    case 0:
+        return dbg_cmd_list();
+
+    case 1:
+        // Set all modules
+        break;
+
+    case 2:
+        if(!dbg_find_module(argv[0], &module))
+        {
+            return "Error: unknown module";
+        }
+        argv++;
+        break;
+
+    default:
+        return "Error: too many arguments";
+    }
+
+    if(!cmd_line_strtol(argv[0], &val, 0, DBG_LEVEL_ALL))
+    {
+        return "Error: mask must be 0 to 7";
+    }
+    dbg_set_mask(module, (u8_t)val);
+
+    return dbg_cmd_list();
+}
+
+#endif
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
@@ -44,7 +44,7 @@
  *
  *  Outputs debug information via printf
  *
- *  Files: dbg.h
+ *  Files: dbg.h & dbg.c
  *
  *  An old school debugging practice is to add debug print statements in the source
  *  code to track program flow and check for coding mistakes during development. 
@@ -53,6 +53,43 @@
  *  (e.g. -DDBG=1 -DDBG_LEVEL=DBG_LEVEL_ALL in the Makefile) or on a per file
  *  basis.
  *  
+ *  @par
+ *  Formatting and sending a message takes a long time, which changes the 
+ *  timing of the code that is debugged. If #DBG_DEFERRED is set to 1, 
+ *  messages are logged as binary records instead and formatted on the host
+ *  (see @ref DBG_BIN_LOG).
+ *  
+ *  @par Per module levels
+ *  A global #DBG_LEVEL enables the same output for all files. To trace only 
+ *  one module, a file can override the level with #DBG_MODULE_LEVEL. It 
+ *  must be defined before any header is included:
+ *  @code
+ *  #define DBG_MODULE_ID    DBG_MODULE_HDLC   // Index of runtime mask (see below)
+ *  #define DBG_MODULE_LEVEL DBG_LEVEL_ALL     // Overrides DBG_LEVEL for this file
+ *  #include "hdlc.h"
+ *  #include "dbg.h"
+ *  @endcode
+ *  A level that is not enabled at compile time evaluates to a constant
+ *  FALSE, so the message (and format string) is removed by the compiler.
+ *  
+ *  @par Runtime mask
+ *  If #DBG_RUNTIME_MASK is set to 1, each message is also tested against a
+ *  runtime mask per module, dbg_mask[#DBG_MODULE_ID]. The index and level 
+ *  are constants, so the test is a single load-and-test of one byte. The 
+ *  project defines #DBG_NR_OF_MODULES and optionally #DBG_MODULE_NAMES, 
+ *  e.g. in "board.h":
+ *  @code
+ *  #define DBG_MODULE_MAIN     0
+ *  #define DBG_MODULE_HDLC     1
+ *  #define DBG_NR_OF_MODULES   2
+ *  #define DBG_MODULE_NAMES    "main", "hdlc"
+ *  @endcode
+ *  All levels are enabled in the runtime mask at startup, so by default only
+ *  the compile time levels apply. The mask can be changed with 
+ *  dbg_set_mask() or with the "dbg" command of @ref CMD_LINE 
+ *  (see dbg_cmd_handler()), e.g. "dbg hdlc 4" to enable progress messages 
+ *  of the HDLC module only.
+ *  
  *  @par Example:
  *  @include "dbg_test.c"
  *
@@ -73,6 +110,15 @@
 #define DBG 0
 #endif
 
+/// Flag to log messages in the deferred binary log (see @ref DBG_BIN_LOG)
+#ifndef DBG_DEFERRED
+#define DBG_DEFERRED 0
+#endif
+
+#if DBG && DBG_DEFERRED
+#include "dbg_log.h"
+#endif
+
 /// @name Debug level bitmask definitions
 //@{
 /// None
@@ -100,11 +146,92 @@
 #define DBG_LEVEL DBG_LEVEL_ERR
 #endif
 
+#ifndef DBG_MODULE_LEVEL
+/// Debug output level of this file (defined before including "dbg.h")
+#define DBG_MODULE_LEVEL DBG_LEVEL
+#endif
+
+#ifndef DBG_RUNTIME_MASK
+/// Flag to test messages against a runtime mask per module
+#define DBG_RUNTIME_MASK 0
+#endif
+
+#ifndef DBG_NR_OF_MODULES
+/// Number of modules with a runtime mask
+#define DBG_NR_OF_MODULES 1
+#endif
+
+#ifndef DBG_MODULE_ID
+/// Index of runtime mask of this file (0 to #DBG_NR_OF_MODULES-1)
+#define DBG_MODULE_ID 0
+#endif
+
+#ifdef __DOXYGEN__
+/// Optional list of module names (strings) used by dbg_cmd_handler()
+#define DBG_MODULE_NAMES
+#endif
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+#if DBG && DBG_RUNTIME_MASK
+/// Runtime mask of enabled levels per module
+extern u8_t dbg_mask[DBG_NR_OF_MODULES];
+#endif
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+#if DBG && DBG_RUNTIME_MASK
+/**
+ * Set the runtime mask of a module.
+ * 
+ * @param module    Module (0 to #DBG_NR_OF_MODULES-1); 
+ *                  #DBG_NR_OF_MODULES to set all modules
+ * @param mask      Bitmask of enabled levels, e.g. DBG_LEVEL_ERR|DBG_LEVEL_WARN
+ */
+extern void dbg_set_mask(u8_t module, u8_t mask);
+
+/**
+ * Command line handler to display or change the runtime mask.
+ * 
+ * Add it with cmd_line_add(&cmd, "dbg", &dbg_cmd_handler, "...").
+ * - "dbg" displays the mask of each module;
+ * - "dbg <mask>" sets the mask of all modules;
+ * - "dbg <module> <mask>" sets the mask of one module (by name or number).
+ * 
+ * @param argc      Number of arguments
+ * @param argv      Arguments
+ * 
+ * @return const char*  String to display
+ */
+extern const char* dbg_cmd_handler(int argc, char* argv[]);
+#endif
+
 /* _____MACROS_______________________________________________________________ */
 #if DBG
+/**
+ * See if a level is enabled for this file.
+ * 
+ * Evaluates to a constant if #DBG_RUNTIME_MASK is 0 or the level is not 
+ * enabled by #DBG_MODULE_LEVEL; otherwise one byte of dbg_mask is tested.
+ * 
+ * @param level     The debug severity level (progress, warning or error)
+ */
+#if DBG_RUNTIME_MASK
+#define DBG_LEVEL_ENABLED(level) \
+            (((level) & DBG_MODULE_LEVEL) && (dbg_mask[DBG_MODULE_ID] & (level)))
+#else
+#define DBG_LEVEL_ENABLED(level) \
+            (((level) & DBG_MODULE_LEVEL) != 0)
+#endif
+
 ///@cond
+// Block indefinitely (after sending deferred log)
+#if DBG_DEFERRED
+#define _DBG_HALT() { dbg_log_flush(); for(;;) {;} }
+#else
+#define _DBG_HALT() { for(;;) {;} }
+#endif
+
 // 1st part macro to convert a number to a string (GCC specific)
 #define _DBG_STRINGIFY(number) #number
 // 2nd part macro to convert a number to a string (GCC specific)
@@ -112,23 +239,27 @@
 ///@endcond
 
 /**
- *  Macro that will output debug output if #DBG_LEVEL is defined as non zero.
+ *  Macro that will output debug output if #DBG_MODULE_LEVEL is defined as non zero.
  *
  *  @note The format of this macro is specific to the GCC preprocessor.
  * 
  *  @param[in] format Format string following by a variable list of arguments.
  *  
  */
-#ifdef __AVR__
+#if DBG_DEFERRED
+#define DBG_TRACE(format, ...) \
+            { if(DBG_MODULE_LEVEL != 0) DBG_LOG_RECORD(format, ## __VA_ARGS__); }
+#elif defined(__AVR__)
 #define DBG_TRACE(format, ...) \
-            { if(DBG_LEVEL != 0) PRINTF(format, ## __VA_ARGS__); }
+            { if(DBG_MODULE_LEVEL != 0) PRINTF(format, ## __VA_ARGS__); }
 #else
 #define DBG_TRACE(format, ...) \
-            { if(DBG_LEVEL != 0) printf(format, ## __VA_ARGS__); }
+            { if(DBG_MODULE_LEVEL != 0) printf(format, ## __VA_ARGS__); }
 #endif
 
 /**
- *  Macro that will output debug output if the specified level bit is set in #DBG_LEVEL.
+ *  Macro that will output debug output if the specified level is enabled 
+ *  (see DBG_LEVEL_ENABLED()).
  *
  *  The file name and line number is prepended to the format string to form one string.
  *  @note The format of this macro is specific to the GCC preprocessor.
@@ -139,7 +270,7 @@
  */
 #define DBG_LOG(level, format, ...) \
             { \
-                if(level & DBG_LEVEL) \
+                if(DBG_LEVEL_ENABLED(level)) \
                     DBG_TRACE(__FILE__ " " _DBG_NR_TO_STR(__LINE__) " : " format, ## __VA_ARGS__); \
             }
 
@@ -153,13 +284,14 @@
  */
 #define DBG_ASSERT(expression) \
             { \
-                if((DBG_LEVEL != 0) && (!(expression))) \
+                if((DBG_MODULE_LEVEL != 0) && (!(expression))) \
                 { \
                     DBG_TRACE(__FILE__ " " _DBG_NR_TO_STR(__LINE__) " : ASSERT " #expression); \
-                    for(;;) {;} \
+                    _DBG_HALT(); \
                 } \
             }
 #else
+#define DBG_LEVEL_ENABLED(level) 0
 #define DBG_TRACE(format, ...)
 #define DBG_LOG(level, format, ...)
 #define DBG_ASSERT(expression)
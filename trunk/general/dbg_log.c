@@ -0,0 +1,209 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Deferred binary debug log
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dbg_log.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#if !VAL_IS_PWR_OF_TWO(DBG_LOG_BUFFER_SIZE)
+#error "DBG_LOG_BUFFER_SIZE must be a power of two"
+#endif
+
+/// Mask to wrap ring buffer index
+#define DBG_LOG_MASK        (DBG_LOG_BUFFER_SIZE - 1)
+
+#if !DBG_LOG_ISR_SAFE
+#undef  DBG_LOG_CRITICAL_BEGIN
+#undef  DBG_LOG_CRITICAL_END
+#define DBG_LOG_CRITICAL_BEGIN()
+#define DBG_LOG_CRITICAL_END()
+#endif
+
+/* _____MACROS_______________________________________________________________ */
+/// Store a byte in the ring buffer and advance index
+#define DBG_LOG_PUT(index, data) \
+    { dbg_log_buffer[index] = (u8_t)(data); index = (index + 1) & DBG_LOG_MASK; }
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Ring buffer
+static u8_t  dbg_log_buffer[DBG_LOG_BUFFER_SIZE];
+
+/// Index of next byte to write
+static u16_t dbg_log_in;
+
+/// Index of next byte to send
+static u16_t dbg_log_out;
+
+/// Number of dropped records that have not been reported yet
+static u16_t dbg_log_dropped;
+
+/// Pointer to the function that will be called to send a byte
+static dbg_log_put_char_t dbg_log_put_char;
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Write a record; the caller makes sure that there is space
+static u16_t dbg_log_put_record(u16_t       in,
+                                u16_t       id,
+                                u32_t       timestamp,
+                                u8_t        nr_of_args,
+                                const u32_t *args)
+{
+    u32_t arg;
+
+    DBG_LOG_PUT(in, DBG_LOG_SYNC | nr_of_args);
+    DBG_LOG_PUT(in, U16_LO8(id));
+    DBG_LOG_PUT(in, U16_HI8(id));
+    DBG_LOG_PUT(in, timestamp);
+    DBG_LOG_PUT(in, timestamp >> 8);
+    DBG_LOG_PUT(in, timestamp >> 16);
+    DBG_LOG_PUT(in, timestamp >> 24);
+
+    while(nr_of_args != 0)
+    {
+        arg = *args++;
+        DBG_LOG_PUT(in, arg);
+        DBG_LOG_PUT(in, arg >> 8);
+        DBG_LOG_PUT(in, arg >> 16);
+        DBG_LOG_PUT(in, arg >> 24);
+        nr_of_args--;
+    }
+
+    return in;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void dbg_log_init(dbg_log_put_char_t put_char)
+{
+    dbg_log_in       = 0;
+    dbg_log_out      = 0;
+    dbg_log_dropped  = 0;
+    dbg_log_put_char = put_char;
+}
+
+void dbg_log_write(u16_t id, u8_t nr_of_args, const u32_t *args)
+{
+    u16_t size      = DBG_LOG_HEADER_SIZE + 4 * nr_of_args;
+    u32_t timestamp = DBG_LOG_TIMESTAMP();
+    u32_t dropped;
+    u16_t free;
+
+    DBG_LOG_CRITICAL_BEGIN();
+
+    free = (dbg_log_out - dbg_log_in - 1) & DBG_LOG_MASK;
+
+    // Report dropped records first
+    if(dbg_log_dropped != 0)
+    {
+        if(free >= (size + DBG_LOG_HEADER_SIZE + 4))
+        {
+            dropped         = dbg_log_dropped;
+            dbg_log_in      = dbg_log_put_record(dbg_log_in, DBG_LOG_ID_DROPPED, 
+                                                 timestamp, 1, &dropped);
+            dbg_log_dropped = 0;
+            free           -= DBG_LOG_HEADER_SIZE + 4;
+        }
+        else
+        {
+            // Keep space for report
+            free = 0;
+        }
+    }
+
+    if(size <= free)
+    {
+        dbg_log_in = dbg_log_put_record(dbg_log_in, id, timestamp, nr_of_args, args);
+    }
+    else if(dbg_log_dropped != 0xffff)
+    {
+        dbg_log_dropped++;
+    }
+
+    DBG_LOG_CRITICAL_END();
+}
+
+u16_t dbg_log_service(u16_t max_bytes)
+{
+    u16_t in;
+    u16_t out   = dbg_log_out;
+    u16_t count = 0;
+
+    DBG_LOG_CRITICAL_BEGIN();
+    in = dbg_log_in;
+    DBG_LOG_CRITICAL_END();
+
+    while((out != in) && (count != max_bytes))
+    {
+        (*dbg_log_put_char)((char)dbg_log_buffer[out]);
+        out = (out + 1) & DBG_LOG_MASK;
+        count++;
+    }
+
+    DBG_LOG_CRITICAL_BEGIN();
+    dbg_log_out = out;
+    DBG_LOG_CRITICAL_END();
+
+    return count;
+}
+
+void dbg_log_flush(void)
+{
+    while(dbg_log_service(DBG_LOG_BUFFER_SIZE) != 0)
+    {
+        ;
+    }
+}
+
+u16_t dbg_log_get_dropped(void)
+{
+    return dbg_log_dropped;
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
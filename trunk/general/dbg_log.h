@@ -0,0 +1,234 @@
+#ifndef __DBG_LOG_H__
+#define __DBG_LOG_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Deferred binary debug log
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup DBG_BIN_LOG dbg_log.h : Deferred binary debug log
+ *
+ *  Debug messages are logged as compact binary records and formatted on 
+ *  the host.
+ *  
+ *  Files: dbg_log.h, dbg_log.c & dbg_log_decode.py
+ *  
+ *  @par
+ *  A debug message that is formatted with printf() and sent on a polled UART 
+ *  takes milliseconds, which changes the timing of the code being debugged.
+ *  If #DBG_DEFERRED is set to 1, the @ref DBG macros do not format the 
+ *  message; they write a record to a RAM ring buffer that contains:
+ *  - a 16-bit format ID (the address of the format string);
+ *  - a 32-bit timestamp (#DBG_LOG_TIMESTAMP());
+ *  - the raw arguments (each converted to 32 bits).
+ *  
+ *  @par
+ *  dbg_log_service() is called from the main loop (or a background task) 
+ *  to send the records as binary data when there is time. On the host, 
+ *  dbg_log_decode.py reads the format strings from the ELF file and turns 
+ *  the records back into text:
+ *  @code
+ *  python dbg_log_decode.py firmware.elf log.bin --ticks-per-sec 7372800 --int-bits 16
+ *  @endcode
+ *  
+ *  @par Format strings
+ *  The format strings (including the file name and line number that 
+ *  DBG_LOG() prepends) are placed in the ".dbg_fmt" section. No code reads
+ *  them, so the section should not be stored in Flash. For AVR, the section 
+ *  is moved out of the Flash address space and removed from the HEX file 
+ *  (the same way as the ".eeprom" section) by the Makefile template:
+ *  @code
+ *  LDFLAGS += -Wl,--section-start=.dbg_fmt=0x900000
+ *  $(OBJCOPY) -O $(FORMAT) -R .eeprom -R .fuse -R .lock -R .dbg_fmt $< $@
+ *  @endcode
+ *  The format ID is the low 16 bits of the address of the format string, so
+ *  the total size of the format strings must be less than 64 kB.
+ *  
+ *  @par Limitations
+ *  - Only integer arguments are supported (up to #DBG_LOG_MAX_ARGS). A 
+ *    string argument (%s) is logged as the pointer value.
+ *  - The size of 'int' of the target must be passed to the decoder 
+ *    (--int-bits 16 for AVR) so that negative values of %u and %x are 
+ *    displayed correctly.
+ *  - A record is dropped if the ring buffer is full. The number of dropped
+ *    records is logged as soon as there is space again.
+ *  
+ *  @par
+ *  If messages are logged from an interrupt handler and the main loop, set 
+ *  #DBG_LOG_ISR_SAFE to 1 and define DBG_LOG_CRITICAL_BEGIN() and 
+ *  DBG_LOG_CRITICAL_END() in "board.h" (see @ref POOL for an example).
+ *  
+ *  Example:
+ *  @include test/dbg_log_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#ifndef DBG_LOG_TIMESTAMP
+#include "systmr.h"
+#endif
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef DBG_LOG_BUFFER_SIZE
+/// Size of ring buffer in bytes (must be a power of two)
+#define DBG_LOG_BUFFER_SIZE 256
+#endif
+
+#ifndef DBG_LOG_ISR_SAFE
+/// Flag to protect the ring buffer with DBG_LOG_CRITICAL_BEGIN() and DBG_LOG_CRITICAL_END()
+#define DBG_LOG_ISR_SAFE    0
+#endif
+
+#if DBG_LOG_ISR_SAFE && !defined(DBG_LOG_CRITICAL_BEGIN)
+#error "DBG_LOG_CRITICAL_BEGIN() and DBG_LOG_CRITICAL_END() must be defined"
+#endif
+
+#ifndef DBG_LOG_TIMESTAMP
+/// Timestamp that is stored in each record
+#define DBG_LOG_TIMESTAMP() systmr_get_timestamp()
+#endif
+
+/// Maximum number of arguments of a message
+#define DBG_LOG_MAX_ARGS    6
+
+/// Format ID of the record that reports the number of dropped records
+#define DBG_LOG_ID_DROPPED  0xffff
+
+/// Marker in the high nibble of the first byte of each record
+#define DBG_LOG_SYNC        0xa0
+
+/// Size of record without arguments (sync + nr of args, ID, timestamp)
+#define DBG_LOG_HEADER_SIZE 7
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/**
+ * Definition for a pointer to a function that will be called to 
+ * send a byte of the log.
+ */
+typedef void (*dbg_log_put_char_t)(char data);
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Initialise deferred log. The ring buffer is empty.
+ * 
+ * @param put_char  Pointer to a function that will be called to send a byte
+ */
+extern void dbg_log_init(dbg_log_put_char_t put_char);
+
+/**
+ * Write a record to the ring buffer.
+ * 
+ * Use DBG_LOG_RECORD() (or the @ref DBG macros) instead of calling this 
+ * function directly.
+ * 
+ * @param id            Format ID
+ * @param nr_of_args    Number of arguments (0 to #DBG_LOG_MAX_ARGS)
+ * @param args          Arguments
+ */
+extern void dbg_log_write(u16_t id, u8_t nr_of_args, const u32_t *args);
+
+/**
+ * Send logged records.
+ * 
+ * Call from the main loop or a background task.
+ * 
+ * @param max_bytes Maximum number of bytes to send
+ * 
+ * @return u16_t    Number of bytes sent
+ */
+extern u16_t dbg_log_service(u16_t max_bytes);
+
+/**
+ * Send all logged records, e.g. before the program halts.
+ */
+extern void dbg_log_flush(void);
+
+/**
+ * Get the number of records that have been dropped because the ring buffer
+ * was full.
+ * 
+ * @return u16_t    Number of dropped records that have not been reported yet
+ */
+extern u16_t dbg_log_get_dropped(void);
+
+/* _____MACROS_______________________________________________________________ */
+///@cond
+#define _DBG_LOG_NARGS(...) \
+    _DBG_LOG_NARGS_N(0, ## __VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define _DBG_LOG_NARGS_N(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+///@endcond
+
+/**
+ * Format ID of a format string.
+ * 
+ * The string is placed in the ".dbg_fmt" section and the low 16 bits of its
+ * address is used as ID, which is resolved by the linker.
+ * 
+ * @note The format of this macro is specific to GCC.
+ * 
+ * @param format    Format string (a string literal)
+ */
+#define DBG_LOG_FMT_ID(format) \
+    ({ \
+        static const char _dbg_log_fmt[] __attribute__((section(".dbg_fmt"))) = format; \
+        (u16_t)(uintptr_t)_dbg_log_fmt; \
+    })
+
+/**
+ * Log a message in the deferred log.
+ * 
+ * @note The format of this macro is specific to GCC.
+ * 
+ * @param format    Format string (a string literal)
+ * @param ...       Up to #DBG_LOG_MAX_ARGS integer arguments
+ */
+#define DBG_LOG_RECORD(format, ...) \
+    dbg_log_write(DBG_LOG_FMT_ID(format), \
+                  _DBG_LOG_NARGS(__VA_ARGS__), \
+                  (const u32_t[]){0, ## __VA_ARGS__} + 1)
+
+/**
+ * @}
+ */
+#endif
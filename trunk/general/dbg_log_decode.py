@@ -0,0 +1,202 @@
+#!/usr/bin/env python
+# =============================================================================
+#
+#   Copyright (c) 2026 The Piconomic Firmware Library contributors
+#   All rights reserved.
+#
+#   Redistribution and use in source and binary forms, with or without
+#   modification, are permitted provided that the following conditions are met:
+#
+#   * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+#   * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+#
+#   * Neither the name of the copyright holders nor the names of
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#   ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+#   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#   CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#   POSSIBILITY OF SUCH DAMAGE.
+#
+#   Title:          Host decoder for the deferred binary debug log (dbg_log.h)
+#   Author(s):      agent
+#   Creation Date:  2026/10/19
+#   Revision Info:  $Id$
+#
+# =============================================================================
+"""
+Decode the binary records sent by dbg_log_service() into text.
+
+The format strings are read from the ".dbg_fmt" section of the ELF file of
+the firmware. The log is read from a file (or stdin with "-"), e.g. a 
+capture of the serial port.
+
+Usage:
+    python dbg_log_decode.py firmware.elf log.bin [--ticks-per-sec N] [--int-bits 16]
+"""
+
+import re
+import struct
+import sys
+
+SECTION_NAME   = ".dbg_fmt"
+SYNC           = 0xa0
+HEADER_SIZE    = 7
+ID_DROPPED     = 0xffff
+MAX_ARGS       = 6
+
+# printf conversion specification
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z)?([diouxXcsp%])")
+
+def read_format_strings(elf_file_name):
+    """Return dictionary of format ID -> format string"""
+    with open(elf_file_name, "rb") as f:
+        elf = f.read()
+
+    if elf[0:4] != b"\x7fELF":
+        raise ValueError("Not an ELF file")
+    is_64 = (elf[4] == 2)
+    endian = "<" if (elf[5] == 1) else ">"
+
+    # Section header table
+    if is_64:
+        e_shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        e_shentsize, e_shnum, e_shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3a)
+        sh_format = endian + "IIQQQQIIQQ"
+    else:
+        e_shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        e_shentsize, e_shnum, e_shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2e)
+        sh_format = endian + "IIIIIIIIII"
+
+    sections = []
+    for i in range(e_shnum):
+        sections.append(struct.unpack_from(sh_format, elf, e_shoff + i * e_shentsize))
+
+    # Section names
+    strtab = sections[e_shstrndx]
+    names  = elf[strtab[4]:strtab[4] + strtab[5]]
+
+    formats = {}
+    for sh in sections:
+        name = names[sh[0]:names.index(b"\0", sh[0])].decode()
+        if name != SECTION_NAME:
+            continue
+        addr, offset, size = sh[3], sh[4], sh[5]
+        data = elf[offset:offset + size]
+        # Strings may be padded with zeros for alignment
+        start = 0
+        while start < size:
+            end = data.index(b"\0", start)
+            if end != start:
+                formats[(addr + start) & 0xffff] = data[start:end].decode("latin-1")
+            start = end + 1
+    return formats
+
+def to_signed(value, bits):
+    value &= (1 << bits) - 1
+    if value & (1 << (bits - 1)):
+        value -= (1 << bits)
+    return value
+
+def format_message(fmt, args, int_bits):
+    """Format message like printf on the target"""
+    out  = []
+    pos  = 0
+    args = list(args)
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        value = args.pop(0) if args else 0
+        bits = 32 if length in ("l", "ll", "z") else int_bits
+        if length == "hh":
+            bits = 8
+        elif length == "h":
+            bits = 16
+        spec = "%" + flags + width + ("." + precision if precision else "")
+        if conv in "di":
+            out.append((spec + "d") % to_signed(value, bits))
+        elif conv in "ouxX":
+            out.append((spec + conv.replace("u", "d")) % (value & ((1 << bits) - 1)))
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xff))
+        else:
+            # Strings and pointers are not available; show address
+            out.append("<0x%x>" % value)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+def decode(formats, log, ticks_per_sec, int_bits, write):
+    i = 0
+    while i + HEADER_SIZE <= len(log):
+        nr_of_args = log[i] & 0x0f
+        if ((log[i] & 0xf0) != SYNC) or (nr_of_args > MAX_ARGS):
+            # Not the start of a record; resynchronise
+            i += 1
+            continue
+        size = HEADER_SIZE + 4 * nr_of_args
+        if i + size > len(log):
+            break
+        fmt_id, timestamp = struct.unpack_from("<HI", log, i + 1)
+        args = struct.unpack_from("<%dI" % nr_of_args, log, i + HEADER_SIZE)
+        if fmt_id == ID_DROPPED:
+            text = "*** %d record(s) dropped ***\n" % args[0]
+        elif fmt_id in formats:
+            text = format_message(formats[fmt_id], args, int_bits)
+        else:
+            # Unknown format; resynchronise
+            i += 1
+            continue
+        if ticks_per_sec:
+            write("[%12.6f] %s" % (float(timestamp) / ticks_per_sec, text))
+        else:
+            write("[%10u] %s" % (timestamp, text))
+        i += size
+
+def main(argv):
+    ticks_per_sec = 0
+    int_bits      = 16
+    files         = []
+    i = 1
+    while i < len(argv):
+        if argv[i] == "--ticks-per-sec":
+            ticks_per_sec = int(argv[i + 1])
+            i += 2
+        elif argv[i] == "--int-bits":
+            int_bits = int(argv[i + 1])
+            i += 2
+        else:
+            files.append(argv[i])
+            i += 1
+    if len(files) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    formats = read_format_strings(files[0])
+    if files[1] == "-":
+        log = bytearray(sys.stdin.buffer.read() if hasattr(sys.stdin, "buffer") else sys.stdin.read())
+    else:
+        with open(files[1], "rb") as f:
+            log = bytearray(f.read())
+
+    decode(formats, log, ticks_per_sec, int_bits, sys.stdout.write)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,257 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Binary min-heap priority queue
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "heap.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+
+/* _____MACROS_______________________________________________________________ */
+/// Index of parent of item at specified index
+#define HEAP_PARENT(index)  (((index) - 1) / 2)
+
+/// Index of left child of item at specified index
+#define HEAP_CHILD(index)   (2 * (index) + 1)
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Store item at specified position
+static inline void heap_set(heap_t *heap, size_t index, heap_item_t *item)
+{
+    heap->items[index] = item;
+    item->index        = index;
+}
+
+/// Move item up until its parent is less than or equal to it
+static void heap_sift_up(heap_t *heap, size_t index)
+{
+    heap_item_t *item = heap->items[index];
+    size_t      parent;
+
+    // Move parents down instead of swapping
+    while(index > 0)
+    {
+        parent = HEAP_PARENT(index);
+        if((*heap->compare)(heap->items[parent], item) <= 0)
+        {
+            break;
+        }
+        heap_set(heap, index, heap->items[parent]);
+        index = parent;
+    }
+    heap_set(heap, index, item);
+}
+
+/// Move item down until its children are greater than or equal to it
+static void heap_sift_down(heap_t *heap, size_t index)
+{
+    heap_item_t *item = heap->items[index];
+    size_t      child;
+
+    // Move smallest child up instead of swapping
+    for(;;)
+    {
+        child = HEAP_CHILD(index);
+        if(child >= heap->nr_of_items)
+        {
+            break;
+        }
+        // Select smallest child
+        if(  ((child + 1) < heap->nr_of_items)
+           &&((*heap->compare)(heap->items[child + 1], heap->items[child]) < 0))
+        {
+            child++;
+        }
+        if((*heap->compare)(item, heap->items[child]) <= 0)
+        {
+            break;
+        }
+        heap_set(heap, index, heap->items[child]);
+        index = child;
+    }
+    heap_set(heap, index, item);
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void heap_init(heap_t         *heap,
+               heap_item_t    **items,
+               size_t         max_nr_of_items,
+               heap_compare_t compare)
+{
+    heap->items           = items;
+    heap->nr_of_items     = 0;
+    heap->max_nr_of_items = max_nr_of_items;
+    heap->compare         = compare;
+}
+
+void heap_item_init(heap_item_t *item)
+{
+    item->heap  = NULL;
+    item->index = 0;
+}
+
+bool_t heap_is_empty(const heap_t *heap)
+{
+    if(heap->nr_of_items == 0)
+    {
+        return TRUE;
+    }
+    else
+    {
+        return FALSE;
+    }
+}
+
+size_t heap_nr_of_items(const heap_t *heap)
+{
+    return heap->nr_of_items;
+}
+
+bool_t heap_insert(heap_t *heap, heap_item_t *item)
+{
+    if(heap->nr_of_items >= heap->max_nr_of_items)
+    {
+        return FALSE;
+    }
+
+    // Add to end and move up to correct position
+    item->heap = heap;
+    heap_set(heap, heap->nr_of_items, item);
+    heap->nr_of_items++;
+    heap_sift_up(heap, item->index);
+
+    return TRUE;
+}
+
+heap_item_t* heap_peek_min(const heap_t *heap)
+{
+    if(heap->nr_of_items == 0)
+    {
+        return NULL;
+    }
+    return heap->items[0];
+}
+
+heap_item_t* heap_extract_min(heap_t *heap)
+{
+    heap_item_t *item = heap_peek_min(heap);
+
+    if(item != NULL)
+    {
+        heap_remove(heap, item);
+    }
+
+    return item;
+}
+
+void heap_remove(heap_t *heap, heap_item_t *item)
+{
+    size_t      index = item->index;
+    heap_item_t *last;
+
+    if(item->heap != heap)
+    {
+        return;
+    }
+    item->heap = NULL;
+
+    // Replace item with last item
+    heap->nr_of_items--;
+    if(index == heap->nr_of_items)
+    {
+        return;
+    }
+    last = heap->items[heap->nr_of_items];
+    heap_set(heap, index, last);
+
+    // Last item may be less than the parent or greater than the children
+    if((index > 0) && ((*heap->compare)(last, heap->items[HEAP_PARENT(index)]) < 0))
+    {
+        heap_sift_up(heap, index);
+    }
+    else
+    {
+        heap_sift_down(heap, index);
+    }
+}
+
+void heap_update(heap_t *heap, heap_item_t *item)
+{
+    if(item->heap != heap)
+    {
+        return;
+    }
+
+    if(  (item->index > 0) 
+       &&((*heap->compare)(item, heap->items[HEAP_PARENT(item->index)]) < 0))
+    {
+        heap_sift_up(heap, item->index);
+    }
+    else
+    {
+        heap_sift_down(heap, item->index);
+    }
+}
+
+bool_t heap_item_in_heap(const heap_t *heap, const heap_item_t *item)
+{
+    if(item->heap == heap)
+    {
+        return TRUE;
+    }
+    else
+    {
+        return FALSE;
+    }
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
@@ -0,0 +1,226 @@
+#ifndef __HEAP_H__
+#define __HEAP_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Binary min-heap priority queue
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup HEAP heap.h : Binary min-heap priority queue
+ *
+ *  An intrusive binary min-heap with O(log n) insert and extract-min.
+ *  
+ *  Files: heap.h & heap.c
+ *  
+ *  @par
+ *  The heap is an array of pointers to items, ordered so that each item 
+ *  compares less than or equal to its two children (items 2i+1 and 2i+2). 
+ *  The first item is always the minimum. A #heap_item_t link structure must 
+ *  be at the head of each item; it stores the position of the item in the 
+ *  array, so that an item can be removed or updated after its key has 
+ *  changed in O(log n) and heap_item_in_heap() is O(1).
+ *  
+ *  @par
+ *  Typical uses are timer deadlines, retransmit queues and event 
+ *  scheduling, where only the earliest item is needed. For short lists,
+ *  list_insert_sorted() may be simpler.
+ *  
+ *  @code
+ *  typedef struct
+ *  {
+ *      heap_item_t item;       // Must be first
+ *      u32_t       deadline;
+ *  } event_t;
+ *  
+ *  static int event_compare(const heap_item_t *a, const heap_item_t *b)
+ *  {
+ *      return (s32_t)(((event_t *)a)->deadline - ((event_t *)b)->deadline);
+ *  }
+ *  
+ *  static heap_item_t *event_array[16];
+ *  static heap_t       event_heap;
+ *  
+ *  heap_init(&event_heap, event_array, 16, &event_compare);
+ *  @endcode
+ *  
+ *  Example:
+ *  @include test/heap_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stddef.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Link structure that must be at the head of each item in the heap
+typedef struct heap_item_s
+{
+    struct heap_s *heap;            ///< Heap that item is in; NULL if not in a heap
+    size_t        index;            ///< Position of item in heap array
+} heap_item_t;
+
+/**
+ * Definition for a pointer to a function that compares two items.
+ * 
+ * @return int  < 0 if item1 is less than item2; 0 if equal; > 0 if item1 
+ *              is greater than item2
+ */
+typedef int (*heap_compare_t)(const heap_item_t *item1, 
+                              const heap_item_t *item2);
+
+/// Heap structure
+typedef struct heap_s
+{
+    heap_item_t    **items;         ///< Array of pointers to items
+    size_t         nr_of_items;     ///< Number of items in heap
+    size_t         max_nr_of_items; ///< Size of array
+    heap_compare_t compare;         ///< Compare function
+} heap_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Initialise an empty heap.
+ * 
+ * @param heap              Pointer to heap
+ * @param items             Array of item pointers
+ * @param max_nr_of_items   Number of pointers in array
+ * @param compare           Function that compares two items
+ */
+extern void heap_init(heap_t         *heap,
+                      heap_item_t    **items,
+                      size_t         max_nr_of_items,
+                      heap_compare_t compare);
+
+/**
+ * Initialise an item to indicate that it is not in a heap.
+ * 
+ * @param item      Pointer to item
+ */
+extern void heap_item_init(heap_item_t *item);
+
+/**
+ * See if the heap is empty.
+ * 
+ * @param heap      Pointer to heap
+ * 
+ * @retval TRUE     Heap is empty
+ * @retval FALSE    Heap contains at least one item
+ */
+extern bool_t heap_is_empty(const heap_t *heap);
+
+/**
+ * Get the number of items in the heap.
+ * 
+ * @param heap      Pointer to heap
+ * 
+ * @return size_t   Number of items
+ */
+extern size_t heap_nr_of_items(const heap_t *heap);
+
+/**
+ * Insert an item. O(log n)
+ * 
+ * @param heap      Pointer to heap
+ * @param item      Item to insert (may not be in a heap already)
+ * 
+ * @retval TRUE     Item has been inserted
+ * @retval FALSE    Heap is full
+ */
+extern bool_t heap_insert(heap_t *heap, heap_item_t *item);
+
+/**
+ * Get the minimum item without removing it. O(1)
+ * 
+ * @param heap              Pointer to heap
+ * 
+ * @return heap_item_t*     Minimum item; NULL if heap is empty
+ */
+extern heap_item_t* heap_peek_min(const heap_t *heap);
+
+/**
+ * Remove and return the minimum item. O(log n)
+ * 
+ * @param heap              Pointer to heap
+ * 
+ * @return heap_item_t*     Minimum item; NULL if heap is empty
+ */
+extern heap_item_t* heap_extract_min(heap_t *heap);
+
+/**
+ * Remove an item. O(log n)
+ * 
+ * Nothing is done if the item is not in this heap.
+ * 
+ * @param heap      Pointer to heap
+ * @param item      Item to remove
+ */
+extern void heap_remove(heap_t *heap, heap_item_t *item);
+
+/**
+ * Restore the order after the key of an item has changed. O(log n)
+ * 
+ * @param heap      Pointer to heap
+ * @param item      Item whose key has changed
+ */
+extern void heap_update(heap_t *heap, heap_item_t *item);
+
+/**
+ * See if an item is in the heap. O(1)
+ * 
+ * @param heap      Pointer to heap
+ * @param item      Item
+ * 
+ * @retval TRUE     Item is in the heap
+ * @retval FALSE    Item is not in the heap
+ */
+extern bool_t heap_item_in_heap(const heap_t *heap, const heap_item_t *item);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ * @}
+ */
+#endif
@@ -69,6 +69,7 @@ void list_item_init(list_t      *list,
 {
     item->previous_item = NULL;
     item->next_item     = NULL;
+    item->list          = NULL;
 }
 
 bool_t list_is_empty(list_t *list)
@@ -152,6 +153,7 @@ bool_t list_add_to_start(list_t      *list,
         list->first_item->previous_item = item;
         list->first_item                = item;
     }
+    item->list = list;
 
     // Increment item count
     (list->nr_of_items)++;
@@ -183,6 +185,48 @@ bool_t list_add_to_end(list_t      *list,
         list->last_item->next_item = item;
         list->last_item            = item;
     }
+    item->list = list;
+
+    // Increment item count
+    (list->nr_of_items)++;
+
+    return TRUE;
+}
+
+bool_t list_insert_sorted(list_t         *list,
+                          list_item_t    *item,
+                          list_compare_t compare)
+{
+    list_item_t *previous_item;
+
+    if(list_is_full(list))
+    {
+        return FALSE;
+    }
+
+    // Search backwards for last item that must be before (or is equal to) 
+    // new item; a new deadline is usually near the end of the list
+    previous_item = list->last_item;
+    while((previous_item != NULL) && ((*compare)(previous_item, item) > 0))
+    {
+        previous_item = previous_item->previous_item;
+    }
+
+    if(previous_item == NULL)
+    {
+        return list_add_to_start(list, item);
+    }
+    if(previous_item == list->last_item)
+    {
+        return list_add_to_end(list, item);
+    }
+
+    // Insert new item after previous item
+    item->previous_item                     = previous_item;
+    item->next_item                         = previous_item->next_item;
+    previous_item->next_item->previous_item = item;
+    previous_item->next_item                = item;
+    item->list                              = list;
 
     // Increment item count
     (list->nr_of_items)++;
@@ -216,6 +260,7 @@ list_item_t *list_remove_first_item(list_t *list)
     // Clear links of removed item
     item->previous_item = NULL;
     item->next_item     = NULL;
+    item->list          = NULL;
 
     // Decrement item count
     (list->nr_of_items)--;
@@ -249,6 +294,7 @@ list_item_t *list_remove_last_item(list_t *list)
     // Clear links of removed item
     item->previous_item = NULL;
     item->next_item     = NULL;
+    item->list          = NULL;
 
     // Decrement item count
     (list->nr_of_items)--;
@@ -260,7 +306,7 @@ void list_remove_item(list_t      *list,
                       list_item_t *item)
 {
     // Extra sanity check
-    if(list_is_empty(list))
+    if(item->list != list)
     {
         return;
     }
@@ -286,6 +332,7 @@ void list_remove_item(list_t      *list,
     // Clear links of item
     item->previous_item = NULL;
     item->next_item     = NULL;
+    item->list          = NULL;
 
     // Decrement item count
     (list->nr_of_items)--;
@@ -294,22 +341,16 @@ void list_remove_item(list_t      *list,
 bool_t list_item_in_list(list_t      *list,
                          list_item_t *item)
 {
-    // Start at first item in the list
-    list_item_t *item_in_list = list->first_item;
-
-    // Search all items in the list
-    while(item_in_list != NULL)
+    if(item->list == list)
     {
-        if(item_in_list == item)
-        {
-            // Item is in the list
-            return TRUE;
-        }
-        // Next item
-        item_in_list = item_in_list->next_item;
+        // Item is in the list
+        return TRUE;
+    }
+    else
+    {
+        // Item is not in the list
+        return FALSE;
     }
-    // Item is not in the list
-    return FALSE;
 }
 
 /* _____LOG__________________________________________________________________ */
@@ -317,5 +358,9 @@ bool_t list_item_in_list(list_t      *list,
 
  2008/11/27 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added list_insert_sorted()
+ - Added owner pointer to list items; list_item_in_list() is O(1)
    
 */
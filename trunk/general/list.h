@@ -68,6 +68,13 @@
  *  [first] -> [prev = NULL][next] <-> [prev][next] <-> [prev][next = NULL]  <- [last]
  *  @endcode
  *  
+ *  Each item also points to the list that it is in, so list_item_in_list() 
+ *  does not have to search the list.
+ *  
+ *  list_insert_sorted() keeps a list in order with a compare function, 
+ *  e.g. a retransmit queue sorted by deadline. Insertion is O(n); use 
+ *  @ref HEAP if the list is long and only the first item is needed.
+ *  
  *  @{
  */
 
@@ -85,10 +92,11 @@ typedef struct list_item_s
 {
     struct list_item_s *next_item;
     struct list_item_s *previous_item;
+    struct list_s      *list;       ///< List that item is in; NULL if not in a list
 } list_item_t;
 
 /// Linked list structure
-typedef struct
+typedef struct list_s
 {
     struct list_item_s *first_item;        ///< Pointer to first item in the list
     struct list_item_s *last_item;         ///< Pointer to last item in the list
@@ -96,6 +104,15 @@ typedef struct
     size_t              max_nr_of_items;   ///< Maximum number of items allowed in list; 0 means no limit
 } list_t;
 
+/**
+ * Definition for a pointer to a function that compares two items.
+ * 
+ * @return int  < 0 if item1 must be before item2; 0 if equal; > 0 if item1 
+ *              must be after item2
+ */
+typedef int (*list_compare_t)(const list_item_t *item1, 
+                              const list_item_t *item2);
+
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
@@ -217,6 +234,25 @@ extern bool_t list_add_to_start(list_t      *list,
 extern bool_t list_add_to_end(list_t      *list,
                               list_item_t *item);
 
+/** 
+ * Insert item in a sorted list.
+ * 
+ * The list is searched from the end, because a new deadline is usually 
+ * later than most of the items in the list. The item is inserted after the
+ * last item that is less than or equal to it, so items that compare equal 
+ * stay in the order that they were inserted.
+ * 
+ * @param list      Pointer to the linked list
+ * @param item      Item to be inserted
+ * @param compare   Function that compares two items
+ * 
+ * @retval TRUE     Item has been inserted
+ * @retval FALSE    List is full
+ */
+extern bool_t list_insert_sorted(list_t         *list,
+                                 list_item_t    *item,
+                                 list_compare_t compare);
+
 /** 
  * Remove first item from the list
  * 
@@ -248,7 +284,9 @@ extern void list_remove_item(list_t      *list,
                              list_item_t *item);
 
 /** 
- * See if item is in the list
+ * See if item is in the list.
+ * 
+ * This is an O(1) operation: the list pointer of the item is compared.
  * 
  * @param list      Pointer to the linked list
  * @param item      Pointer to specified item
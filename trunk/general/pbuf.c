@@ -0,0 +1,331 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Reference counted packet buffers
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "pbuf.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#if !POOL_ISR_SAFE
+#undef  POOL_CRITICAL_BEGIN
+#undef  POOL_CRITICAL_END
+#define POOL_CRITICAL_BEGIN()
+#define POOL_CRITICAL_END()
+#endif
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Pool of packet buffers
+POOL_DECLARE(pbuf_pool, sizeof(pbuf_t), PBUF_NR_OF_BUFFERS);
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Allocate a single empty buffer
+static pbuf_t* pbuf_alloc_buffer(u16_t reserve)
+{
+    pbuf_t *p = pool_alloc(&pbuf_pool);
+
+    if(p != NULL)
+    {
+        p->next    = NULL;
+        p->payload = &p->data[reserve];
+        p->len     = 0;
+        p->tot_len = 0;
+        p->ref     = 1;
+    }
+    return p;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void pbuf_init(void)
+{
+    POOL_INIT(pbuf_pool);
+}
+
+pbuf_t* pbuf_alloc(u16_t length, u16_t reserve)
+{
+    pbuf_t *head;
+    pbuf_t *p;
+    u16_t  len;
+
+    if(reserve > PBUF_DATA_SIZE)
+    {
+        return NULL;
+    }
+
+    head = pbuf_alloc_buffer(reserve);
+    if(head == NULL)
+    {
+        return NULL;
+    }
+
+    // First buffer
+    len = PBUF_DATA_SIZE - reserve;
+    if(len > length)
+    {
+        len = length;
+    }
+    head->len     = len;
+    head->tot_len = length;
+    length       -= len;
+
+    // Rest of chain
+    p = head;
+    while(length != 0)
+    {
+        p->next = pbuf_alloc_buffer(0);
+        if(p->next == NULL)
+        {
+            pbuf_free(head);
+            return NULL;
+        }
+        p = p->next;
+
+        len = PBUF_DATA_SIZE;
+        if(len > length)
+        {
+            len = length;
+        }
+        p->len     = len;
+        p->tot_len = length;
+        length    -= len;
+    }
+
+    return head;
+}
+
+void pbuf_ref(pbuf_t *p)
+{
+    POOL_CRITICAL_BEGIN();
+    p->ref++;
+    POOL_CRITICAL_END();
+}
+
+u8_t pbuf_free(pbuf_t *p)
+{
+    pbuf_t *next;
+    u8_t   ref;
+    u8_t   count = 0;
+
+    while(p != NULL)
+    {
+        POOL_CRITICAL_BEGIN();
+        ref = --(p->ref);
+        POOL_CRITICAL_END();
+
+        // Still referenced (by another chain)?
+        if(ref != 0)
+        {
+            break;
+        }
+
+        next = p->next;
+        pool_free(&pbuf_pool, p);
+        count++;
+        p = next;
+    }
+
+    return count;
+}
+
+bool_t pbuf_header(pbuf_t *p, s16_t size)
+{
+    if(size > 0)
+    {
+        // Enough header reserve?
+        if((u16_t)(p->payload - p->data) < (u16_t)size)
+        {
+            return FALSE;
+        }
+    }
+    else
+    {
+        // Enough payload in first buffer?
+        if(p->len < (u16_t)(-size))
+        {
+            return FALSE;
+        }
+    }
+
+    p->payload -= size;
+    p->len     += size;
+    p->tot_len += size;
+
+    return TRUE;
+}
+
+u16_t pbuf_append(pbuf_t *p, const void *data, u16_t length)
+{
+    const u8_t *src = (const u8_t *)data;
+    pbuf_t     *q;
+    u16_t      free;
+    u16_t      appended = 0;
+
+    // Find last buffer
+    for(q = p; q->next != NULL; q = q->next)
+    {
+        ;
+    }
+
+    while(appended != length)
+    {
+        // Free space at end of last buffer
+        free = (u16_t)(&q->data[PBUF_DATA_SIZE] - (q->payload + q->len));
+        if(free == 0)
+        {
+            q->next = pbuf_alloc_buffer(0);
+            if(q->next == NULL)
+            {
+                break;
+            }
+            q    = q->next;
+            free = PBUF_DATA_SIZE;
+        }
+        if(free > (length - appended))
+        {
+            free = length - appended;
+        }
+
+        memcpy(q->payload + q->len, src, free);
+        q->len    += free;
+        src       += free;
+        appended  += free;
+    }
+
+    // Update total length of each buffer (bytes up to end of chain)
+    free = p->tot_len + appended;
+    for(q = p; q != NULL; q = q->next)
+    {
+        q->tot_len = free;
+        free      -= q->len;
+    }
+
+    return appended;
+}
+
+void pbuf_trim(pbuf_t *p, u16_t length)
+{
+    if(length >= p->tot_len)
+    {
+        return;
+    }
+
+    // Find buffer that contains last byte (keep first buffer)
+    while((length > p->len) && (p->next != NULL))
+    {
+        p->tot_len = length;
+        length    -= p->len;
+        p          = p->next;
+    }
+    p->len     = length;
+    p->tot_len = length;
+
+    // Release rest of chain
+    pbuf_free(p->next);
+    p->next = NULL;
+}
+
+void pbuf_cat(pbuf_t *head, pbuf_t *tail)
+{
+    pbuf_t *p;
+
+    for(p = head; p->next != NULL; p = p->next)
+    {
+        p->tot_len += tail->tot_len;
+    }
+    p->tot_len += tail->tot_len;
+    p->next     = tail;
+}
+
+u16_t pbuf_copy_out(const pbuf_t *p,
+                    u16_t        offset,
+                    void         *buffer,
+                    u16_t        length)
+{
+    u8_t  *dst   = (u8_t *)buffer;
+    u16_t copied = 0;
+    u16_t len;
+
+    // Skip buffers before offset
+    while((p != NULL) && (offset >= p->len))
+    {
+        offset -= p->len;
+        p       = p->next;
+    }
+
+    while((p != NULL) && (copied != length))
+    {
+        len = p->len - offset;
+        if(len > (length - copied))
+        {
+            len = length - copied;
+        }
+        memcpy(dst, p->payload + offset, len);
+        dst    += len;
+        copied += len;
+        offset  = 0;
+        p       = p->next;
+    }
+
+    return copied;
+}
+
+size_t pbuf_get_nr_free(void)
+{
+    return pool_get_nr_free(&pbuf_pool);
+}
+
+size_t pbuf_get_high_water_mark(void)
+{
+    return pool_get_high_water_mark(&pbuf_pool);
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
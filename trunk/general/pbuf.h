@@ -0,0 +1,257 @@
+#ifndef __PBUF_H__
+#define __PBUF_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Reference counted packet buffers
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup PBUF pbuf.h : Reference counted packet buffers
+ *
+ *  Chains of fixed-size packet buffers with header reserve, allocated from 
+ *  a fixed-block memory pool.
+ *  
+ *  Files: pbuf.h & pbuf.c
+ *  
+ *  @par
+ *  Without packet buffers, each layer keeps its own static buffer and a 
+ *  received frame is copied from the protocol layer to the application and 
+ *  from the application to the storage driver. A packet buffer is allocated 
+ *  by the receiving layer, filled in place and ownership is passed on to the 
+ *  next layer, which can strip or add headers without moving the data. The 
+ *  DataFlash driver writes a buffer chain straight from the buffers, e.g.
+ *  @code
+ *  static void hdlc_on_rx_frame(pbuf_t *frame)
+ *  {
+ *      // Add 2-byte length header in reserved space (HDLC_PBUF_RESERVE = 2)
+ *      pbuf_header(frame, 2);
+ *      frame->payload[0] = U16_LO8(frame->tot_len - 2);
+ *      frame->payload[1] = U16_HI8(frame->tot_len - 2);
+ *  
+ *      at45d_write_page_pbuf(frame, page++, 0);
+ *      pbuf_free(frame);
+ *  }
+ *  @endcode
+ *  
+ *  @par
+ *  Each buffer holds up to #PBUF_DATA_SIZE bytes. Longer packets are stored 
+ *  in a chain of buffers linked with pbuf_t::next. pbuf_t::len is the number 
+ *  of bytes in the buffer and pbuf_t::tot_len is the number of bytes in the 
+ *  buffer and the rest of the chain, so the first buffer tells the length of 
+ *  the packet.
+ *  
+ *  @par
+ *  A buffer is released when its reference count drops to zero. A layer 
+ *  that keeps a packet while passing it on (e.g. to retransmit it) calls 
+ *  pbuf_ref(); pbuf_free() decrements the count and releases buffers of the 
+ *  chain until a buffer is found that is still referenced.
+ *  
+ *  @par
+ *  The buffers are allocated from a @ref POOL of #PBUF_NR_OF_BUFFERS blocks.
+ *  If buffers are allocated or released in an interrupt handler, 
+ *  #POOL_ISR_SAFE must be set, which also protects the reference counts.
+ *  
+ *  Example:
+ *  @include test/pbuf_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stddef.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "pool.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef PBUF_DATA_SIZE
+/// Size of data area of each buffer (header reserve + payload)
+#define PBUF_DATA_SIZE      64
+#endif
+
+#ifndef PBUF_NR_OF_BUFFERS
+/// Number of buffers in pool
+#define PBUF_NR_OF_BUFFERS  8
+#endif
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Packet buffer
+typedef struct pbuf_s
+{
+    struct pbuf_s *next;                ///< Next buffer of chain; NULL if last
+    u8_t          *payload;             ///< Start of data in this buffer
+    u16_t         len;                  ///< Number of bytes in this buffer
+    u16_t         tot_len;              ///< Number of bytes in this buffer and rest of chain
+    u8_t          ref;                  ///< Reference count
+    u8_t          data[PBUF_DATA_SIZE]; ///< Header reserve and payload
+} pbuf_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Initialise pool of packet buffers. All buffers are free.
+ */
+extern void pbuf_init(void);
+
+/**
+ * Allocate a packet.
+ * 
+ * A chain of buffers is allocated to hold @b length bytes. The payload of 
+ * the first buffer starts @b reserve bytes into the data area to leave 
+ * space for headers that are added later with pbuf_header(). The content of
+ * the payload is not initialised. The reference count of each buffer is 1.
+ * 
+ * @param length    Number of bytes of payload (may be 0)
+ * @param reserve   Number of bytes to reserve for headers 
+ *                  (0 to #PBUF_DATA_SIZE)
+ * 
+ * @return pbuf_t*  Pointer to first buffer of chain; NULL if there are not 
+ *                  enough free buffers
+ */
+extern pbuf_t* pbuf_alloc(u16_t length, u16_t reserve);
+
+/**
+ * Increment the reference count of a buffer.
+ * 
+ * @param p         Pointer to buffer
+ */
+extern void pbuf_ref(pbuf_t *p);
+
+/**
+ * Decrement the reference count of a packet and release buffers that are 
+ * no longer referenced.
+ * 
+ * Buffers of the chain are released until a buffer is found that is still
+ * referenced.
+ * 
+ * @param p         Pointer to first buffer of chain; NULL is ignored
+ * 
+ * @return u8_t     Number of buffers released
+ */
+extern u8_t pbuf_free(pbuf_t *p);
+
+/**
+ * Add or remove a header at the start of a packet.
+ * 
+ * The payload pointer of the first buffer is moved backwards into the header
+ * reserve to add a header (the caller fills it in), or forwards to remove a
+ * header. No data is copied.
+ * 
+ * @param p         Pointer to first buffer of chain
+ * @param size      Number of bytes to add (positive) or remove (negative)
+ * 
+ * @retval TRUE     Header added or removed
+ * @retval FALSE    Not enough header reserve or payload in first buffer
+ */
+extern bool_t pbuf_header(pbuf_t *p, s16_t size);
+
+/**
+ * Append data to the end of a packet.
+ * 
+ * Data is stored in the free space at the end of the last buffer and more 
+ * buffers are allocated and added to the chain if needed.
+ * 
+ * @param p         Pointer to first buffer of chain
+ * @param data      Data to append
+ * @param length    Number of bytes to append
+ * 
+ * @return u16_t    Number of bytes appended; less than @b length if there 
+ *                  were not enough free buffers
+ */
+extern u16_t pbuf_append(pbuf_t *p, const void *data, u16_t length);
+
+/**
+ * Shorten a packet.
+ * 
+ * Buffers at the end of the chain that are no longer needed are released 
+ * (with pbuf_free()). The first buffer is always kept.
+ * 
+ * @param p         Pointer to first buffer of chain
+ * @param length    New length of packet; ignored if not shorter
+ */
+extern void pbuf_trim(pbuf_t *p, u16_t length);
+
+/**
+ * Concatenate two packets.
+ * 
+ * The reference of @b tail is passed on to @b head; the caller must not free
+ * @b tail afterwards.
+ * 
+ * @param head      Pointer to first buffer of packet that is extended
+ * @param tail      Pointer to first buffer of packet that is appended
+ */
+extern void pbuf_cat(pbuf_t *head, pbuf_t *tail);
+
+/**
+ * Copy part of a packet to a contiguous buffer.
+ * 
+ * @param p         Pointer to first buffer of chain
+ * @param offset    Offset of first byte in packet
+ * @param buffer    Destination buffer
+ * @param length    Number of bytes to copy
+ * 
+ * @return u16_t    Number of bytes copied; less than @b length if the 
+ *                  packet is shorter
+ */
+extern u16_t pbuf_copy_out(const pbuf_t *p,
+                           u16_t        offset,
+                           void         *buffer,
+                           u16_t        length);
+
+/**
+ * Get the number of free buffers.
+ * 
+ * @return size_t   Number of free buffers
+ */
+extern size_t pbuf_get_nr_free(void);
+
+/**
+ * Get the maximum number of buffers that have been in use at the same time.
+ * 
+ * @return size_t   High-water mark
+ */
+extern size_t pbuf_get_high_water_mark(void);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ * @}
+ */
+#endif
@@ -0,0 +1,164 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Fixed-block memory pool
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "pool.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#if !POOL_ISR_SAFE
+#undef  POOL_CRITICAL_BEGIN
+#undef  POOL_CRITICAL_END
+#define POOL_CRITICAL_BEGIN()
+#define POOL_CRITICAL_END()
+#endif
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void pool_init(pool_t *pool,
+               void   *buffer,
+               size_t block_size,
+               size_t nr_of_blocks)
+{
+    u8_t         *data;
+    pool_block_t **link;
+
+    block_size = POOL_BLOCK_SIZE(block_size);
+
+    pool->start        = (u8_t *)buffer;
+    pool->end          = (u8_t *)buffer + block_size * nr_of_blocks;
+    pool->block_size   = block_size;
+    pool->nr_of_blocks = nr_of_blocks;
+    pool->nr_free      = nr_of_blocks;
+    pool->min_free     = nr_of_blocks;
+
+    // Link all blocks in order
+    link = &pool->free_list;
+    for(data = pool->start; data < pool->end; data += block_size)
+    {
+        *link = (pool_block_t *)data;
+        link  = &((pool_block_t *)data)->next;
+    }
+    *link = NULL;
+}
+
+void* pool_alloc(pool_t *pool)
+{
+    pool_block_t *block;
+
+    POOL_CRITICAL_BEGIN();
+
+    block = pool->free_list;
+    if(block != NULL)
+    {
+        // Remove first block from free list
+        pool->free_list = block->next;
+
+        // Update statistics
+        pool->nr_free--;
+        if(pool->min_free > pool->nr_free)
+        {
+            pool->min_free = pool->nr_free;
+        }
+    }
+
+    POOL_CRITICAL_END();
+
+    return block;
+}
+
+void pool_free(pool_t *pool, void *block)
+{
+    if(block == NULL)
+    {
+        return;
+    }
+
+    POOL_CRITICAL_BEGIN();
+
+    // Add block to start of free list
+    ((pool_block_t *)block)->next = pool->free_list;
+    pool->free_list               = (pool_block_t *)block;
+    pool->nr_free++;
+
+    POOL_CRITICAL_END();
+}
+
+bool_t pool_owns(const pool_t *pool, const void *block)
+{
+    const u8_t *data = (const u8_t *)block;
+
+    if((data < pool->start) || (data >= pool->end))
+    {
+        return FALSE;
+    }
+    if(((size_t)(data - pool->start) % pool->block_size) != 0)
+    {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+size_t pool_get_nr_free(const pool_t *pool)
+{
+    return pool->nr_free;
+}
+
+size_t pool_get_high_water_mark(const pool_t *pool)
+{
+    return pool->nr_of_blocks - pool->min_free;
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
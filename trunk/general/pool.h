@@ -0,0 +1,227 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Fixed-block memory pool
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup POOL pool.h : Fixed-block memory pool
+ *
+ *  O(1) allocation and release of fixed-size memory blocks.
+ *  
+ *  Files: pool.h & pool.c
+ *  
+ *  @par
+ *  A pool manages a static buffer that is divided into blocks of the same 
+ *  size. Free blocks are linked in a list that is stored inside the blocks
+ *  themselves, so there is no overhead per block and pool_alloc() and 
+ *  pool_free() only remove or add the first block of the list. There is no 
+ *  fragmentation, which makes it suitable when malloc() is not an option.
+ *  
+ *  @par
+ *  Protocol layers (HDLC frames, NMEA sentences, RPC messages, list items)
+ *  can share one pool instead of each reserving a static worst-case buffer.
+ *  The storage and pool object is declared with POOL_DECLARE(), which sizes 
+ *  the buffer at compile time:
+ *  
+ *  @code
+ *  POOL_DECLARE(frame_pool, 64, 8);     // 8 blocks of 64 bytes
+ *  
+ *  POOL_INIT(frame_pool);
+ *  u8_t *frame = pool_alloc(&frame_pool);
+ *  if(frame != NULL)
+ *  {
+ *      ...
+ *      pool_free(&frame_pool, frame);
+ *  }
+ *  @endcode
+ *  
+ *  @par
+ *  The lowest number of free blocks is recorded (high-water mark of blocks 
+ *  in use) to size the pool from measurements.
+ *  
+ *  @par
+ *  If a pool is used from an interrupt handler and the main loop, set 
+ *  #POOL_ISR_SAFE to 1 and define POOL_CRITICAL_BEGIN() and 
+ *  POOL_CRITICAL_END() for the architecture in "board.h", e.g. for AVR:
+ *  @code
+ *  #define POOL_CRITICAL_BEGIN()   u8_t pool_sreg = SREG; cli()
+ *  #define POOL_CRITICAL_END()     SREG = pool_sreg
+ *  @endcode
+ *  
+ *  Example:
+ *  @include test/pool_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stddef.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef POOL_ISR_SAFE
+/// Flag to protect pool operations with POOL_CRITICAL_BEGIN() and POOL_CRITICAL_END()
+#define POOL_ISR_SAFE 0
+#endif
+
+#if POOL_ISR_SAFE && !defined(POOL_CRITICAL_BEGIN)
+#error "POOL_CRITICAL_BEGIN() and POOL_CRITICAL_END() must be defined"
+#endif
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Free block; the link is stored in the block itself
+typedef struct pool_block_s
+{
+    struct pool_block_s *next;
+} pool_block_t;
+
+/// Pool object
+typedef struct
+{
+    pool_block_t *free_list;        ///< List of free blocks
+    u8_t         *start;            ///< First block
+    u8_t         *end;              ///< One past last block
+    size_t       block_size;        ///< Size of each block (rounded up)
+    size_t       nr_of_blocks;      ///< Total number of blocks
+    size_t       nr_free;           ///< Number of free blocks
+    size_t       min_free;          ///< Lowest number of free blocks
+} pool_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Initialise pool. All blocks are free.
+ * 
+ * @param pool          Pointer to pool object
+ * @param buffer        Buffer for blocks; must be aligned for a pointer and 
+ *                      be POOL_BLOCK_SIZE(block_size) * nr_of_blocks bytes
+ * @param block_size    Size of each block in bytes
+ * @param nr_of_blocks  Number of blocks
+ */
+extern void pool_init(pool_t *pool,
+                      void   *buffer,
+                      size_t block_size,
+                      size_t nr_of_blocks);
+
+/**
+ * Allocate a block.
+ * 
+ * @param pool      Pointer to pool object
+ * 
+ * @return void*    Pointer to block; NULL if all blocks are in use
+ */
+extern void* pool_alloc(pool_t *pool);
+
+/**
+ * Release a block that was allocated with pool_alloc().
+ * 
+ * @param pool      Pointer to pool object
+ * @param block     Pointer to block; NULL is ignored
+ */
+extern void pool_free(pool_t *pool, void *block);
+
+/**
+ * See if a pointer points to a block of this pool.
+ * 
+ * @param pool      Pointer to pool object
+ * @param block     Pointer to test
+ * 
+ * @retval TRUE     Pointer is the start of a block of this pool
+ * @retval FALSE    Pointer does not belong to this pool
+ */
+extern bool_t pool_owns(const pool_t *pool, const void *block);
+
+/**
+ * Get the number of free blocks.
+ * 
+ * @param pool      Pointer to pool object
+ * 
+ * @return size_t   Number of free blocks
+ */
+extern size_t pool_get_nr_free(const pool_t *pool);
+
+/**
+ * Get the maximum number of blocks that have been in use at the same time.
+ * 
+ * @param pool      Pointer to pool object
+ * 
+ * @return size_t   High-water mark
+ */
+extern size_t pool_get_high_water_mark(const pool_t *pool);
+
+/* _____MACROS_______________________________________________________________ */
+/**
+ * Size of a block rounded up so that each block can hold a free list link 
+ * and is aligned for a pointer.
+ * 
+ * @param size  Requested block size in bytes
+ */
+#define POOL_BLOCK_SIZE(size) \
+    (  (((((size) < sizeof(void*)) ? sizeof(void*) : (size)) + sizeof(void*) - 1) \
+        / sizeof(void*)) * sizeof(void*))
+
+/**
+ * Declare a pool object and its buffer (sized at compile time).
+ * 
+ * @param name          Name of pool object
+ * @param block_size    Size of each block in bytes
+ * @param nr_of_blocks  Number of blocks
+ */
+#define POOL_DECLARE(name, block_size, nr_of_blocks) \
+    static void   *name##_buffer[(POOL_BLOCK_SIZE(block_size)/sizeof(void*))*(nr_of_blocks)]; \
+    static pool_t name; \
+    static const size_t name##_block_size   = (block_size); \
+    static const size_t name##_nr_of_blocks = (nr_of_blocks)
+
+/**
+ * Initialise a pool declared with POOL_DECLARE().
+ * 
+ * @param name          Name of pool object
+ */
+#define POOL_INIT(name) \
+    pool_init(&name, name##_buffer, name##_block_size, name##_nr_of_blocks)
+
+/**
+ * @}
+ */
+#endif
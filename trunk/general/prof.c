@@ -0,0 +1,331 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Execution time profiler
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "prof.h"
+
+#if PROF
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#if !PROF_ISR_SAFE
+#undef  PROF_CRITICAL_BEGIN
+#undef  PROF_CRITICAL_END
+#define PROF_CRITICAL_BEGIN()
+#define PROF_CRITICAL_END()
+#endif
+
+/// Number of times that the timestamp overhead is measured
+#define PROF_OVERHEAD_SAMPLES 8
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+prof_section_t prof_section[PROF_NR_OF_SECTIONS];
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Names of the library sections
+static const char * const prof_names[PROF_ID_USER] = 
+{
+    "uart0",
+    "uart1",
+    "uart2",
+    "hdlc_rx",
+    "crc16",
+    "nmea_rx",
+    "at45d_read",
+    "kbd_scan",
+};
+
+#ifdef PROF_USER_NAMES
+/// Names of the application sections
+static const char * const prof_user_names[PROF_NR_OF_SECTIONS-PROF_ID_USER] = 
+{
+    PROF_USER_NAMES
+};
+#endif
+
+/// Time to read the timestamp; subtracted from each sample
+static u32_t prof_overhead;
+
+/// Pointer to function that will be called to send a character
+static prof_put_char_t prof_put_char;
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Reset the recorded data of a section (a section in progress is kept)
+static void prof_reset_section(prof_section_t *section)
+{
+    u32_t start = section->start;
+
+    memset(section, 0, sizeof(*section));
+    section->start = start;
+    section->min   = 0xffffffff;
+}
+
+/// Number of significant bits of a value, i.e. histogram bin (2^(n-1) <= val < 2^n)
+static u8_t prof_log2(u32_t val)
+{
+    u8_t bits = 0;
+
+    // Skip zero bytes first (fewer 32-bit shifts on 8-bit targets)
+    if(val >= 0x10000)
+    {
+        val  >>= 16;
+        bits  += 16;
+    }
+    if(val >= 0x100)
+    {
+        val  >>= 8;
+        bits  += 8;
+    }
+    while(val != 0)
+    {
+        val >>= 1;
+        bits++;
+    }
+
+    return bits;
+}
+
+/// Send a string
+static void prof_put_str(const char *str)
+{
+    while(*str != '\0')
+    {
+        (*prof_put_char)(*str++);
+    }
+}
+
+/// Send an unsigned decimal number
+static void prof_put_u32(u32_t val)
+{
+    char str[11];
+    u8_t index = sizeof(str) - 1;
+
+    str[index] = '\0';
+    do
+    {
+        str[--index] = '0' + (val % 10);
+        val         /= 10;
+    }
+    while(val != 0);
+
+    prof_put_str(&str[index]);
+}
+
+/// Send name of section
+static void prof_put_name(u8_t id)
+{
+    if(id < PROF_ID_USER)
+    {
+        prof_put_str(prof_names[id]);
+        return;
+    }
+#ifdef PROF_USER_NAMES
+    prof_put_str(prof_user_names[id-PROF_ID_USER]);
+#else
+    prof_put_str("user");
+    prof_put_u32(id - PROF_ID_USER);
+#endif
+}
+
+/// Send recorded data of a section
+static void prof_put_section(u8_t id, const prof_section_t *section)
+{
+    u8_t bin;
+
+    prof_put_name(id);
+    prof_put_str(" n=");
+    prof_put_u32(section->count);
+    prof_put_str(" min=");
+    prof_put_u32(section->min);
+    prof_put_str(" max=");
+    prof_put_u32(section->max);
+    prof_put_str(" mean=");
+    prof_put_u32(section->sum / section->sum_count);
+
+    for(bin=0; bin<PROF_HIST_BINS; bin++)
+    {
+        if(section->hist[bin] == 0)
+        {
+            continue;
+        }
+        if(bin == (PROF_HIST_BINS-1))
+        {
+            prof_put_str(" >=");
+            prof_put_u32((u32_t)1 << (bin-1));
+        }
+        else
+        {
+            prof_put_str(" <");
+            prof_put_u32((u32_t)1 << bin);
+        }
+        (*prof_put_char)(':');
+        prof_put_u32(section->hist[bin]);
+    }
+    (*prof_put_char)('\n');
+    (*prof_put_char)('\r');
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void prof_init(prof_put_char_t put_char)
+{
+    u8_t  i;
+    u32_t start;
+    u32_t delta;
+
+    prof_put_char = put_char;
+    prof_reset();
+
+    // Measure the shortest time between two timestamps
+    prof_overhead = 0xffffffff;
+    for(i=0; i<PROF_OVERHEAD_SAMPLES; i++)
+    {
+        start = PROF_TIMESTAMP();
+        delta = PROF_TIMESTAMP() - start;
+        if(prof_overhead > delta)
+        {
+            prof_overhead = delta;
+        }
+    }
+}
+
+void prof_end(u8_t id, u32_t end)
+{
+    prof_section_t *section = &prof_section[id];
+    u32_t           delta   = end - section->start;
+    u32_t           mean;
+    u8_t            bin;
+
+    // Remove the time to read the timestamp
+    if(delta > prof_overhead)
+    {
+        delta -= prof_overhead;
+    }
+    else
+    {
+        delta = 0;
+    }
+
+    if(section->min > delta)
+    {
+        section->min = delta;
+    }
+    if(section->max < delta)
+    {
+        section->max = delta;
+    }
+
+    // Sum will overflow? Halve its number of samples and keep the mean
+    if((u32_t)(section->sum + delta) < delta)
+    {
+        mean                 = section->sum / section->sum_count;
+        section->sum_count >>= 1;
+        section->sum         = mean * section->sum_count;
+    }
+    section->sum += delta;
+    section->sum_count++;
+    section->count++;
+
+    bin = prof_log2(delta);
+    if(bin >= PROF_HIST_BINS)
+    {
+        bin = PROF_HIST_BINS-1;
+    }
+    // Saturate
+    if(section->hist[bin] != 0xffff)
+    {
+        section->hist[bin]++;
+    }
+}
+
+void prof_reset(void)
+{
+    u8_t id;
+
+    for(id=0; id<PROF_NR_OF_SECTIONS; id++)
+    {
+        PROF_CRITICAL_BEGIN();
+        prof_reset_section(&prof_section[id]);
+        PROF_CRITICAL_END();
+    }
+}
+
+const char* prof_cmd_handler(int argc, char* argv[])
+{
+    u8_t           id;
+    prof_section_t section;
+
+    (void)argv; // Unused
+
+    if(argc != 0)
+    {
+        return "Error: no arguments expected";
+    }
+
+    for(id=0; id<PROF_NR_OF_SECTIONS; id++)
+    {
+        // Take a copy and reset section
+        PROF_CRITICAL_BEGIN();
+        section = prof_section[id];
+        prof_reset_section(&prof_section[id]);
+        PROF_CRITICAL_END();
+
+        if(section.count != 0)
+        {
+            prof_put_section(id, &section);
+        }
+    }
+
+    return "Reset";
+}
+
+#endif
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
@@ -0,0 +1,248 @@
+#ifndef __PROF_H__
+#define __PROF_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Execution time profiler
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup PROF prof.h : Execution time profiler
+ *
+ *  Measures the execution time of marked code sections on the target.
+ *  
+ *  Files: prof.h & prof.c
+ *  
+ *  @par
+ *  A section is marked with PROF_BEGIN() and PROF_END(). For each section 
+ *  the number of samples, the minimum, maximum and mean time and a log2 
+ *  histogram of the time is recorded. Times are measured in counts of 
+ *  #PROF_TIMESTAMP(), which is systmr_get_timestamp() by default (the live
+ *  hardware timer count, e.g. TCNT1 on AVR or the PIT on AT91). It can be 
+ *  redefined in "board.h" to read a cycle counter directly. The time to 
+ *  read the timestamp is measured by prof_init() and subtracted from each 
+ *  sample.
+ *  
+ *  @code
+ *  void hdlc_on_rx_byte(u8_t data)
+ *  {
+ *      PROF_BEGIN(PROF_ID_HDLC_RX);
+ *      ...
+ *      PROF_END(PROF_ID_HDLC_RX);
+ *  }
+ *  @endcode
+ *  
+ *  @par
+ *  If #PROF is 0 (the default), the markers compile away and prof.c is 
+ *  empty, so the markers can stay in the code. The following sections 
+ *  are marked out of the box:
+ *  - the UART interrupt handlers (#PROF_ID_UART0 to #PROF_ID_UART2);
+ *  - hdlc_on_rx_byte() (#PROF_ID_HDLC_RX);
+ *  - crc16_ccitt_calc_data() (#PROF_ID_CRC16);
+ *  - nmea_on_rx_byte() (#PROF_ID_NMEA_RX);
+ *  - at45d_read() (#PROF_ID_AT45D_READ);
+ *  - kbd_matrix_scan() (#PROF_ID_KBD_SCAN).
+ *  
+ *  Application sections are numbered from #PROF_ID_USER. Set 
+ *  #PROF_NR_OF_SECTIONS to make room for them and optionally list their 
+ *  names with PROF_USER_NAMES, e.g. in "board.h":
+ *  @code
+ *  #define PROF                1
+ *  #define PROF_NR_OF_SECTIONS (PROF_ID_USER + 2)
+ *  #define PROF_USER_NAMES     "ctrl", "lcd"
+ *  @endcode
+ *  
+ *  @par
+ *  prof_cmd_handler() is a @ref CMD_LINE command handler that dumps and 
+ *  resets the table, e.g.:
+ *  @code
+ *  >prof
+ *  uart0 n=1200 min=21 max=58 mean=24 <32:1187 <64:13
+ *  hdlc_rx n=1200 min=12 max=402 mean=15 <16:1150 <32:48 <512:2
+ *  @endcode
+ *  Bin "<N" counts the samples of N/2 to N-1 counts.
+ *  
+ *  @par Limitations
+ *  - A section must not be nested in itself (recursion, or the same ID 
+ *    used by two interrupt handlers that can interrupt each other).
+ *  - The time of an interrupt handler that executes during a section is
+ *    included in the sample.
+ *  - If marked sections are executed by interrupt handlers, set 
+ *    #PROF_ISR_SAFE to 1 and define PROF_CRITICAL_BEGIN() and 
+ *    PROF_CRITICAL_END() in "board.h" (see @ref POOL for an example), so 
+ *    that the table is dumped and reset consistently.
+ *  
+ *  Example:
+ *  @include test/prof_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef PROF
+/// Flag to enable the profiler; if 0 the markers compile away
+#define PROF 0
+#endif
+
+/// @name Section IDs of the markers that are included in the library
+//@{
+#define PROF_ID_UART0       0   ///< UART0/USART0 interrupt handlers
+#define PROF_ID_UART1       1   ///< UART1/USART1 interrupt handlers
+#define PROF_ID_UART2       2   ///< UART2 interrupt handlers
+#define PROF_ID_HDLC_RX     3   ///< hdlc_on_rx_byte()
+#define PROF_ID_CRC16       4   ///< crc16_ccitt_calc_data()
+#define PROF_ID_NMEA_RX     5   ///< nmea_on_rx_byte()
+#define PROF_ID_AT45D_READ  6   ///< at45d_read()
+#define PROF_ID_KBD_SCAN    7   ///< kbd_matrix_scan()
+#define PROF_ID_USER        8   ///< First ID of application sections
+//@}
+
+#ifndef PROF_NR_OF_SECTIONS
+/// Number of sections (library and application)
+#define PROF_NR_OF_SECTIONS (PROF_ID_USER + 4)
+#endif
+
+#ifndef PROF_HIST_BINS
+/// Number of histogram bins; the last bin counts all longer samples
+#define PROF_HIST_BINS      16
+#endif
+
+#ifndef PROF_ISR_SAFE
+/// Flag to protect the dump and reset with PROF_CRITICAL_BEGIN() and PROF_CRITICAL_END()
+#define PROF_ISR_SAFE       0
+#endif
+
+#if PROF
+
+#if PROF_ISR_SAFE && !defined(PROF_CRITICAL_BEGIN)
+#error "PROF_CRITICAL_BEGIN() and PROF_CRITICAL_END() must be defined"
+#endif
+
+#ifndef PROF_TIMESTAMP
+#include "systmr.h"
+/// Timestamp that is used to measure the time of a section
+#define PROF_TIMESTAMP()    systmr_get_timestamp()
+#endif
+
+#endif
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/**
+ * Definition for a pointer to a function that will be called to 
+ * send a character of the dump.
+ */
+typedef void (*prof_put_char_t)(char data);
+
+/// Recorded data of a section
+typedef struct
+{
+    u32_t start;                    ///< Timestamp of PROF_BEGIN()
+    u32_t count;                    ///< Number of samples
+    u32_t min;                      ///< Shortest sample
+    u32_t max;                      ///< Longest sample
+    u32_t sum;                      ///< Sum of samples (to calculate mean)
+    u32_t sum_count;                ///< Number of samples in sum (halved to avoid overflow)
+    u16_t hist[PROF_HIST_BINS];     ///< Log2 histogram; bin n counts samples < 2^n
+} prof_section_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+#if PROF
+/// Recorded data of each section
+extern prof_section_t prof_section[PROF_NR_OF_SECTIONS];
+#endif
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+#if PROF
+/**
+ * Initialise profiler. The table is reset and the time to read the 
+ * timestamp is measured.
+ * 
+ * @param put_char  Pointer to a function that will be called to send a 
+ *                  character of the dump
+ */
+extern void prof_init(prof_put_char_t put_char);
+
+/**
+ * Record a sample of a section.
+ * 
+ * Use PROF_END() instead of calling this function directly.
+ * 
+ * @param id        Section ID
+ * @param end       Timestamp at the end of the section
+ */
+extern void prof_end(u8_t id, u32_t end);
+
+/**
+ * Reset the recorded data of all sections.
+ */
+extern void prof_reset(void);
+
+/**
+ * Command line handler that dumps and resets the table.
+ * 
+ * Add it with cmd_line_add(&cmd, "prof", &prof_cmd_handler, "...").
+ * Only sections with samples are listed.
+ * 
+ * @param argc      Number of arguments (must be 0)
+ * @param argv      Arguments
+ * 
+ * @return const char*  Response string
+ */
+extern const char* prof_cmd_handler(int argc, char* argv[]);
+#endif
+
+/* _____MACROS_______________________________________________________________ */
+#if PROF
+/// Mark the start of a section
+#define PROF_BEGIN(id)  {prof_section[id].start = PROF_TIMESTAMP();}
+
+/// Mark the end of a section and record the sample
+#define PROF_END(id)    prof_end(id, PROF_TIMESTAMP())
+#else
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#endif
+
+/**
+ *  @}
+ */
+#endif
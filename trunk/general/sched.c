@@ -0,0 +1,216 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Cooperative task scheduler
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "sched.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// List of tasks
+static sched_task_t *sched_task_list;
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Check if any task has been marked as ready (e.g. by an interrupt handler)
+static bool_t sched_task_is_any_ready(void)
+{
+    sched_task_t *task;
+
+    for(task = sched_task_list; task != NULL; task = task->next)
+    {
+        if(task->ready)
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void sched_init(void)
+{
+    sched_task_list = NULL;
+}
+
+void sched_task_init(sched_task_t         *task,
+                     sched_task_handler_t handler,
+                     void                 *arg)
+{
+    task->handler = handler;
+    task->arg     = arg;
+    task->line    = 0;
+    task->ready   = TRUE;
+    tmr_stop(&task->tmr);
+
+    // Add to end of list so that tasks are called in order that they are added
+    task->next = NULL;
+    if(sched_task_list == NULL)
+    {
+        sched_task_list = task;
+    }
+    else
+    {
+        sched_task_t *last = sched_task_list;
+        while(last->next != NULL)
+        {
+            last = last->next;
+        }
+        last->next = task;
+    }
+}
+
+void sched_task_ready(sched_task_t *task)
+{
+    task->ready = TRUE;
+}
+
+bool_t sched_run_once(void)
+{
+    sched_task_t **link = &sched_task_list;
+    sched_task_t *task;
+    bool_t       task_called = FALSE;
+
+    while(*link != NULL)
+    {
+        task = *link;
+
+        // Task timer expired?
+        if((task->tmr.state == TMR_STARTED) && tmr_has_expired(&task->tmr))
+        {
+            task->ready = TRUE;
+        }
+
+        if(task->ready)
+        {
+            // Clear flag before call so that an event during the call is not lost
+            task->ready = FALSE;
+            task_called = TRUE;
+
+            switch((*task->handler)(task))
+            {
+            case SCHED_YIELDED:
+                task->ready = TRUE;
+                break;
+            case SCHED_EXITED:
+                // Remove task from list
+                *link = task->next;
+                continue;
+            case SCHED_WAITING:
+            default:
+                break;
+            }
+        }
+
+        link = &task->next;
+    }
+
+    return task_called;
+}
+
+tmr_ticks_t sched_get_idle_ticks(void)
+{
+    sched_task_t *task;
+    tmr_ticks_t  elapsed;
+    tmr_ticks_t  ticks = (tmr_ticks_t)(-1);
+
+    for(task = sched_task_list; task != NULL; task = task->next)
+    {
+        if(task->tmr.state != TMR_STARTED)
+        {
+            continue;
+        }
+        elapsed = tmr_ticks_elapsed(&task->tmr);
+        if(elapsed >= task->tmr.delay_in_ticks)
+        {
+            return 0;
+        }
+        if((task->tmr.delay_in_ticks - elapsed) < ticks)
+        {
+            ticks = task->tmr.delay_in_ticks - elapsed;
+        }
+    }
+
+    return ticks;
+}
+
+void sched_run(void)
+{
+    tmr_ticks_t ticks;
+
+    for(;;)
+    {
+        if(sched_run_once())
+        {
+            continue;
+        }
+
+        // Task timer expired?
+        ticks = sched_get_idle_ticks();
+        if(ticks == 0)
+        {
+            continue;
+        }
+
+        // Check again with interrupts disabled so that an event is not missed
+        SCHED_IDLE_DISABLE_IRQ();
+        if(sched_task_is_any_ready())
+        {
+            SCHED_IDLE_ENABLE_IRQ();
+            continue;
+        }
+        SCHED_IDLE(ticks);
+    }
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
@@ -0,0 +1,324 @@
+#ifndef __SCHED_H__
+#define __SCHED_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Cooperative task scheduler
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup SCHED sched.h : Cooperative task scheduler
+ *
+ *  A lightweight, stackless cooperative scheduler (protothreads style).
+ *  
+ *  Files: sched.h & sched.c
+ *  
+ *  @par
+ *  A super-loop that polls every module in turn wastes time on modules that
+ *  have nothing to do, and one blocking function (e.g. a file transfer) 
+ *  starves all the others. With this module, each activity is written as a 
+ *  task function that waits for events with the SCHED_WAIT_...() macros. 
+ *  The scheduler only calls tasks that are ready and calls #SCHED_IDLE() 
+ *  when no task is ready, e.g. to sleep until the next interrupt.
+ *  
+ *  @par
+ *  Tasks are stackless: a task function returns to the scheduler when it 
+ *  waits and resumes on the line after the wait on the next call (the line 
+ *  number is stored in the task object and a switch statement jumps to it). 
+ *  This means that:
+ *  - local variables are NOT preserved across a wait; use static variables 
+ *    or store them in a structure passed with the task argument.
+ *  - a wait may only be used in the task function itself, not in a 
+ *    function that it calls.
+ *  - a switch statement may not be used around a wait.
+ *  - only one wait may be used per source line.
+ *  
+ *  @par
+ *  A task becomes ready when:
+ *  - it yields with SCHED_YIELD();
+ *  - the timer started with SCHED_WAIT_TMR() expires;
+ *  - sched_task_ready() is called, e.g. from an interrupt handler. The UART
+ *    drivers call it when data is received if a task has been set with 
+ *    uart0_set_rx_task() etc.
+ *  
+ *  A waiting task tests its condition again when it becomes ready, so 
+ *  a spurious call to sched_task_ready() is harmless.
+ *  
+ *  Example:
+ *  @include test/sched_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "tmr.h"
+#include "ring_buffer.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef SCHED_IDLE
+/**
+ * Hook that is called by sched_run() when no task is ready.
+ * 
+ * By default the scheduler spins. To save power, define it as 
+ * systmr_idle(ticks) to sleep until the next interrupt, together with
+ * SCHED_IDLE_DISABLE_IRQ() and SCHED_IDLE_ENABLE_IRQ() in "board.h", e.g.
+ * for AVR:
+ * @code
+ * #define SCHED_IDLE(ticks)           systmr_idle(ticks)
+ * #define SCHED_IDLE_DISABLE_IRQ()    cli()
+ * #define SCHED_IDLE_ENABLE_IRQ()     sei()
+ * @endcode
+ * 
+ * The hook is called with interrupts disabled (after the ready flags have 
+ * been checked again) and must enable interrupts and sleep atomically, 
+ * like the "sei; sleep" sequence of systmr_idle(). An interrupt that marks
+ * a task as ready just before the CPU goes to sleep then wakes it up 
+ * immediately instead of after the next timer interrupt.
+ * 
+ * @param ticks     Number of ticks until the first task timer expires; 
+ *                  ((tmr_ticks_t)-1) if no task timer is running
+ */
+#define SCHED_IDLE(ticks)
+#endif
+
+#ifndef SCHED_IDLE_DISABLE_IRQ
+/// Disable interrupts before the last ready check before SCHED_IDLE()
+#define SCHED_IDLE_DISABLE_IRQ()
+#endif
+
+#ifndef SCHED_IDLE_ENABLE_IRQ
+/// Enable interrupts again if a task became ready (SCHED_IDLE() not called)
+#define SCHED_IDLE_ENABLE_IRQ()
+#endif
+
+/// @name Task function return values
+//@{
+#define SCHED_WAITING   0   ///< Task is waiting for an event
+#define SCHED_YIELDED   1   ///< Task gave up the CPU, but is still ready
+#define SCHED_EXITED    2   ///< Task has finished and is removed
+//@}
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+struct sched_task_s;
+
+/**
+ * Definition for a pointer to a task function.
+ * 
+ * @return u8_t     SCHED_WAITING, SCHED_YIELDED or SCHED_EXITED (returned 
+ *                  by the SCHED_...() macros)
+ */
+typedef u8_t (*sched_task_handler_t)(struct sched_task_s *task);
+
+/// Task object
+typedef struct sched_task_s
+{
+    struct sched_task_s  *next;         ///< Next task in list of tasks
+    sched_task_handler_t handler;       ///< Task function
+    void                 *arg;          ///< Task argument
+    u16_t                line;          ///< Line to resume on (0 = start)
+    volatile bool_t      ready;         ///< Flag set when task must be called
+    tmr_t                tmr;           ///< Timer used by SCHED_WAIT_TMR()
+} sched_task_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Initialise scheduler (empty list of tasks).
+ */
+extern void sched_init(void);
+
+/**
+ * Initialise a task and add it to the scheduler.
+ * 
+ * The task is ready, so it will be called on the next pass.
+ * 
+ * @param task      Pointer to task object
+ * @param handler   Task function
+ * @param arg       Task argument (fetched with task->arg)
+ */
+extern void sched_task_init(sched_task_t         *task,
+                            sched_task_handler_t handler,
+                            void                 *arg);
+
+/**
+ * Mark a task as ready so that it will be called on the next pass.
+ * 
+ * May be called from an interrupt handler.
+ * 
+ * @param task      Pointer to task object
+ */
+extern void sched_task_ready(sched_task_t *task);
+
+/**
+ * Call each task that is ready once.
+ * 
+ * @retval TRUE     At least one task was called
+ * @retval FALSE    No task was ready
+ */
+extern bool_t sched_run_once(void);
+
+/**
+ * Get the number of ticks until the first task timer expires.
+ * 
+ * @return tmr_ticks_t  Number of ticks; ((tmr_ticks_t)-1) if no task timer
+ *                      is running
+ */
+extern tmr_ticks_t sched_get_idle_ticks(void);
+
+/**
+ * Run scheduler forever.
+ * 
+ * #SCHED_IDLE() is called when no task is ready.
+ */
+extern void sched_run(void) __attribute__((noreturn));
+
+/* _____MACROS_______________________________________________________________ */
+/**
+ * Same as sched_task_ready(), but avoids the function call overhead in an 
+ * interrupt handler.
+ * 
+ * @param task  Pointer to task object
+ */
+#define SCHED_TASK_READY(task)  do {(task)->ready = TRUE;} while(0)
+
+/**
+ * Start of task function; must be the first statement.
+ * 
+ * @param task  Pointer to task object (task function parameter)
+ */
+#define SCHED_BEGIN(task) \
+    switch((task)->line) \
+    { \
+    case 0:
+
+/**
+ * End of task function; must be the last statement. The task is removed.
+ * 
+ * @param task  Pointer to task object (task function parameter)
+ */
+#define SCHED_END(task) \
+    } \
+    (task)->line = 0; \
+    return SCHED_EXITED
+
+/**
+ * Give other ready tasks a turn.
+ * 
+ * @param task  Pointer to task object (task function parameter)
+ */
+#define SCHED_YIELD(task) \
+    do \
+    { \
+        (task)->line = __LINE__; \
+        return SCHED_YIELDED; \
+    case __LINE__:; \
+    } while(0)
+
+/**
+ * Wait until a condition is TRUE.
+ * 
+ * The condition is tested each time the task is ready, so an event must 
+ * make the task ready with sched_task_ready() (or a task timer must be 
+ * running).
+ * 
+ * @param task  Pointer to task object (task function parameter)
+ * @param cond  Condition to test
+ */
+#define SCHED_WAIT_UNTIL(task, cond) \
+    do \
+    { \
+        while(!(cond)) \
+        { \
+            (task)->line = __LINE__; \
+            return SCHED_WAITING; \
+    case __LINE__:; \
+        } \
+    } while(0)
+
+/**
+ * Wait for a number of ticks.
+ * 
+ * @param task              Pointer to task object (task function parameter)
+ * @param delay_in_ticks    Delay in ticks
+ */
+#define SCHED_WAIT_TMR(task, delay_in_ticks) \
+    do \
+    { \
+        tmr_start(&(task)->tmr, (delay_in_ticks)); \
+        SCHED_WAIT_UNTIL(task, tmr_has_expired(&(task)->tmr)); \
+        tmr_stop(&(task)->tmr); \
+    } while(0)
+
+/**
+ * Wait until a condition is TRUE or a timeout has expired.
+ * 
+ * Use tmr_has_expired(&task->tmr) afterwards to see if the timeout expired.
+ * 
+ * @param task              Pointer to task object (task function parameter)
+ * @param cond              Condition to test
+ * @param timeout_in_ticks  Timeout in ticks
+ */
+#define SCHED_WAIT_UNTIL_TIMEOUT(task, cond, timeout_in_ticks) \
+    do \
+    { \
+        tmr_start(&(task)->tmr, (timeout_in_ticks)); \
+        SCHED_WAIT_UNTIL(task, (cond) || tmr_has_expired(&(task)->tmr)); \
+        if(!tmr_has_expired(&(task)->tmr)) \
+        { \
+            tmr_stop(&(task)->tmr); \
+        } \
+    } while(0)
+
+/**
+ * Wait until a ring buffer contains data.
+ * 
+ * The task must be made ready by the code that writes to the ring buffer.
+ * 
+ * @param task          Pointer to task object (task function parameter)
+ * @param ring_buffer   Pointer to ring buffer
+ */
+#define SCHED_WAIT_RING_BUFFER(task, ring_buffer) \
+    SCHED_WAIT_UNTIL(task, !ring_buffer_empty(ring_buffer))
+
+/**
+ * @}
+ */
+#endif
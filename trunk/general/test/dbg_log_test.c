@@ -0,0 +1,136 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Deferred binary debug log example
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty) and a host "systmr.h" that declares systmr_timestamp_t and
+ * systmr_get_timestamp(). The executable must not be position independent, 
+ * so that the format IDs match the addresses in the ELF file:
+ *   gcc -O2 -no-pie -I. -I<host dir> -DDBG=1 -DDBG_DEFERRED=1 
+ *       -DDBG_LEVEL=DBG_LEVEL_ALL test/dbg_log_test.c dbg_log.c -o dbg_log_test
+ *   ./dbg_log_test > log.bin
+ *   python dbg_log_decode.py dbg_log_test log.bin --int-bits 32
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <time.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "dbg.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Number of messages that are logged to measure the time per message
+#define NR_OF_MSGS 100000
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static systmr_timestamp_t timestamp;
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+/// Simulated timestamp: a sequence number
+systmr_timestamp_t systmr_get_timestamp(void)
+{
+    return ++timestamp;
+}
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static void put_char(char data)
+{
+    putchar(data);
+}
+
+static void discard_char(char data)
+{
+    (void)data;
+}
+
+static double elapsed_ns(struct timespec *start, struct timespec *end)
+{
+    return   (end->tv_sec  - start->tv_sec) * 1e9
+           + (end->tv_nsec - start->tv_nsec);
+}
+
+int main(void)
+{
+    struct timespec start;
+    struct timespec end;
+    int             i;
+    char            str[64];
+
+    // Messages are decoded on the host
+    dbg_log_init(&put_char);
+    DBG_TRACE("Deferred log test\n");
+    DBG_ERR("Error %d\n", -5);
+    DBG_WARN("Warning %u 0x%04X %c\n", 42, 0xbeef, 'x');
+    DBG_PROG("Progress %ld %lu %d %d %d %d\n", -100000L, 3000000000UL, 1, 2, 3, 4);
+    DBG_ASSERT(1 == 1);
+    dbg_log_flush();
+
+    // Fill ring buffer so that records are dropped
+    for(i=0; i<100; i++)
+    {
+        DBG_PROG("Flood %d\n", i);
+    }
+    dbg_log_flush();
+    DBG_PROG("Recovered\n");
+    dbg_log_flush();
+
+    // Measure time to log a message
+    dbg_log_init(&discard_char);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<NR_OF_MSGS; i++)
+    {
+        DBG_PROG("Counter = %d\n", i);
+        dbg_log_service(DBG_LOG_BUFFER_SIZE);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    fprintf(stderr, "Deferred : %.1f ns per message (log and send)\n", 
+            elapsed_ns(&start, &end) / NR_OF_MSGS);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<NR_OF_MSGS; i++)
+    {
+        snprintf(str, sizeof(str), __FILE__ " 100 : Counter = %d\n", i);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    fprintf(stderr, "snprintf : %.1f ns per message (format only)\n", 
+            elapsed_ns(&start, &end) / NR_OF_MSGS);
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Heap and sorted list example and host benchmark
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Compares a binary heap with a sorted list as a priority queue of 
+ * deadlines. The queue is filled with N items (in order) and then the 
+ * earliest item is repeatedly removed and inserted again with a later 
+ * deadline, like a set of periodic timers.
+ * 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty):
+ *   gcc -O2 -I. -I<host dir> test/heap_test.c heap.c list.c -o heap_test
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "heap.h"
+#include "list.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#define NR_OF_OPS   1000ul
+#define PERIOD_MAX  1000
+
+/// Item in heap
+typedef struct
+{
+    heap_item_t item;       ///< Must be first
+    u32_t       deadline;
+} heap_event_t;
+
+/// Item in sorted list
+typedef struct
+{
+    list_item_t item;       ///< Must be first
+    u32_t       deadline;
+} list_event_t;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static double seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static int heap_event_compare(const heap_item_t *item1, const heap_item_t *item2)
+{
+    return (int)(s32_t)(  ((const heap_event_t *)item1)->deadline
+                        - ((const heap_event_t *)item2)->deadline);
+}
+
+static int list_event_compare(const list_item_t *item1, const list_item_t *item2)
+{
+    return (int)(s32_t)(  ((const list_event_t *)item1)->deadline
+                        - ((const list_event_t *)item2)->deadline);
+}
+
+/// Returns ns per operation; 0 on error
+static double heap_benchmark(size_t n)
+{
+    heap_t        heap;
+    heap_item_t   **items  = malloc(n * sizeof(heap_item_t *));
+    heap_event_t  *events  = malloc(n * sizeof(heap_event_t));
+    heap_event_t  *event;
+    u32_t         last     = 0;
+    unsigned long op;
+    size_t        i;
+    double        t;
+
+    srand(1);
+    heap_init(&heap, items, n, &heap_event_compare);
+    for(i=0; i<n; i++)
+    {
+        heap_item_init(&events[i].item);
+        events[i].deadline = (u32_t)(i * PERIOD_MAX / n);
+        heap_insert(&heap, &events[i].item);
+    }
+
+    t = seconds();
+    for(op=0; op<NR_OF_OPS; op++)
+    {
+        event = (heap_event_t *)heap_extract_min(&heap);
+        if(event->deadline < last)
+        {
+            return 0;
+        }
+        last             = event->deadline;
+        event->deadline += 1 + rand() % PERIOD_MAX;
+        heap_insert(&heap, &event->item);
+    }
+    t = seconds() - t;
+
+    // Membership test
+    if(  !heap_item_in_heap(&heap, &events[n/2].item)
+       ||(heap_remove(&heap, &events[n/2].item), heap_item_in_heap(&heap, &events[n/2].item)))
+    {
+        return 0;
+    }
+
+    free(items);
+    free(events);
+
+    return t*1e9/NR_OF_OPS;
+}
+
+/// Returns ns per operation; 0 on error
+static double list_benchmark(size_t n)
+{
+    list_t        list;
+    list_event_t  *events  = malloc(n * sizeof(list_event_t));
+    list_event_t  *event;
+    u32_t         last     = 0;
+    unsigned long op;
+    size_t        i;
+    double        t;
+
+    srand(1);
+    list_init(&list, 0);
+    for(i=0; i<n; i++)
+    {
+        list_item_init(&list, &events[i].item);
+        events[i].deadline = (u32_t)(i * PERIOD_MAX / n);
+        list_insert_sorted(&list, &events[i].item, &list_event_compare);
+    }
+
+    t = seconds();
+    for(op=0; op<NR_OF_OPS; op++)
+    {
+        event = (list_event_t *)list_remove_first_item(&list);
+        if(event->deadline < last)
+        {
+            return 0;
+        }
+        last             = event->deadline;
+        event->deadline += 1 + rand() % PERIOD_MAX;
+        list_insert_sorted(&list, &event->item, &list_event_compare);
+    }
+    t = seconds() - t;
+
+    if(!list_item_in_list(&list, &events[n/2].item))
+    {
+        return 0;
+    }
+
+    free(events);
+
+    return t*1e9/NR_OF_OPS;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+int main(void)
+{
+    static const size_t sizes[] = {10, 1000, 100000};
+    double              t_heap;
+    double              t_list;
+    int                 i;
+    int                 errors = 0;
+
+    printf("    items  heap ns/op  list ns/op\n");
+    for(i=0; i<3; i++)
+    {
+        t_heap = heap_benchmark(sizes[i]);
+        t_list = list_benchmark(sizes[i]);
+        printf("%9lu  %10.1f  %10.1f\n", (unsigned long)sizes[i], t_heap, t_list);
+        if((t_heap == 0) || (t_list == 0))
+        {
+            errors++;
+        }
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Packet buffer example
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty):
+ *   gcc -O2 -I. -I<host dir> test/pbuf_test.c pbuf.c pool.c -o pbuf_test
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "pbuf.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Size of header that is added in front of the packet
+#define HEADER_SIZE 4
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+int main(void)
+{
+    pbuf_t *p;
+    pbuf_t *q;
+    u8_t   data[150];
+    u8_t   copy[sizeof(data) + HEADER_SIZE];
+    u16_t  i;
+    int    errors = 0;
+
+    pbuf_init();
+
+    for(i=0; i<sizeof(data); i++)
+    {
+        data[i] = (u8_t)i;
+    }
+
+    // Receive a packet one piece at a time, with space for a header
+    p = pbuf_alloc(0, HEADER_SIZE);
+    for(i=0; i<sizeof(data); i+=10)
+    {
+        pbuf_append(p, &data[i], 10);
+    }
+    printf("Packet of %u bytes uses %u buffers\n", 
+           p->tot_len,
+           (unsigned)(PBUF_NR_OF_BUFFERS - pbuf_get_nr_free()));
+    if((p->tot_len != sizeof(data)) || (pbuf_get_nr_free() != PBUF_NR_OF_BUFFERS - 3))
+    {
+        errors++;
+    }
+
+    // Add header in front of data (no data is moved)
+    if(!pbuf_header(p, HEADER_SIZE))
+    {
+        errors++;
+    }
+    memcpy(p->payload, "HDR:", HEADER_SIZE);
+    if(pbuf_header(p, 1))
+    {
+        // No more header reserve
+        errors++;
+    }
+
+    // Gather packet
+    if(  (pbuf_copy_out(p, 0, copy, sizeof(copy)) != sizeof(copy))
+       ||(memcmp(copy, "HDR:", HEADER_SIZE) != 0)
+       ||(memcmp(&copy[HEADER_SIZE], data, sizeof(data)) != 0)  )
+    {
+        errors++;
+    }
+
+    // Keep a reference to the last part while the packet is released
+    q = p->next->next;
+    pbuf_ref(q);
+    printf("Released %u buffers\n", pbuf_free(p));
+    if(pbuf_get_nr_free() != PBUF_NR_OF_BUFFERS - 1)
+    {
+        errors++;
+    }
+    pbuf_free(q);
+
+    // One append that fills the last buffer and spills into new buffers
+    p = pbuf_alloc(10, 0);
+    if(pbuf_append(p, data, 140) != 140)
+    {
+        errors++;
+    }
+    i = p->tot_len;
+    for(q = p; q != NULL; q = q->next)
+    {
+        // Total length must be the bytes from this buffer to end of chain
+        if(q->tot_len != i)
+        {
+            printf("Error: tot_len = %u (expected %u)\n", q->tot_len, i);
+            errors++;
+        }
+        i -= q->len;
+    }
+    if((p->tot_len != 150) || (i != 0))
+    {
+        errors++;
+    }
+    pbuf_free(p);
+
+    // Remove trailing checksum from a chain
+    p = pbuf_alloc(2*PBUF_DATA_SIZE + 2, 0);
+    pbuf_trim(p, 2*PBUF_DATA_SIZE);
+    if((p->tot_len != 2*PBUF_DATA_SIZE) || (p->next->next != NULL))
+    {
+        errors++;
+    }
+    pbuf_free(p);
+
+    // Pool exhausted
+    if(pbuf_alloc(PBUF_NR_OF_BUFFERS*PBUF_DATA_SIZE + 1, 0) != NULL)
+    {
+        errors++;
+    }
+
+    printf("%u free, high-water mark = %u\n", 
+           (unsigned)pbuf_get_nr_free(),
+           (unsigned)pbuf_get_high_water_mark());
+    if(pbuf_get_nr_free() != PBUF_NR_OF_BUFFERS)
+    {
+        errors++;
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Memory pool example
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty):
+ *   gcc -O2 -I. -I<host dir> test/pool_test.c pool.c list.c -o pool_test
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "pool.h"
+#include "list.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Message that is queued in a list
+typedef struct
+{
+    list_item_t item;       ///< Must be first
+    u8_t        length;
+    u8_t        data[29];
+} msg_t;
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+POOL_DECLARE(msg_pool, sizeof(msg_t), 4);
+
+static list_t msg_list;
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+int main(void)
+{
+    msg_t *msg;
+    int    i;
+    int    errors = 0;
+
+    POOL_INIT(msg_pool);
+    list_init(&msg_list, 0);
+
+    // Queue messages until the pool is exhausted
+    for(i=0; ; i++)
+    {
+        msg = pool_alloc(&msg_pool);
+        if(msg == NULL)
+        {
+            break;
+        }
+        if(!pool_owns(&msg_pool, msg))
+        {
+            errors++;
+        }
+        list_item_init(&msg_list, &msg->item);
+        msg->length = (u8_t)sprintf((char *)msg->data, "Message %d", i);
+        list_add_to_end(&msg_list, &msg->item);
+    }
+    printf("%d messages queued, %u free\n", i, (unsigned)pool_get_nr_free(&msg_pool));
+    if(i != 4)
+    {
+        errors++;
+    }
+
+    // Process and release two messages
+    for(i=0; i<2; i++)
+    {
+        msg = (msg_t *)list_first_item(&msg_list);
+        list_remove_item(&msg_list, &msg->item);
+        printf("%s\n", msg->data);
+        pool_free(&msg_pool, msg);
+    }
+    printf("%u free, high-water mark = %u\n", 
+           (unsigned)pool_get_nr_free(&msg_pool),
+           (unsigned)pool_get_high_water_mark(&msg_pool));
+    if(  (pool_get_nr_free(&msg_pool) != 2) 
+       ||(pool_get_high_water_mark(&msg_pool) != 4))
+    {
+        errors++;
+    }
+
+    // Pointer inside a block is not a block
+    if(pool_owns(&msg_pool, (u8_t *)msg + 1))
+    {
+        errors++;
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
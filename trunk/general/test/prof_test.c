@@ -0,0 +1,131 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          prof.h test
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty) and a host "systmr.h" that declares systmr_timestamp_t and
+ * systmr_get_timestamp():
+ *   gcc -O2 -I. -I<host dir> -DPROF=1 test/prof_test.c prof.c -o prof_test
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "prof.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Simulated time to read the timestamp
+#define TIMESTAMP_OVERHEAD  3
+
+/// Application section
+#define PROF_ID_CTRL        PROF_ID_USER
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Simulated hardware timer
+static u32_t timer_count;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static void put_char(char data)
+{
+    putchar(data);
+}
+
+/// Simulate a section that executes for the specified number of counts
+static void ctrl_update(u32_t counts)
+{
+    PROF_BEGIN(PROF_ID_CTRL);
+    timer_count += counts;
+    PROF_END(PROF_ID_CTRL);
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+systmr_timestamp_t systmr_get_timestamp(void)
+{
+    u32_t count = timer_count;
+
+    timer_count += TIMESTAMP_OVERHEAD;
+
+    return count;
+}
+
+int main(void)
+{
+    int i;
+    int errors = 0;
+
+    prof_init(&put_char);
+
+    for(i=0; i<100; i++)
+    {
+        ctrl_update(40 + (i % 10));
+    }
+    ctrl_update(1000);
+
+    if(  (prof_section[PROF_ID_CTRL].count != 101 )
+       ||(prof_section[PROF_ID_CTRL].min   != 40  )
+       ||(prof_section[PROF_ID_CTRL].max   != 1000)
+       ||(prof_section[PROF_ID_CTRL].hist[6]  != 100)
+       ||(prof_section[PROF_ID_CTRL].hist[10] != 1  )  )
+    {
+        errors++;
+    }
+
+    // Dump and reset
+    printf("%s\n", prof_cmd_handler(0, NULL));
+    if(prof_section[PROF_ID_CTRL].count != 0)
+    {
+        errors++;
+    }
+
+    // Sum overflows: mean stays valid and n is still the number of samples
+    for(i=0; i<10; i++)
+    {
+        ctrl_update(0x40000000);
+    }
+    if(  (prof_section[PROF_ID_CTRL].count != 10)
+       ||(  prof_section[PROF_ID_CTRL].sum / prof_section[PROF_ID_CTRL].sum_count
+          != 0x40000000)                                                      )
+    {
+        errors++;
+    }
+    printf("%s\n", prof_cmd_handler(0, NULL));
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Cooperative scheduler example and host benchmark
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Three tasks:
+ * - a periodic task that waits on a timer;
+ * - a receive task that waits for data in a ring buffer, which is written 
+ *   and made ready by a simulated receive interrupt;
+ * - two tasks that yield to each other to measure the cost of a context 
+ *   switch.
+ * 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty) and a host "systmr.h" that declares systmr_ticks_t, 
+ * SYSTMR_TICKS_PER_SEC and systmr_get_counter():
+ *   gcc -O2 -I. -I<host dir> test/sched_test.c sched.c tmr.c ring_buffer.c
+ *       -o sched_test
+ * 
+ * On a target, the receive task would be made ready by the UART driver 
+ * instead (see uart0_set_rx_task()) and sched_run() would be called.
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <time.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "sched.h"
+#include "tmr.h"
+#include "ring_buffer.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#define NR_OF_SWITCHES  10000000ul
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static systmr_ticks_t sim_tick_counter;
+
+static sched_task_t   blink_task;
+static sched_task_t   rx_task;
+static sched_task_t   ping_task;
+static sched_task_t   pong_task;
+
+static ring_buffer_t  rx_ring_buffer;
+static u8_t           rx_buffer[16];
+
+static unsigned long  blink_count;
+static unsigned long  rx_count;
+static unsigned long  switch_count;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static double seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+/// Periodic task
+static u8_t blink_task_handler(sched_task_t *task)
+{
+    SCHED_BEGIN(task);
+
+    for(;;)
+    {
+        SCHED_WAIT_TMR(task, TMR_MS_TO_TICKS(500));
+        blink_count++;
+    }
+
+    SCHED_END(task);
+}
+
+/// Receive task: echo received data
+static u8_t rx_task_handler(sched_task_t *task)
+{
+    static u8_t data;
+
+    SCHED_BEGIN(task);
+
+    for(;;)
+    {
+        SCHED_WAIT_UNTIL(task, ring_buffer_read_byte(&rx_ring_buffer, &data));
+        rx_count++;
+        printf("%c", data);
+    }
+
+    SCHED_END(task);
+}
+
+/// Simulated receive interrupt handler
+static void sim_rx_isr(u8_t data)
+{
+    ring_buffer_write_byte(&rx_ring_buffer, data);
+    SCHED_TASK_READY(&rx_task);
+}
+
+/// Task that yields a fixed number of times and then exits
+static u8_t yield_task_handler(sched_task_t *task)
+{
+    SCHED_BEGIN(task);
+
+    while(switch_count < NR_OF_SWITCHES)
+    {
+        switch_count++;
+        SCHED_YIELD(task);
+    }
+
+    SCHED_END(task);
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+systmr_ticks_t systmr_get_counter(void)
+{
+    return sim_tick_counter;
+}
+
+int main(void)
+{
+    const char   *str = "Hello\n";
+    unsigned long tick;
+    double        t;
+
+    ring_buffer_init(&rx_ring_buffer, rx_buffer, sizeof(rx_buffer));
+
+    // Simulate 5 seconds; a character is received every 100 ms
+    sched_init();
+    sched_task_init(&blink_task, &blink_task_handler, NULL);
+    sched_task_init(&rx_task,    &rx_task_handler,    NULL);
+    for(tick=0; tick <= 5*TMR_TICKS_PER_SEC; tick++)
+    {
+        if(((tick % TMR_MS_TO_TICKS(100)) == 0) && (*str != '\0'))
+        {
+            sim_rx_isr(*str++);
+        }
+        while(sched_run_once())
+        {
+            ;
+        }
+        sim_tick_counter++;
+    }
+    printf("blink=%lu rx=%lu\n", blink_count, rx_count);
+
+    // Context switch benchmark: only ping and pong tasks are ready
+    sched_init();
+    sched_task_init(&ping_task, &yield_task_handler, NULL);
+    sched_task_init(&pong_task, &yield_task_handler, NULL);
+    t = seconds();
+    while(sched_run_once())
+    {
+        ;
+    }
+    t = seconds() - t;
+    printf("%lu switches, %.1f ns/switch\n", switch_count, t*1e9/switch_count);
+
+    return ((blink_count == 10) && (rx_count == 6)) ? 0 : 1;
+}
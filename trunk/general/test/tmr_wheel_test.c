@@ -0,0 +1,150 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Timer wheel example and host benchmark
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Compares the cost of 10000 active timers with the timer wheel against 
+ * polling 10000 tmr_t timers with tmr_has_expired() on every tick.
+ * 
+ * Build on a PC (from the "trunk/general" directory), with a host "board.h"
+ * (may be empty) and a host "systmr.h" that declares systmr_ticks_t, 
+ * SYSTMR_TICKS_PER_SEC and systmr_get_counter():
+ *   gcc -O2 -I. -I<host dir> test/tmr_wheel_test.c tmr_wheel.c tmr.c 
+ *       -o tmr_wheel_test
+ * 
+ * The system tick is simulated, so the benchmark measures only the timer 
+ * processing cost per tick.
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "tmr.h"
+#include "tmr_wheel.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#define NR_OF_TIMERS    10000
+#define NR_OF_TICKS     100000ul
+#define DELAY_MAX       2000
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static systmr_ticks_t sim_tick_counter;
+
+static tmr_wheel_t    wheel_tmr[NR_OF_TIMERS];
+static tmr_t          poll_tmr[NR_OF_TIMERS];
+
+static unsigned long  wheel_expired;
+static unsigned long  poll_expired;
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static double seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+/// Periodic timer handler
+static void wheel_handler(tmr_wheel_t *tmr)
+{
+    wheel_expired++;
+    tmr_wheel_reset(tmr);
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+systmr_ticks_t systmr_get_counter(void)
+{
+    return sim_tick_counter;
+}
+
+int main(void)
+{
+    unsigned long tick;
+    int           i;
+    double        t;
+    double        t_wheel;
+    double        t_poll;
+
+    // Timer wheel: all timers are periodic with a random period
+    srand(1);
+    tmr_wheel_init();
+    for(i=0; i<NR_OF_TIMERS; i++)
+    {
+        tmr_wheel_init_tmr(&wheel_tmr[i], &wheel_handler, NULL);
+        tmr_wheel_start(&wheel_tmr[i], 1 + rand() % DELAY_MAX);
+    }
+    t = seconds();
+    for(tick=0; tick<NR_OF_TICKS; tick++)
+    {
+        sim_tick_counter++;
+        tmr_wheel_service();
+    }
+    t_wheel = seconds() - t;
+
+    // Polled timers with the same periods
+    srand(1);
+    sim_tick_counter = 0;
+    for(i=0; i<NR_OF_TIMERS; i++)
+    {
+        tmr_start(&poll_tmr[i], 1 + rand() % DELAY_MAX);
+    }
+    t = seconds();
+    for(tick=0; tick<NR_OF_TICKS; tick++)
+    {
+        sim_tick_counter++;
+        for(i=0; i<NR_OF_TIMERS; i++)
+        {
+            if(tmr_has_expired(&poll_tmr[i]))
+            {
+                poll_expired++;
+                tmr_reset(&poll_tmr[i]);
+            }
+        }
+    }
+    t_poll = seconds() - t;
+
+    printf("%d timers, %lu ticks\n", NR_OF_TIMERS, NR_OF_TICKS);
+    printf("tmr_wheel : %lu expired, %.3f us/tick\n", wheel_expired, t_wheel*1e6/NR_OF_TICKS);
+    printf("tmr (poll): %lu expired, %.3f us/tick\n", poll_expired,  t_poll*1e6/NR_OF_TICKS);
+
+    return (wheel_expired == poll_expired) ? 0 : 1;
+}
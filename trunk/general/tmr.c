@@ -114,9 +114,10 @@ void tmr_wait(const tmr_ticks_t delay_in_ticks)
 
     while (!tmr_has_expired(&tmr))
     {
-        ;
+        TMR_IDLE(delay_in_ticks - tmr_ticks_elapsed(&tmr));
     }
 }
+
 tmr_ticks_t tmr_ticks_elapsed(tmr_t *tmr)
 {
     // Fetch current time
@@ -134,5 +135,8 @@ tmr_ticks_t tmr_ticks_elapsed(tmr_t *tmr)
  2010-04-21 : Pieter.Conradie
  - Moved from "tmr_glue.h" to "systmr.h"
  - Added tmr_ticks_elapsed(...)
+
+ 2026/10/19 : agent
+ - Added TMR_IDLE() hook to tmr_wait()
    
 */
@@ -75,6 +75,17 @@
 /// The number of timer ticks per second
 #define TMR_TICKS_PER_SEC   SYSTMR_TICKS_PER_SEC
 
+#ifndef TMR_IDLE
+/**
+ * Hook that is called by tmr_wait() with the number of ticks remaining.
+ * 
+ * By default the CPU spins. To save power, define it as 
+ * systmr_idle(ticks_remaining) to sleep until the next interrupt (or 
+ * deadline in tickless mode).
+ */
+#define TMR_IDLE(ticks_remaining)
+#endif
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /// Size definition of the tick counter
 typedef systmr_ticks_t tmr_ticks_t;
@@ -162,6 +173,8 @@ extern void tmr_reset(tmr_t *tmr);
 /** 
  *  Blocking wait for specified number of ticks.
  *  
+ *  #TMR_IDLE() is called while waiting.
+ *  
  *  @param[in]  delay_in_ticks    Delay in timer ticks
  */ 
 extern void tmr_wait(const tmr_ticks_t delay_in_ticks);
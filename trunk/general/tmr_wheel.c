@@ -0,0 +1,338 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Hierarchical timer wheel with callbacks
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "tmr_wheel.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Number of slots per level
+#define TMR_WHEEL_SLOTS     (1 << TMR_WHEEL_BITS)
+
+/// Mask to calculate slot index
+#define TMR_WHEEL_MASK      (TMR_WHEEL_SLOTS - 1)
+
+#if ((TMR_WHEEL_BITS * (TMR_WHEEL_LEVELS - 1)) >= (8 * 4))
+#error "TMR_WHEEL_BITS x (TMR_WHEEL_LEVELS-1) must be less than 32"
+#endif
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Slots (head of list of timers) of each level
+static tmr_wheel_t *tmr_wheel_slot[TMR_WHEEL_LEVELS][TMR_WHEEL_SLOTS];
+
+/// Next tick to process; all timers before this tick have expired
+static tmr_ticks_t tmr_wheel_next_tick;
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Add timer to slot that corresponds to tmr->expire_tick
+static void tmr_wheel_insert(tmr_wheel_t *tmr)
+{
+    tmr_ticks_t delta;
+    tmr_ticks_t index;
+    u8_t        level;
+    tmr_wheel_t **slot;
+
+    // Number of ticks from the next tick to process up to expiry
+    delta = tmr->expire_tick - tmr_wheel_next_tick;
+    if(delta == (tmr_ticks_t)(-1))
+    {
+        // Expiry tick has already been processed; expire on next tick
+        level = 0;
+        index = tmr_wheel_next_tick;
+    }
+    else
+    {
+        // Find lowest level that covers delay
+        for(level=0; level < (TMR_WHEEL_LEVELS-1); level++)
+        {
+            if((delta >> (TMR_WHEEL_BITS*(level+1))) == 0)
+            {
+                break;
+            }
+        }
+        if((delta >> (TMR_WHEEL_BITS*level)) <= TMR_WHEEL_MASK)
+        {
+            index = tmr->expire_tick >> (TMR_WHEEL_BITS*level);
+        }
+        else
+        {
+            // Delay too long; park in last slot to be visited of top level
+            index = (tmr_wheel_next_tick >> (TMR_WHEEL_BITS*level)) - 1;
+        }
+    }
+
+    // Add to start of slot list
+    slot       = &tmr_wheel_slot[level][index & TMR_WHEEL_MASK];
+    tmr->next  = *slot;
+    tmr->pprev = slot;
+    if(tmr->next != NULL)
+    {
+        tmr->next->pprev = &tmr->next;
+    }
+    *slot = tmr;
+}
+
+/// Move timers in a higher level slot to the lower levels
+static void tmr_wheel_cascade(u8_t level, u8_t index)
+{
+    tmr_wheel_t *tmr;
+    tmr_wheel_t *next;
+
+    // Detach list from slot
+    tmr = tmr_wheel_slot[level][index];
+    tmr_wheel_slot[level][index] = NULL;
+
+    while(tmr != NULL)
+    {
+        next = tmr->next;
+        tmr_wheel_insert(tmr);
+        tmr = next;
+    }
+}
+
+/// Process one tick (tmr_wheel_next_tick)
+static void tmr_wheel_process_tick(void)
+{
+    tmr_ticks_t tick  = tmr_wheel_next_tick;
+    u8_t        index = tick & TMR_WHEEL_MASK;
+    u8_t        level;
+    u8_t        cascade_index;
+    tmr_wheel_t *expired;
+    tmr_wheel_t *tmr;
+
+    // Level 0 wrapped? Cascade next slot of higher level(s)
+    if(index == 0)
+    {
+        for(level=1; level<TMR_WHEEL_LEVELS; level++)
+        {
+            cascade_index = (tick >> (TMR_WHEEL_BITS*level)) & TMR_WHEEL_MASK;
+            tmr_wheel_cascade(level, cascade_index);
+            if(cascade_index != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Detach list of expired timers from slot
+    expired = tmr_wheel_slot[0][index];
+    tmr_wheel_slot[0][index] = NULL;
+    if(expired != NULL)
+    {
+        expired->pprev = &expired;
+    }
+
+    // Timers that are (re)started by handlers must not be added to this tick
+    tmr_wheel_next_tick = tick + 1;
+
+    // Handler may stop other expired timers, so remove one at a time
+    while(expired != NULL)
+    {
+        tmr = expired;
+        tmr_wheel_stop(tmr);
+        (*tmr->handler)(tmr);
+    }
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void tmr_wheel_init(void)
+{
+    u8_t level;
+    u8_t index;
+
+    for(level=0; level<TMR_WHEEL_LEVELS; level++)
+    {
+        for(index=0; index<TMR_WHEEL_SLOTS; index++)
+        {
+            tmr_wheel_slot[level][index] = NULL;
+        }
+    }
+
+    tmr_wheel_next_tick = systmr_get_counter() + 1;
+}
+
+void tmr_wheel_init_tmr(tmr_wheel_t         *tmr,
+                        tmr_wheel_handler_t handler,
+                        void                *arg)
+{
+    tmr->next           = NULL;
+    tmr->pprev          = NULL;
+    tmr->expire_tick    = 0;
+    tmr->delay_in_ticks = 0;
+    tmr->handler        = handler;
+    tmr->arg            = arg;
+}
+
+void tmr_wheel_start(tmr_wheel_t *tmr, const tmr_ticks_t delay_in_ticks)
+{
+    // Save delay in case timer is restarted
+    tmr->delay_in_ticks = delay_in_ticks;
+
+    tmr_wheel_restart(tmr);
+}
+
+void tmr_wheel_stop(tmr_wheel_t *tmr)
+{
+    if(tmr->pprev == NULL)
+    {
+        return;
+    }
+
+    // Unlink
+    *tmr->pprev = tmr->next;
+    if(tmr->next != NULL)
+    {
+        tmr->next->pprev = tmr->pprev;
+    }
+    tmr->next  = NULL;
+    tmr->pprev = NULL;
+}
+
+void tmr_wheel_restart(tmr_wheel_t *tmr)
+{
+    tmr_wheel_stop(tmr);
+
+    tmr->expire_tick = systmr_get_counter() + tmr->delay_in_ticks;
+    tmr_wheel_insert(tmr);
+}
+
+void tmr_wheel_reset(tmr_wheel_t *tmr)
+{
+    tmr_wheel_stop(tmr);
+
+    tmr->expire_tick += tmr->delay_in_ticks;
+    tmr_wheel_insert(tmr);
+}
+
+bool_t tmr_wheel_is_running(const tmr_wheel_t *tmr)
+{
+    return (tmr->pprev != NULL);
+}
+
+void tmr_wheel_service(void)
+{
+    tmr_ticks_t tick = systmr_get_counter();
+
+    // Process all ticks up to and including the current tick
+    while(tmr_wheel_next_tick != (tmr_ticks_t)(tick + 1))
+    {
+        tmr_wheel_process_tick();
+    }
+}
+
+bool_t tmr_wheel_next_deadline(tmr_ticks_t *ticks)
+{
+    u8_t        level;
+    u8_t        offset;
+    tmr_ticks_t tick;
+    tmr_ticks_t step;
+    tmr_wheel_t *tmr;
+    tmr_ticks_t deadline     = 0;
+    bool_t      deadline_set = FALSE;
+    tmr_ticks_t now          = systmr_get_counter();
+
+    for(level=0; level<TMR_WHEEL_LEVELS; level++)
+    {
+        // First tick on which a slot of this level is visited
+        step = (tmr_ticks_t)1 << (TMR_WHEEL_BITS*level);
+        tick = (tmr_wheel_next_tick + step - 1) & ~(step - 1);
+
+        // Find first slot that is not empty
+        for(offset=0; offset<TMR_WHEEL_SLOTS; offset++)
+        {
+            tmr = tmr_wheel_slot[level][(tick >> (TMR_WHEEL_BITS*level)) & TMR_WHEEL_MASK];
+            if(tmr != NULL)
+            {
+                break;
+            }
+            tick += step;
+        }
+
+        // Earliest timer in slot (a level 0 slot expires on a single tick)
+        while(tmr != NULL)
+        {
+            if(level != 0)
+            {
+                tick = tmr->expire_tick;
+            }
+            if(  (!deadline_set)
+               ||((tmr_ticks_t)(tick - tmr_wheel_next_tick) < (tmr_ticks_t)(deadline - tmr_wheel_next_tick)))
+            {
+                deadline     = tick;
+                deadline_set = TRUE;
+            }
+            if(level == 0)
+            {
+                break;
+            }
+            tmr = tmr->next;
+        }
+    }
+
+    if(!deadline_set)
+    {
+        return FALSE;
+    }
+
+    // Deadline passed? (processing is behind)
+    if((tmr_ticks_t)(deadline - tmr_wheel_next_tick) < (tmr_ticks_t)(now - tmr_wheel_next_tick + 1))
+    {
+        *ticks = 0;
+    }
+    else
+    {
+        *ticks = deadline - now;
+    }
+
+    return TRUE;
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+ - Added tmr_wheel_next_deadline()
+   
+*/
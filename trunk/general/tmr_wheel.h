@@ -0,0 +1,236 @@
+#ifndef __TMR_WHEEL_H__
+#define __TMR_WHEEL_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Hierarchical timer wheel with callbacks
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup GENERAL
+ *  @defgroup TMR_WHEEL tmr_wheel.h : Hierarchical timer wheel with callbacks
+ *
+ *  Software timers that call a function when they expire, without polling
+ *  each timer.
+ *  
+ *  Files: tmr_wheel.h & tmr_wheel.c
+ *  
+ *  @par
+ *  With @ref TMR each timer must be polled with tmr_has_expired(), so the 
+ *  cost of a pass through the main loop grows with the number of timers. 
+ *  Here timers are sorted into buckets ("slots") by expiry tick and 
+ *  tmr_wheel_service() only visits the slot of the current tick. Start, 
+ *  stop and restart are O(1) and expiry processing is O(expired timers) 
+ *  per tick.
+ *  
+ *  @par
+ *  There are #TMR_WHEEL_LEVELS wheels ("levels") of 2^#TMR_WHEEL_BITS 
+ *  slots each. Level 0 has one slot per tick, level 1 one slot per 
+ *  2^#TMR_WHEEL_BITS ticks, etc. A timer is added to the lowest level that
+ *  covers its delay. Each time that a lower level wraps, the timers in the
+ *  next slot of the higher level are moved down ("cascaded"). Each timer
+ *  is moved at most #TMR_WHEEL_LEVELS-1 times. A delay that is longer 
+ *  than the wheels cover is parked in the last slot of the top level and 
+ *  re-evaluated when it is cascaded.
+ *  
+ *  @par
+ *  A slot is the head pointer of a list. Each timer holds a pointer to the
+ *  pointer that links to it, so it can be removed in O(1) without a list
+ *  structure per slot. The wheels use 2^#TMR_WHEEL_BITS x #TMR_WHEEL_LEVELS
+ *  pointers of RAM (128 bytes on an AVR with the default settings).
+ *  
+ *  @par
+ *  The wheel is driven by systmr_get_counter(). tmr_wheel_service() must be
+ *  called from the main loop; it processes all of the ticks that have 
+ *  elapsed since the previous call and calls the handlers of the expired 
+ *  timers, so handlers execute in the main loop context and not in the 
+ *  timer interrupt. A handler may start, stop or reset any timer, 
+ *  including its own.
+ *  
+ *  @par
+ *  tmr_wheel_next_deadline() returns the number of ticks until the next 
+ *  timer expires, so that the CPU can sleep until then (see systmr_idle()).
+ *  
+ *  @see http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf
+ *  
+ *  Example:
+ *  @include test/tmr_wheel_test.c
+ * 
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stddef.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "tmr.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef TMR_WHEEL_BITS
+/// Number of bits of the tick counter per level (2^TMR_WHEEL_BITS slots per level)
+#define TMR_WHEEL_BITS      4
+#endif
+
+#ifndef TMR_WHEEL_LEVELS
+/// Number of levels; delays up to 2^(TMR_WHEEL_BITS*TMR_WHEEL_LEVELS)-1 ticks are sorted directly
+#define TMR_WHEEL_LEVELS    4
+#endif
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+struct tmr_wheel_s;
+
+/**
+ * Definition for a pointer to a function that will be called when a 
+ * timer expires.
+ * 
+ * @param tmr   Pointer to the timer that expired
+ */
+typedef void (*tmr_wheel_handler_t)(struct tmr_wheel_s *tmr);
+
+/// Structure to track state of a timer
+typedef struct tmr_wheel_s
+{
+    struct tmr_wheel_s  *next;          ///< Next timer in slot
+    struct tmr_wheel_s  **pprev;        ///< Pointer that links to this timer; NULL if stopped
+    tmr_ticks_t         expire_tick;    ///< Tick on which timer expires
+    tmr_ticks_t         delay_in_ticks; ///< Timer delay
+    tmr_wheel_handler_t handler;        ///< Function to call when timer expires
+    void                *arg;           ///< Application data for handler
+} tmr_wheel_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/** 
+ *  Initialise timer wheel.
+ *  
+ *  All timers are discarded.
+ */
+extern void tmr_wheel_init(void);
+
+/** 
+ *  Initialise a timer object (stopped).
+ *
+ *  @param[out] tmr         Pointer to a timer object
+ *  @param[in]  handler     Function to call when timer expires
+ *  @param[in]  arg         Application data for handler (tmr->arg)
+ */
+extern void tmr_wheel_init_tmr(tmr_wheel_t         *tmr,
+                               tmr_wheel_handler_t handler,
+                               void                *arg);
+
+/** 
+ *  Start (or restart with a new delay) a timer.
+ *
+ *  The timer expires when the tick counter reaches the current value +
+ *  delay_in_ticks; a delay of 0 expires on the next tick. The delay plus 
+ *  the maximum latency of tmr_wheel_service() must be less than the range
+ *  of #tmr_ticks_t.
+ *
+ *  @param[in,out]  tmr            Pointer to a timer object
+ *  @param[in]      delay_in_ticks Delay in timer ticks
+ */
+extern void tmr_wheel_start(tmr_wheel_t *tmr, const tmr_ticks_t delay_in_ticks);
+
+/** 
+ *  Stop a timer.
+ *  
+ *  Stopping a timer that is not running has no effect.
+ *  
+ *  @param[in,out] tmr    Pointer to a timer object
+ */
+extern void tmr_wheel_stop(tmr_wheel_t *tmr);
+
+/** 
+ *  Restart a timer with the delay set with tmr_wheel_start().
+ * 
+ *  The timer will expire on the current timer tick + tmr->delay_in_ticks.
+ *  
+ *  @param[in,out]  tmr   Pointer to a timer object
+ */    
+extern void tmr_wheel_restart(tmr_wheel_t *tmr);
+
+/** 
+ *  Reset a timer with the delay set with tmr_wheel_start().
+ * 
+ *  The timer will expire on the previous expiry tick + tmr->delay_in_ticks.
+ *  Call this function from the handler of a periodic timer, so that the 
+ *  period does not drift if tmr_wheel_service() is called late.
+ *  
+ *  @param[in,out]  tmr   Pointer to a timer object
+ */    
+extern void tmr_wheel_reset(tmr_wheel_t *tmr);
+
+/** 
+ *  See if a timer is running.
+ *  
+ *  @param[in]  tmr   Pointer to a timer object
+ *  
+ *  @retval TRUE    timer is running
+ *  @retval FALSE   timer is stopped or has expired
+ */
+extern bool_t tmr_wheel_is_running(const tmr_wheel_t *tmr);
+
+/** 
+ *  Process all ticks that have elapsed since the previous call and call
+ *  the handlers of the timers that have expired.
+ *  
+ *  This function must be called from the main loop.
+ */
+extern void tmr_wheel_service(void);
+
+/** 
+ *  Get the number of ticks until tmr_wheel_service() must be called again.
+ *  
+ *  This is used to sleep until the next deadline, e.g. with systmr_idle() 
+ *  in tickless mode. The first occupied slot of each level is searched, so
+ *  the cost is at most #TMR_WHEEL_SLOTS slots per level plus the timers in 
+ *  those slots.
+ *  
+ *  @param[out] ticks   Number of ticks from now (0 if a deadline has passed)
+ *  
+ *  @retval TRUE    A timer is running
+ *  @retval FALSE   No timers are running
+ */
+extern bool_t tmr_wheel_next_deadline(tmr_ticks_t *ticks);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ *  @}
+ */
+#endif
@@ -73,6 +73,20 @@ static char* cmd_line_argv[CMDL_ARGV_MAX];
 static u8_t cmd_line_buffer_index;
 static char cmd_line_buffer[CMDL_LINE_LENGTH_MAX];
 
+/// Flag to indicate that batch (non-interactive) mode is enabled
+static bool_t cmd_line_batch_mode;
+
+/// Flag to indicate that the current line exceeded the buffer size (batch mode)
+static bool_t cmd_line_overflow;
+
+/// Separate line buffer for cmd_line_exec_buffer(), so that interactive input is not affected
+static u8_t   cmd_line_exec_line_index;
+static char   cmd_line_exec_line[CMDL_LINE_LENGTH_MAX];
+static bool_t cmd_line_exec_overflow;
+
+/// Flag to indicate that cmd_line_exec_buffer() is busy (no nested scripts)
+static bool_t cmd_line_exec_busy;
+
 /// Buffer for history
 static u8_t cmd_line_hist_index;
 static char cmd_line_hist[CMDL_HISTORY_SIZE];
@@ -89,6 +103,12 @@ static const char cmd_line_str_prompt[] = ">";
 /// Command not found string
 static const char cmd_line_str_cmd_not_found[] = "Error! Command not found\n\r";
 
+/// Line too long string
+static const char cmd_line_str_line_too_long[] = "Error! Line too long\n\r";
+
+/// Prefix of string returned by a command handler to indicate failure
+static const char cmd_line_str_error[] = "Error";
+
 /// Terminal delete instructions (to remove last character from display)
 static const char cmd_line_str_del[] = {VT100_BS,' ',VT100_BS};
 
@@ -130,7 +150,7 @@ static void cmd_line_save_hist(const char *cmd_str)
 {
 }
 
-static void cmd_line_invoke(char *cmd_str)
+static bool_t cmd_line_invoke(char *cmd_str)
 {
     cmd_line_t *cmd;
     int        argc         = 0;
@@ -156,6 +176,12 @@ static void cmd_line_invoke(char *cmd_str)
                 cmd_char++;
             }
 
+            // Stop if the maximum number of arguments has been reached
+            if(argc == CMDL_ARGV_MAX)
+            {
+                break;
+            }
+
             // Mark next token string
             cmd_line_argv[argc++] = cmd_char;
         }
@@ -176,7 +202,7 @@ static void cmd_line_invoke(char *cmd_str)
     // Ignore empty command
     if(argc == 0)
     {
-        return;
+        return TRUE;
     }
     
     // Find command
@@ -202,14 +228,29 @@ static void cmd_line_invoke(char *cmd_str)
                 if(cmd->handler)
                 {
                     display_str = (*(cmd->handler))(argc-arg_index-1, &cmd_line_argv[arg_index+1]);
-                    if(display_str != NULL)
+
+                    // Only display returned string in interactive mode
+                    if(!cmd_line_batch_mode)
                     {
-                        // Display returned string from command handler
-                        cmd_line_send_str(display_str);                        
+                        if(display_str != NULL)
+                        {
+                            // Display returned string from command handler
+                            cmd_line_send_str(display_str);                        
+                        }
+                        cmd_line_send_new_line();
+                    }
+                    // Report error in batch mode (with offending command)
+                    else if(  (display_str != NULL)
+                            &&(strncmp(display_str, cmd_line_str_error, sizeof(cmd_line_str_error)-1) == 0))
+                    {
+                        cmd_line_send_str(cmd->name);
+                        (*cmd_line_put_char)(' ');
+                        cmd_line_send_str(display_str);
+                        cmd_line_send_new_line();
+                        return FALSE;
                     }
-                    cmd_line_send_new_line();
                 }
-                return;
+                return TRUE;
             }
         }
         else
@@ -219,9 +260,16 @@ static void cmd_line_invoke(char *cmd_str)
         }
     }
 
+    // Identify offending command in batch mode, because it was not echoed
+    if(cmd_line_batch_mode)
+    {
+        cmd_line_send_str(cmd_line_argv[arg_index]);
+        (*cmd_line_put_char)(' ');
+    }
+
     // Command not found in list
     cmd_line_send_str(cmd_line_str_cmd_not_found);
-    return;
+    return FALSE;
 }
 
 static void cmd_line_add_to_list(cmd_line_t** first_cmd, cmd_line_t* new_cmd)
@@ -243,6 +291,25 @@ static void cmd_line_add_to_list(cmd_line_t** first_cmd, cmd_line_t* new_cmd)
     new_cmd->next_cmd = NULL;
 }
 
+static cmd_line_t* cmd_line_next_cmd_in_tree(cmd_line_t* cmd)
+{
+    // See if this is a parent command
+    if(cmd->child_cmd != NULL)
+    {
+        // Traverse child list
+        return cmd->child_cmd;
+    }
+
+    // Return to parent(s) when the end of a child list has been reached
+    while((cmd->next_cmd == NULL)&&(cmd->parent_cmd != NULL))
+    {
+        cmd = cmd->parent_cmd;
+    }
+
+    // Next item in list
+    return cmd->next_cmd;
+}
+
 static const char* cmd_line_help_handler(int argc, char* argv[])
 {
     int i;
@@ -317,6 +384,60 @@ static void cmd_line_disp_prompt(void)
     cmd_line_send_str(cmd_line_str_prompt);
 }
 
+/**
+ * Add a character to a line in batch mode and invoke the command when the 
+ * line is complete. Returns FALSE if the line failed.
+ */
+static bool_t cmd_line_process_batch(char   rx_char,
+                                     char   *buffer,
+                                     u8_t   *buffer_index,
+                                     bool_t *overflow)
+{
+    bool_t result = TRUE;
+
+    // See if end of line has been reached
+    if((rx_char == VT100_CR)||(rx_char == VT100_LF))
+    {
+        if(*overflow)
+        {
+            // Discard truncated line
+            cmd_line_send_str(cmd_line_str_line_too_long);
+            result = FALSE;
+        }
+        else if(*buffer_index != 0)
+        {
+            // Mark end of command line
+            buffer[*buffer_index] = '\0';
+
+            // Invoke command
+            result = cmd_line_invoke(buffer);
+        }
+
+        // Reset buffer
+        *buffer_index = 0;
+        *overflow     = FALSE;
+        return result;
+    }
+
+    // Ignore invalid values
+    if((rx_char < 0x20)||(rx_char > 0x7f))
+    {
+        return TRUE;
+    }
+
+    // Add character if buffer is not full
+    if(*buffer_index < (CMDL_LINE_LENGTH_MAX-1))
+    {
+        buffer[(*buffer_index)++] = rx_char;
+    }
+    else
+    {
+        // Reject line when end is reached
+        *overflow = TRUE;
+    }
+    return TRUE;
+}
+
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void cmd_line_init(cmd_line_put_char_t put_char)
 {
@@ -328,6 +449,15 @@ void cmd_line_init(cmd_line_put_char_t put_char)
     // Reset command line buffer
     cmd_line_buffer_index = 0;
 
+    // Start in interactive mode
+    cmd_line_batch_mode = FALSE;
+    cmd_line_overflow   = FALSE;
+
+    // Reset script line buffer
+    cmd_line_exec_line_index = 0;
+    cmd_line_exec_overflow   = FALSE;
+    cmd_line_exec_busy       = FALSE;
+
     // Clear history buffer
     cmd_line_hist_index = 0;
     for(i=(CMDL_HISTORY_SIZE-1); i!=0; i--)
@@ -356,6 +486,9 @@ void cmd_line_add(cmd_line_t*         cmd,
     cmd->next_cmd   = NULL;
     cmd->parent_cmd = NULL;
     cmd->child_cmd  = NULL;
+#if CMD_LINE_RPC
+    cmd->rpc_handler = NULL;
+#endif
 
     // Add to linked list
     cmd_line_add_to_list(&cmd_line_first_cmd, cmd);
@@ -374,6 +507,9 @@ void cmd_line_add_child(cmd_line_t*        parent_cmd,
     cmd->next_cmd   = NULL;
     cmd->parent_cmd = parent_cmd;
     cmd->child_cmd  = NULL;
+#if CMD_LINE_RPC
+    cmd->rpc_handler = NULL;
+#endif
 
     // Add to linked list of parent
     cmd_line_add_to_list(&(parent_cmd->child_cmd), cmd);
@@ -381,6 +517,16 @@ void cmd_line_add_child(cmd_line_t*        parent_cmd,
 
 void cmd_line_process(char rx_char)
 {
+    // See if batch mode is enabled
+    if(cmd_line_batch_mode)
+    {
+        cmd_line_process_batch(rx_char,
+                               cmd_line_buffer, 
+                               &cmd_line_buffer_index, 
+                               &cmd_line_overflow);
+        return;
+    }
+
     // Preprocess received characters to detect VT100 escape codes
     rx_char = vt100_process_rx_char(rx_char);
 
@@ -433,6 +579,82 @@ void cmd_line_process(char rx_char)
     }
 }
 
+void cmd_line_set_batch_mode(bool_t enable)
+{
+    // Discard partially received line
+    cmd_line_buffer_index = 0;
+    cmd_line_overflow     = FALSE;
+
+    // See if interactive mode has been restored
+    if(cmd_line_batch_mode && !enable)
+    {
+        cmd_line_disp_prompt();
+    }
+
+    cmd_line_batch_mode = enable;
+}
+
+u16_t cmd_line_exec_buffer(const char *buffer, u16_t length)
+{
+    u16_t  errors     = 0;
+    bool_t batch_mode = cmd_line_batch_mode;
+    char   *argv[CMDL_ARGV_MAX];
+
+    // Script executed by a command of a script?
+    if(cmd_line_exec_busy)
+    {
+        return 1;
+    }
+    cmd_line_exec_busy = TRUE;
+
+    // Save arguments of calling command handler (if any)
+    memcpy(argv, cmd_line_argv, sizeof(argv));
+
+    // Switch to batch mode, but keep partial line of previous chunk
+    cmd_line_batch_mode = TRUE;
+
+    while(length != 0)
+    {
+        if(!cmd_line_process_batch(*buffer++,
+                                   cmd_line_exec_line,
+                                   &cmd_line_exec_line_index,
+                                   &cmd_line_exec_overflow))
+        {
+            errors++;
+        }
+        length--;
+    }
+
+    // Restore mode and arguments
+    cmd_line_batch_mode = batch_mode;
+    cmd_line_exec_busy  = FALSE;
+    memcpy(cmd_line_argv, argv, sizeof(argv));
+
+    return errors;
+}
+
+cmd_line_t* cmd_line_get_cmd(u8_t index)
+{
+    cmd_line_t* cmd = cmd_line_first_cmd;
+
+    // Walk tree in the same order as 'help' displays it
+    while((cmd != NULL)&&(index != 0))
+    {
+        cmd = cmd_line_next_cmd_in_tree(cmd);
+        index--;
+    }
+
+    return cmd;
+}
+
+#if CMD_LINE_RPC
+void cmd_line_set_rpc_handler(cmd_line_t             *cmd,
+                              cmd_line_rpc_handler_t rpc_handler)
+{
+    cmd->rpc_handler = rpc_handler;
+}
+#endif
+
 bool_t cmd_line_strtol(const char* str, long* val, long min, long max)
 {
     long  i;
@@ -471,5 +693,11 @@ bool_t cmd_line_strtol(const char* str, long* val, long min, long max)
  2010/04/16 : Pieter.Conradie
  - Changed base in cmd_line_strtol(...) to 0 to support hexidecimal and octal
    numbers.
+
+ 2026/10/19 : agent
+ - Added batch mode and cmd_line_exec_buffer(...) to execute scripts without
+   echo or prompt.
+ - Limited number of arguments to CMDL_ARGV_MAX.
+ - Added cmd_line_get_cmd(...) and optional binary RPC handler per command.
    
 */
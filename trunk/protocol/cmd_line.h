@@ -63,6 +63,10 @@
 #include "common.h"
 
 /* _____DEFINITIONS _________________________________________________________ */
+#ifndef CMD_LINE_RPC
+/// Flag to add a binary RPC handler to each command (see @ref CMD_RPC)
+#define CMD_LINE_RPC 0
+#endif
 
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /**
@@ -71,6 +75,24 @@
  */
 typedef const char* (*cmd_line_handler_t)(int argc, char* argv[]);
 
+#if CMD_LINE_RPC
+///@cond
+struct cmd_rpc_buf_s;
+///@endcond
+
+/**
+ * Definition for a pointer to a function that will be called to handle a
+ * command received as a binary RPC request.
+ * 
+ * The handler fetches typed arguments from @b args and appends typed results
+ * to @b results. See @ref CMD_RPC.
+ * 
+ * @return u8_t     CMD_RPC_OK or an error status
+ */
+typedef u8_t (*cmd_line_rpc_handler_t)(struct cmd_rpc_buf_s *args,
+                                       struct cmd_rpc_buf_s *results);
+#endif
+
 /**
  * Definition for a pointer to a function that will be called to 
  * send a character
@@ -88,6 +110,9 @@ typedef struct cmd_line_s
     struct cmd_line_s  *next_cmd;   ///< Linked list to next command structure
     struct cmd_line_s  *parent_cmd; ///< Link to parent command
     struct cmd_line_s  *child_cmd;  ///< Link to child command
+#if CMD_LINE_RPC
+    cmd_line_rpc_handler_t rpc_handler; ///< Binary RPC handler; NULL if text handler must be used
+#endif
 } cmd_line_t;
 
 /* _____GLOBAL VARIABLES_____________________________________________________ */
@@ -138,7 +163,74 @@ extern void cmd_line_add_child(cmd_line_t         *parent_cmd,
  */
 extern void cmd_line_process(char rx_char);
 
-/** 
+/**
+ * Enable or disable batch (non-interactive) mode.
+ *
+ * In batch mode cmd_line_process() does not echo received characters, does
+ * not process VT100 escape sequences or back space and does not display the
+ * prompt. Both CR and LF terminate a line and empty lines are ignored. The
+ * strings returned by command handlers are discarded, except strings that 
+ * start with "Error", which are reported with the name of the command. 
+ * This is intended for scripts that are piped to the device, e.g. factory
+ * provisioning.
+ *
+ * When batch mode is disabled again, the prompt is displayed.
+ *
+ * @param enable    TRUE to enable batch mode; FALSE to return to interactive mode
+ */
+extern void cmd_line_set_batch_mode(bool_t enable);
+
+/**
+ * Execute a buffer of newline separated commands in batch mode.
+ *
+ * Each line is parsed and dispatched without echo or prompt and only errors
+ * are reported (see cmd_line_set_batch_mode()). The buffer may be fed in
+ * chunks, e.g. one ring buffer read or one DataFlash page at a time; a line
+ * that is not terminated at the end of the buffer is completed by the next
+ * call. The script must therefore end with a CR or LF.
+ *
+ * The script has its own line buffer, so it may be executed by a command 
+ * handler (e.g. a script received with XMODEM) without affecting the line 
+ * that is being received by cmd_line_process(). The arguments of the 
+ * calling handler are preserved. A command of a script may not execute 
+ * another script (the call fails).
+ *
+ * The interactive/batch mode setting is restored before returning.
+ *
+ * @param buffer    Buffer containing commands separated by CR and/or LF
+ * @param length    Number of characters in the buffer
+ *
+ * @return u16_t    Number of lines that failed (command not found, line too
+ *                  long or handler returned a string that starts with "Error")
+ */
+extern u16_t cmd_line_exec_buffer(const char *buffer, u16_t length);
+
+/**
+ * Find a command by its index in the command tree.
+ * 
+ * Commands are numbered depth first in the order that they have been added
+ * (parent before children), i.e. the same order in which 'help' lists them.
+ * The built-in 'help' command always has index 0.
+ * 
+ * @param index         Index of command
+ * 
+ * @return cmd_line_t*  Pointer to command; NULL if index is out of range
+ */
+extern cmd_line_t* cmd_line_get_cmd(u8_t index);
+
+#if CMD_LINE_RPC
+/**
+ * Set the binary RPC handler of a command.
+ * 
+ * @param cmd           Pointer to command
+ * @param rpc_handler   Handler that will be called when the command is invoked
+ *                      with a binary RPC request
+ */
+extern void cmd_line_set_rpc_handler(cmd_line_t             *cmd,
+                                     cmd_line_rpc_handler_t rpc_handler);
+#endif
+
+/**
  * Helper function to convert a string to a number of type "long".
  * 
  * This function is useful to parse command parameters. The string is converted 
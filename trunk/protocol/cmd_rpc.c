@@ -0,0 +1,566 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Binary RPC channel for the command line
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "cmd_rpc.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// HDLC flag sequence that marks the start and end of a frame
+#define CMD_RPC_FLAG            0x7e
+
+/// Maximum number of arguments passed to a text handler
+#define CMD_RPC_ARGV_MAX        8
+
+/// Size of buffer for arguments that are converted to strings for a text handler
+#define CMD_RPC_STR_BUFFER_SIZE (2*CMD_RPC_FRAME_SIZE_MAX)
+
+/// Size of header (sequence number + ID or status)
+#define CMD_RPC_HEADER_SIZE     2
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Response frame
+static u8_t cmd_rpc_tx_buffer[CMD_RPC_FRAME_SIZE_MAX];
+
+/// Arguments converted to strings for a text handler
+static char  cmd_rpc_str_buffer[CMD_RPC_STR_BUFFER_SIZE];
+static char* cmd_rpc_argv[CMD_RPC_ARGV_MAX];
+
+/// Flag to indicate that received data is inside an HDLC frame
+static bool_t cmd_rpc_in_frame;
+
+/// Number of bytes received since the opening flag of a frame
+static u8_t   cmd_rpc_frame_bytes;
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static bool_t cmd_rpc_get_bytes(cmd_rpc_buf_t *buf, u8_t type, u8_t size)
+{
+    // See if type matches and enough data remains
+    if(cmd_rpc_buf_peek_type(buf) != type)
+    {
+        return FALSE;
+    }
+    if((u8_t)(buf->length - buf->index) < (size+1))
+    {
+        return FALSE;
+    }
+    // Skip type
+    buf->index++;
+    return TRUE;
+}
+
+static bool_t cmd_rpc_put_bytes(cmd_rpc_buf_t *buf, u8_t type, u32_t val, u8_t size)
+{
+    // See if there is enough space
+    if((u8_t)(buf->size - buf->length) < (size+1))
+    {
+        return FALSE;
+    }
+
+    // Type
+    buf->data[buf->length++] = type;
+
+    // Value (little endian)
+    while(size != 0)
+    {
+        buf->data[buf->length++] = (u8_t)val;
+        val >>= 8;
+        size--;
+    }
+    return TRUE;
+}
+
+static u32_t cmd_rpc_get_val(cmd_rpc_buf_t *buf, u8_t size)
+{
+    u32_t val   = 0;
+    u8_t  shift = 0;
+
+    // Value (little endian)
+    while(size != 0)
+    {
+        val |= ((u32_t)buf->data[buf->index++]) << shift;
+        shift += 8;
+        size--;
+    }
+    return val;
+}
+
+static bool_t cmd_rpc_put_str_n(cmd_rpc_buf_t *buf, const char *str, u8_t length)
+{
+    // See if there is enough space for type, length, string and terminating zero
+    if((u8_t)(buf->size - buf->length) < (length+3))
+    {
+        return FALSE;
+    }
+
+    buf->data[buf->length++] = CMD_RPC_TYPE_STR;
+    buf->data[buf->length++] = length+1;
+    memcpy(&buf->data[buf->length], str, length);
+    buf->length += length;
+    buf->data[buf->length++] = '\0';
+
+    return TRUE;
+}
+
+/// Convert an unsigned value to a decimal string; returns pointer after last digit
+static char* cmd_rpc_u32_to_str(char *str, u32_t val)
+{
+    char  digits[10];
+    u8_t  i = 0;
+
+    // Generate digits in reverse order
+    do
+    {
+        digits[i++] = '0' + (char)(val % 10);
+        val        /= 10;
+    }
+    while(val != 0);
+
+    // Copy digits in correct order
+    while(i != 0)
+    {
+        *str++ = digits[--i];
+    }
+    return str;
+}
+
+/// Get ID of a command (index in tree + 1); 0 if not found
+static u8_t cmd_rpc_get_id(cmd_line_t *cmd)
+{
+    u8_t        index = 0;
+    cmd_line_t *cmd_in_tree;
+
+    while((cmd_in_tree = cmd_line_get_cmd(index)) != NULL)
+    {
+        if(cmd_in_tree == cmd)
+        {
+            return index+1;
+        }
+        index++;
+    }
+    return 0;
+}
+
+static u8_t cmd_rpc_enum(cmd_rpc_buf_t *args, cmd_rpc_buf_t *results)
+{
+    u8_t        id;
+    cmd_line_t *cmd;
+
+    if(!cmd_rpc_get_u8(args, &id))
+    {
+        return CMD_RPC_ERR_ARGS;
+    }
+
+    if((id == CMD_RPC_ID_ENUM) || ((cmd = cmd_line_get_cmd(id-1)) == NULL))
+    {
+        return CMD_RPC_ERR_UNKNOWN_CMD;
+    }
+
+    // Name of command
+    if(!cmd_rpc_put_str(results, cmd->name))
+    {
+        return CMD_RPC_ERR_OVERFLOW;
+    }
+
+    // ID of parent
+    if(cmd->parent_cmd == NULL)
+    {
+        id = 0;
+    }
+    else
+    {
+        id = cmd_rpc_get_id(cmd->parent_cmd);
+    }
+    if(!cmd_rpc_put_u8(results, id))
+    {
+        return CMD_RPC_ERR_OVERFLOW;
+    }
+
+    return CMD_RPC_OK;
+}
+
+static u8_t cmd_rpc_call_text_handler(cmd_line_t    *cmd,
+                                      cmd_rpc_buf_t *args,
+                                      cmd_rpc_buf_t *results)
+{
+    int         argc    = 0;
+    char       *str     = cmd_rpc_str_buffer;
+    char       *str_end = cmd_rpc_str_buffer + CMD_RPC_STR_BUFFER_SIZE;
+    u8_t        val_u8;
+    u16_t       val_u16;
+    u32_t       val;
+    s32_t       val_signed;
+    const char *arg_str;
+    const char *display_str;
+    size_t      length;
+
+    if(cmd->handler == NULL)
+    {
+        return CMD_RPC_ERR_UNKNOWN_CMD;
+    }
+
+    // Convert arguments to strings
+    while(!cmd_rpc_buf_is_empty(args))
+    {
+        // Make sure that there is space for the largest possible value
+        if((argc == CMD_RPC_ARGV_MAX) || ((str_end - str) < 12))
+        {
+            return CMD_RPC_ERR_ARGS;
+        }
+        cmd_rpc_argv[argc++] = str;
+
+        switch(cmd_rpc_buf_peek_type(args))
+        {
+        case CMD_RPC_TYPE_U8:
+            if(!cmd_rpc_get_u8(args, &val_u8))
+            {
+                return CMD_RPC_ERR_ARGS;
+            }
+            str = cmd_rpc_u32_to_str(str, val_u8);
+            break;
+
+        case CMD_RPC_TYPE_U16:
+            if(!cmd_rpc_get_u16(args, &val_u16))
+            {
+                return CMD_RPC_ERR_ARGS;
+            }
+            str = cmd_rpc_u32_to_str(str, val_u16);
+            break;
+
+        case CMD_RPC_TYPE_U32:
+            if(!cmd_rpc_get_u32(args, &val))
+            {
+                return CMD_RPC_ERR_ARGS;
+            }
+            str = cmd_rpc_u32_to_str(str, val);
+            break;
+
+        case CMD_RPC_TYPE_S32:
+            if(!cmd_rpc_get_s32(args, &val_signed))
+            {
+                return CMD_RPC_ERR_ARGS;
+            }
+            if(val_signed < 0)
+            {
+                *str++ = '-';
+                val    = -(u32_t)val_signed;
+            }
+            else
+            {
+                val    = (u32_t)val_signed;
+            }
+            str = cmd_rpc_u32_to_str(str, val);
+            break;
+
+        case CMD_RPC_TYPE_STR:
+            if(!cmd_rpc_get_str(args, &arg_str))
+            {
+                return CMD_RPC_ERR_ARGS;
+            }
+            length = strlen(arg_str);
+            if((size_t)(str_end - str) < (length+1))
+            {
+                return CMD_RPC_ERR_ARGS;
+            }
+            memcpy(str, arg_str, length);
+            str += length;
+            break;
+
+        default:
+            return CMD_RPC_ERR_ARGS;
+        }
+
+        // Terminate string
+        *str++ = '\0';
+    }
+
+    // Call text handler
+    display_str = (*(cmd->handler))(argc, cmd_rpc_argv);
+
+    // Return display string as result (truncated if too long)
+    if(display_str != NULL)
+    {
+        length = strlen(display_str);
+        if(length > (size_t)(results->size - results->length - 3))
+        {
+            length = results->size - results->length - 3;
+        }
+        cmd_rpc_put_str_n(results, display_str, (u8_t)length);
+    }
+
+    return CMD_RPC_OK;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void cmd_rpc_init(hdlc_put_char_t put_char)
+{
+    cmd_rpc_in_frame    = FALSE;
+    cmd_rpc_frame_bytes = 0;
+
+    hdlc_init(put_char, &cmd_rpc_on_rx_frame);
+}
+
+void cmd_rpc_on_rx_byte(u8_t data)
+{
+    // See if text command line data is being received
+    if(!cmd_rpc_in_frame)
+    {
+        if(data == CMD_RPC_FLAG)
+        {
+            // Start of binary frame
+            cmd_rpc_in_frame    = TRUE;
+            cmd_rpc_frame_bytes = 0;
+            hdlc_on_rx_byte(data);
+        }
+        else
+        {
+            cmd_line_process((char)data);
+        }
+        return;
+    }
+
+    // Pass frame data to HDLC layer
+    hdlc_on_rx_byte(data);
+
+    if(data == CMD_RPC_FLAG)
+    {
+        // Return to text mode after closing flag (ignore repeated opening flags)
+        if(cmd_rpc_frame_bytes != 0)
+        {
+            cmd_rpc_in_frame = FALSE;
+        }
+    }
+    else if(cmd_rpc_frame_bytes != 0xff)
+    {
+        cmd_rpc_frame_bytes++;
+    }
+}
+
+void cmd_rpc_on_rx_frame(const u8_t *buffer, u16_t bytes_received)
+{
+    u8_t          id;
+    u8_t          status;
+    cmd_line_t   *cmd;
+    cmd_rpc_buf_t args;
+    cmd_rpc_buf_t results;
+
+    // Discard frame without header
+    if((bytes_received < CMD_RPC_HEADER_SIZE)||(bytes_received > CMD_RPC_FRAME_SIZE_MAX))
+    {
+        return;
+    }
+
+    id = buffer[1];
+    cmd_rpc_buf_init(&args, 
+                     (u8_t *)buffer+CMD_RPC_HEADER_SIZE, 
+                     (u8_t)(bytes_received-CMD_RPC_HEADER_SIZE),
+                     (u8_t)(bytes_received-CMD_RPC_HEADER_SIZE));
+    cmd_rpc_buf_init(&results,
+                     cmd_rpc_tx_buffer+CMD_RPC_HEADER_SIZE,
+                     CMD_RPC_FRAME_SIZE_MAX-CMD_RPC_HEADER_SIZE,
+                     0);
+
+    if(id == CMD_RPC_ID_ENUM)
+    {
+        status = cmd_rpc_enum(&args, &results);
+    }
+    else if((cmd = cmd_line_get_cmd(id-1)) == NULL)
+    {
+        status = CMD_RPC_ERR_UNKNOWN_CMD;
+    }
+#if CMD_LINE_RPC
+    else if(cmd->rpc_handler != NULL)
+    {
+        status = (*(cmd->rpc_handler))(&args, &results);
+    }
+#endif
+    else
+    {
+        status = cmd_rpc_call_text_handler(cmd, &args, &results);
+    }
+
+    // Discard results if an error occured
+    if(status != CMD_RPC_OK)
+    {
+        results.length = 0;
+    }
+
+    // Send response with same sequence number
+    cmd_rpc_tx_buffer[0] = buffer[0];
+    cmd_rpc_tx_buffer[1] = status;
+    hdlc_tx_frame(cmd_rpc_tx_buffer, CMD_RPC_HEADER_SIZE+results.length);
+}
+
+void cmd_rpc_buf_init(cmd_rpc_buf_t *buf, 
+                      u8_t          *data,
+                      u8_t          size,
+                      u8_t          length)
+{
+    buf->data   = data;
+    buf->size   = size;
+    buf->length = length;
+    buf->index  = 0;
+}
+
+bool_t cmd_rpc_buf_is_empty(cmd_rpc_buf_t *buf)
+{
+    return (buf->index >= buf->length);
+}
+
+u8_t cmd_rpc_buf_peek_type(cmd_rpc_buf_t *buf)
+{
+    if(cmd_rpc_buf_is_empty(buf))
+    {
+        return 0;
+    }
+    return buf->data[buf->index];
+}
+
+bool_t cmd_rpc_get_u8(cmd_rpc_buf_t *buf, u8_t *val)
+{
+    if(!cmd_rpc_get_bytes(buf, CMD_RPC_TYPE_U8, sizeof(u8_t)))
+    {
+        return FALSE;
+    }
+    *val = buf->data[buf->index++];
+    return TRUE;
+}
+
+bool_t cmd_rpc_get_u16(cmd_rpc_buf_t *buf, u16_t *val)
+{
+    if(!cmd_rpc_get_bytes(buf, CMD_RPC_TYPE_U16, sizeof(u16_t)))
+    {
+        return FALSE;
+    }
+    *val = (u16_t)cmd_rpc_get_val(buf, sizeof(u16_t));
+    return TRUE;
+}
+
+bool_t cmd_rpc_get_u32(cmd_rpc_buf_t *buf, u32_t *val)
+{
+    if(!cmd_rpc_get_bytes(buf, CMD_RPC_TYPE_U32, sizeof(u32_t)))
+    {
+        return FALSE;
+    }
+    *val = cmd_rpc_get_val(buf, sizeof(u32_t));
+    return TRUE;
+}
+
+bool_t cmd_rpc_get_s32(cmd_rpc_buf_t *buf, s32_t *val)
+{
+    if(!cmd_rpc_get_bytes(buf, CMD_RPC_TYPE_S32, sizeof(s32_t)))
+    {
+        return FALSE;
+    }
+    *val = (s32_t)cmd_rpc_get_val(buf, sizeof(s32_t));
+    return TRUE;
+}
+
+bool_t cmd_rpc_get_str(cmd_rpc_buf_t *buf, const char **str)
+{
+    u8_t length;
+
+    // Type and length
+    if(!cmd_rpc_get_bytes(buf, CMD_RPC_TYPE_STR, 1))
+    {
+        return FALSE;
+    }
+    length = buf->data[buf->index];
+
+    // Make sure that string is inside buffer and zero terminated
+    if(  (length == 0)
+       ||((u8_t)(buf->length - buf->index - 1) < length)
+       ||(buf->data[buf->index + length] != '\0')         )
+    {
+        // Restore index to type
+        buf->index--;
+        return FALSE;
+    }
+
+    *str        = (const char *)&buf->data[buf->index+1];
+    buf->index += 1 + length;
+    return TRUE;
+}
+
+bool_t cmd_rpc_put_u8(cmd_rpc_buf_t *buf, u8_t val)
+{
+    return cmd_rpc_put_bytes(buf, CMD_RPC_TYPE_U8, val, sizeof(u8_t));
+}
+
+bool_t cmd_rpc_put_u16(cmd_rpc_buf_t *buf, u16_t val)
+{
+    return cmd_rpc_put_bytes(buf, CMD_RPC_TYPE_U16, val, sizeof(u16_t));
+}
+
+bool_t cmd_rpc_put_u32(cmd_rpc_buf_t *buf, u32_t val)
+{
+    return cmd_rpc_put_bytes(buf, CMD_RPC_TYPE_U32, val, sizeof(u32_t));
+}
+
+bool_t cmd_rpc_put_s32(cmd_rpc_buf_t *buf, s32_t val)
+{
+    return cmd_rpc_put_bytes(buf, CMD_RPC_TYPE_S32, (u32_t)val, sizeof(s32_t));
+}
+
+bool_t cmd_rpc_put_str(cmd_rpc_buf_t *buf, const char *str)
+{
+    size_t length = strlen(str);
+
+    if(length > 0xfd)
+    {
+        return FALSE;
+    }
+    return cmd_rpc_put_str_n(buf, str, (u8_t)length);
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
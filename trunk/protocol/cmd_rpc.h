@@ -0,0 +1,227 @@
+#ifndef __CMD_RPC_H__
+#define __CMD_RPC_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Binary RPC channel for the command line
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup PROTOCOL
+ *  @defgroup CMD_RPC cmd_rpc.h : Binary RPC channel for the command line
+ *
+ *  Invokes @ref CMD_LINE commands with binary requests carried in HDLC frames.
+ *  
+ *  Files: cmd_rpc.h & cmd_rpc.c
+ *  
+ *  Machine-to-machine control via the text command line is slow: the host 
+ *  formats ASCII, the device parses it with cmd_line_strtol() and the 
+ *  handler formats a display string. This module reuses the command tree 
+ *  that has been registered with cmd_line_add() and cmd_line_add_child(), 
+ *  but commands are addressed with a numeric ID and arguments and results 
+ *  are typed binary values.
+ *  
+ *  The command ID is the index returned by cmd_line_get_cmd() + 1. ID 0 
+ *  (#CMD_RPC_ID_ENUM) is reserved so that the host can discover the IDs at 
+ *  run time: it is passed an U8 ID and returns the name of the command (STR)
+ *  and the ID of its parent (U8, 0 for a top level command).
+ *  
+ *  Request frame:
+ *  @code
+ *  [SEQ] [ID] [TYPE][VALUE] [TYPE][VALUE] ...
+ *  @endcode
+ *  Response frame:
+ *  @code
+ *  [SEQ] [STATUS] [TYPE][VALUE] [TYPE][VALUE] ...
+ *  @endcode
+ *  
+ *  Multi-byte values are sent little endian. A string is sent as 
+ *  [#CMD_RPC_TYPE_STR][LENGTH][CHARACTERS...][0], where LENGTH includes the
+ *  terminating zero so that the string can be used in place.
+ *  
+ *  If a command does not have a binary handler (#CMD_LINE_RPC must be 1 to 
+ *  add one with cmd_line_set_rpc_handler()), the arguments are converted to 
+ *  strings, the text handler is called and the returned display string is 
+ *  sent back as a STR result. Every existing command is therefore accessible,
+ *  and time critical commands can be given a binary handler.
+ *  
+ *  The RPC channel is multiplexed with the text command line on the same 
+ *  serial port: feed all received data to cmd_rpc_on_rx_byte(). A HDLC flag 
+ *  (0x7E or '~') switches to the binary channel until the closing flag; 
+ *  all other data is passed to cmd_line_process().
+ *  
+ *  See cmd_rpc_client.h for the host side.
+ *  
+ *  Example:
+ *  @include test/cmd_rpc_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "cmd_line.h"
+#include "hdlc.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+/// Reserved command ID to enumerate commands
+#define CMD_RPC_ID_ENUM         0
+
+/// @name Argument and result types
+//@{
+#define CMD_RPC_TYPE_U8         0x01    ///< Unsigned 8-bit value
+#define CMD_RPC_TYPE_U16        0x02    ///< Unsigned 16-bit value
+#define CMD_RPC_TYPE_U32        0x03    ///< Unsigned 32-bit value
+#define CMD_RPC_TYPE_S32        0x04    ///< Signed 32-bit value
+#define CMD_RPC_TYPE_STR        0x05    ///< Zero terminated string
+//@}
+
+/// @name Response status
+//@{
+#define CMD_RPC_OK              0x00    ///< Command executed
+#define CMD_RPC_ERR_UNKNOWN_CMD 0x01    ///< Command ID not found
+#define CMD_RPC_ERR_ARGS        0x02    ///< Incorrect argument type or number of arguments
+#define CMD_RPC_ERR_OVERFLOW    0x03    ///< Results do not fit in response
+#define CMD_RPC_ERR_FAILED      0x04    ///< Handler reported failure
+//@}
+
+/// Size of request and response buffer (sequence number and ID/status included)
+#define CMD_RPC_FRAME_SIZE_MAX  HDLC_MRU
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Buffer of typed values that is read or written in sequence
+typedef struct cmd_rpc_buf_s
+{
+    u8_t *data;     ///< Pointer to first value
+    u8_t size;      ///< Maximum number of bytes that can be stored
+    u8_t length;    ///< Number of valid bytes
+    u8_t index;     ///< Index of next value to read
+} cmd_rpc_buf_t;
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/** 
+ * Initialise RPC channel.
+ * 
+ * cmd_line_init() must have been called first. The HDLC layer is 
+ * initialised by this function.
+ * 
+ * @param put_char  Function to call to send a character
+ */
+extern void cmd_rpc_init(hdlc_put_char_t put_char);
+
+/** 
+ * Function called to handle a received byte.
+ * 
+ * Data inside HDLC frames is passed to the RPC channel; all other data is
+ * passed to cmd_line_process().
+ * 
+ * @param data      The received byte
+ */
+extern void cmd_rpc_on_rx_byte(u8_t data);
+
+/** 
+ * Handle a received RPC request frame and send the response.
+ * 
+ * This function is called by the HDLC layer, but may be called directly if 
+ * requests are received via another transport.
+ * 
+ * @param buffer            Request frame
+ * @param bytes_received    Size of request frame
+ */
+extern void cmd_rpc_on_rx_frame(const u8_t *buffer, u16_t bytes_received);
+
+/** 
+ * Initialise a buffer for reading (length = size) or writing (length = 0).
+ * 
+ * @param buf       Pointer to buffer object
+ * @param data      Data storage
+ * @param size      Size of data storage
+ * @param length    Number of valid bytes in data storage
+ */
+extern void cmd_rpc_buf_init(cmd_rpc_buf_t *buf, 
+                             u8_t          *data,
+                             u8_t          size,
+                             u8_t          length);
+
+/** 
+ * See if all of the values in a buffer have been read.
+ * 
+ * @param buf       Pointer to buffer object
+ * 
+ * @retval TRUE     No more values
+ * @retval FALSE    One or more values remain
+ */
+extern bool_t cmd_rpc_buf_is_empty(cmd_rpc_buf_t *buf);
+
+/** 
+ * Get the type of the next value in the buffer.
+ * 
+ * @param buf       Pointer to buffer object
+ * 
+ * @return u8_t     Type (e.g. #CMD_RPC_TYPE_U8); 0 if the buffer is empty
+ */
+extern u8_t cmd_rpc_buf_peek_type(cmd_rpc_buf_t *buf);
+
+/// @name Fetch typed values
+/// Each function returns FALSE if the buffer is empty or the type does not match
+//@{
+extern bool_t cmd_rpc_get_u8 (cmd_rpc_buf_t *buf, u8_t  *val);
+extern bool_t cmd_rpc_get_u16(cmd_rpc_buf_t *buf, u16_t *val);
+extern bool_t cmd_rpc_get_u32(cmd_rpc_buf_t *buf, u32_t *val);
+extern bool_t cmd_rpc_get_s32(cmd_rpc_buf_t *buf, s32_t *val);
+extern bool_t cmd_rpc_get_str(cmd_rpc_buf_t *buf, const char **str);
+//@}
+
+/// @name Append typed values
+/// Each function returns FALSE if there is not enough space in the buffer
+//@{
+extern bool_t cmd_rpc_put_u8 (cmd_rpc_buf_t *buf, u8_t  val);
+extern bool_t cmd_rpc_put_u16(cmd_rpc_buf_t *buf, u16_t val);
+extern bool_t cmd_rpc_put_u32(cmd_rpc_buf_t *buf, u32_t val);
+extern bool_t cmd_rpc_put_s32(cmd_rpc_buf_t *buf, s32_t val);
+extern bool_t cmd_rpc_put_str(cmd_rpc_buf_t *buf, const char *str);
+//@}
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ *  @}
+ */
+#endif
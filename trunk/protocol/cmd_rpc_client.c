@@ -0,0 +1,157 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Host side client for the binary RPC channel
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <string.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "cmd_rpc_client.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+/// Size of header (sequence number + ID or status)
+#define CMD_RPC_CLIENT_HEADER_SIZE 2
+
+/* _____MACROS_______________________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+/// Request frame
+static u8_t cmd_rpc_client_tx_buffer[CMD_RPC_FRAME_SIZE_MAX];
+static cmd_rpc_buf_t cmd_rpc_client_args;
+
+/// Response frame
+static u8_t cmd_rpc_client_rx_buffer[CMD_RPC_FRAME_SIZE_MAX];
+static cmd_rpc_buf_t cmd_rpc_client_results;
+static u8_t cmd_rpc_client_status;
+
+/// Sequence number of last request
+static u8_t   cmd_rpc_client_seq;
+
+/// Flag to indicate that the response to the last request has been received
+static bool_t cmd_rpc_client_rsp_flag;
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static void cmd_rpc_client_on_rx_frame(const u8_t *buffer, u16_t bytes_received)
+{
+    // Discard frame without header or unexpected response
+    if(  (bytes_received < CMD_RPC_CLIENT_HEADER_SIZE)
+       ||(bytes_received > CMD_RPC_FRAME_SIZE_MAX    )
+       ||(buffer[0]      != cmd_rpc_client_seq       )
+       ||(cmd_rpc_client_rsp_flag                    )  )
+    {
+        return;
+    }
+
+    cmd_rpc_client_status = buffer[1];
+
+    // Copy results, because HDLC receive buffer will be overwritten
+    bytes_received -= CMD_RPC_CLIENT_HEADER_SIZE;
+    memcpy(cmd_rpc_client_rx_buffer, buffer+CMD_RPC_CLIENT_HEADER_SIZE, bytes_received);
+    cmd_rpc_buf_init(&cmd_rpc_client_results,
+                     cmd_rpc_client_rx_buffer,
+                     (u8_t)bytes_received,
+                     (u8_t)bytes_received);
+
+    cmd_rpc_client_rsp_flag = TRUE;
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void cmd_rpc_client_init(hdlc_put_char_t put_char)
+{
+    cmd_rpc_client_seq      = 0;
+    cmd_rpc_client_rsp_flag = FALSE;
+
+    hdlc_init(put_char, &cmd_rpc_client_on_rx_frame);
+}
+
+cmd_rpc_buf_t* cmd_rpc_client_req_begin(u8_t id)
+{
+    // Next sequence number
+    cmd_rpc_client_seq++;
+    cmd_rpc_client_rsp_flag = FALSE;
+
+    // Header
+    cmd_rpc_client_tx_buffer[0] = cmd_rpc_client_seq;
+    cmd_rpc_client_tx_buffer[1] = id;
+
+    // Arguments
+    cmd_rpc_buf_init(&cmd_rpc_client_args,
+                     cmd_rpc_client_tx_buffer + CMD_RPC_CLIENT_HEADER_SIZE,
+                     CMD_RPC_FRAME_SIZE_MAX - CMD_RPC_CLIENT_HEADER_SIZE,
+                     0);
+
+    return &cmd_rpc_client_args;
+}
+
+void cmd_rpc_client_req_send(void)
+{
+    hdlc_tx_frame(cmd_rpc_client_tx_buffer, 
+                  CMD_RPC_CLIENT_HEADER_SIZE + cmd_rpc_client_args.length);
+}
+
+void cmd_rpc_client_on_rx_byte(u8_t data)
+{
+    hdlc_on_rx_byte(data);
+}
+
+bool_t cmd_rpc_client_rsp_received(void)
+{
+    return cmd_rpc_client_rsp_flag;
+}
+
+u8_t cmd_rpc_client_rsp_status(void)
+{
+    return cmd_rpc_client_status;
+}
+
+cmd_rpc_buf_t* cmd_rpc_client_rsp_results(void)
+{
+    return &cmd_rpc_client_results;
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
@@ -0,0 +1,138 @@
+#ifndef __CMD_RPC_CLIENT_H__
+#define __CMD_RPC_CLIENT_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          Host side client for the binary RPC channel
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup PROTOCOL
+ *  @defgroup CMD_RPC_CLIENT cmd_rpc_client.h : Host side client for the binary RPC channel
+ *
+ *  Builds @ref CMD_RPC requests and decodes the responses.
+ *  
+ *  Files: cmd_rpc_client.h & cmd_rpc_client.c
+ *  
+ *  The client is independent of the transport: requests are sent via the
+ *  put_char function passed to cmd_rpc_client_init() and all received data 
+ *  must be fed to cmd_rpc_client_on_rx_byte(). Text output of the command
+ *  line (e.g. the prompt) is silently discarded by the HDLC layer.
+ *  
+ *  Only one request may be outstanding at a time. A response is matched to 
+ *  the request with the sequence number.
+ *  
+ *  Example:
+ *  @include test/cmd_rpc_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "common.h"
+#include "cmd_rpc.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/** 
+ * Initialise RPC client.
+ * 
+ * The HDLC layer is initialised by this function.
+ * 
+ * @param put_char  Function to call to send a character
+ */
+extern void cmd_rpc_client_init(hdlc_put_char_t put_char);
+
+/** 
+ * Start a new request.
+ * 
+ * Arguments are appended to the returned buffer with cmd_rpc_put_u8(), etc.
+ * 
+ * @param id                Command ID (see @ref CMD_RPC)
+ * 
+ * @return cmd_rpc_buf_t*   Buffer for request arguments
+ */
+extern cmd_rpc_buf_t* cmd_rpc_client_req_begin(u8_t id);
+
+/** 
+ * Send request that has been started with cmd_rpc_client_req_begin().
+ */
+extern void cmd_rpc_client_req_send(void);
+
+/** 
+ * Function called to handle a received byte.
+ * 
+ * @param data      The received byte
+ */
+extern void cmd_rpc_client_on_rx_byte(u8_t data);
+
+/** 
+ * See if the response to the last request has been received.
+ * 
+ * @retval TRUE     Response received
+ * @retval FALSE    Still waiting for response
+ */
+extern bool_t cmd_rpc_client_rsp_received(void);
+
+/** 
+ * Get the status of the response.
+ * 
+ * @return u8_t     Status, e.g. #CMD_RPC_OK
+ */
+extern u8_t cmd_rpc_client_rsp_status(void);
+
+/** 
+ * Get the results of the response.
+ * 
+ * Results are fetched from the returned buffer with cmd_rpc_get_u8(), etc.
+ * 
+ * @return cmd_rpc_buf_t*   Buffer containing results
+ */
+extern cmd_rpc_buf_t* cmd_rpc_client_rsp_results(void);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ *  @}
+ */
+#endif
@@ -45,6 +45,7 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "crc16_ccitt.h"
+#include "prof.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 /**
@@ -169,6 +170,8 @@ u16_t crc16_ccitt_calc_byte(u16_t crc, u8_t data)
 
 u16_t crc16_ccitt_calc_data(u16_t crc, u8_t* data, u16_t data_length)
 {
+    PROF_BEGIN(PROF_ID_CRC16);
+
     while(data_length)
     {
         CRC16_CCITT_UPDATE(crc,*data);
@@ -176,6 +179,8 @@ u16_t crc16_ccitt_calc_data(u16_t crc, u8_t* data, u16_t data_length)
         data_length--;
     }
 
+    PROF_END(PROF_ID_CRC16);
+
     return crc;
 }
 
@@ -184,5 +189,8 @@ u16_t crc16_ccitt_calc_data(u16_t crc, u8_t* data, u16_t data_length)
 
  2008/11/06 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added profiler markers (PROF)
    
 */
@@ -40,7 +40,7 @@
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "hdlc.h"
 #include "crc16_ccitt.h"
-#include "uart1.h"
+#include "prof.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 // Significant octet values
@@ -49,8 +49,13 @@
 #define HDLC_ESCAPE_BIT     0x20   // Asynchronous transparency modifier
 
 /* _____LOCAL VARIABLES______________________________________________________ */
+#if HDLC_PBUF
+static pbuf_t *hdlc_rx_pbuf;
+static bool_t hdlc_rx_frame_discard;
+#else
 static u8_t   hdlc_rx_frame[HDLC_MRU];
-static u8_t   hdlc_rx_frame_index;
+#endif
+static u16_t  hdlc_rx_frame_index;
 static u16_t  hdlc_rx_frame_fcs;
 static bool_t hdlc_rx_char_esc;
 
@@ -70,18 +75,36 @@ static void hdlc_tx_byte(u8_t data)
 {
     (*hdlc_put_char)(data);
 }
-/* _____FUNCTIONS_____________________________________________________ */
-void hdlc_init(hdlc_put_char_t    put_char,
-               hdlc_on_rx_frame_t on_rx_frame)
+
+/// Function to send a byte, escaped if neccessary
+static void hdlc_tx_escaped_byte(u8_t data)
 {
-    hdlc_rx_frame_index = 0;
-    hdlc_rx_frame_fcs   = HDLC_INITFCS;
-    hdlc_rx_char_esc    = FALSE;
-    hdlc_put_char       = put_char;
-    hdlc_on_rx_frame    = on_rx_frame;
+    // See if data should be escaped
+    if((data == HDLC_CONTROL_ESCAPE) || (data == HDLC_FLAG_SEQUENCE))
+    {
+        hdlc_tx_byte(HDLC_CONTROL_ESCAPE);
+        data ^= HDLC_ESCAPE_BIT;
+    }
+    hdlc_tx_byte(data);
 }
 
-void hdlc_on_rx_byte(u8_t data)
+/// Function to send the FCS and end marker of a frame
+static void hdlc_tx_end(u16_t fcs)
+{
+    // Invert checksum
+    fcs ^= 0xffff;
+
+    // Low byte of inverted FCS
+    hdlc_tx_escaped_byte(U16_LO8(fcs));
+
+    // High byte of inverted FCS
+    hdlc_tx_escaped_byte(U16_HI8(fcs));
+
+    // End marker
+    hdlc_tx_byte(HDLC_FLAG_SEQUENCE);    
+}
+/// Process received byte (see hdlc_on_rx_byte())
+static void hdlc_process_rx_byte(u8_t data)
 {
     // Start/End sequence
     if(data == HDLC_FLAG_SEQUENCE)
@@ -92,12 +115,30 @@ void hdlc_on_rx_byte(u8_t data)
             hdlc_rx_char_esc = FALSE;
         }
         //  Minimum requirement for a valid frame is reception of good FCS
+#if HDLC_PBUF
+        else if(  (hdlc_rx_frame_index >= sizeof(hdlc_rx_frame_fcs)) 
+                &&(hdlc_rx_frame_fcs   == CRC16_CCITT_MAGIC_VAL    )
+                &&(!hdlc_rx_frame_discard                          )  )
+        {
+            // Pass on frame with FCS field removed; handler becomes owner
+            pbuf_trim(hdlc_rx_pbuf, hdlc_rx_frame_index-2);
+            (*hdlc_on_rx_frame)(hdlc_rx_pbuf);
+            hdlc_rx_pbuf = NULL;
+        }
+        // Reuse buffer of discarded frame
+        if(hdlc_rx_pbuf != NULL)
+        {
+            pbuf_trim(hdlc_rx_pbuf, 0);
+        }
+        hdlc_rx_frame_discard = FALSE;
+#else
         else if(  (hdlc_rx_frame_index >= sizeof(hdlc_rx_frame_fcs)) 
                 &&(hdlc_rx_frame_fcs   == CRC16_CCITT_MAGIC_VAL    )  )
         {
             // Pass on frame with FCS field removed
-            (*hdlc_on_rx_frame)(hdlc_rx_frame,(u8_t)(hdlc_rx_frame_index-2));
+            (*hdlc_on_rx_frame)(hdlc_rx_frame,hdlc_rx_frame_index-2);
         }
+#endif
         // Reset for next packet
         hdlc_rx_frame_index = 0;
         hdlc_rx_frame_fcs   = CRC16_CCITT_INIT_VAL;
@@ -116,11 +157,39 @@ void hdlc_on_rx_byte(u8_t data)
         return;
     }
 
+#if HDLC_PBUF
+    if(hdlc_rx_frame_discard)
+    {
+        return;
+    }
+
+    // Allocate buffer for new frame
+    if(hdlc_rx_pbuf == NULL)
+    {
+        hdlc_rx_pbuf = pbuf_alloc(0, HDLC_PBUF_RESERVE);
+    }
+
+    // Store received data
+    if(  (hdlc_rx_frame_index == HDLC_MRU           )
+       ||(hdlc_rx_pbuf        == NULL               )
+       ||(pbuf_append(hdlc_rx_pbuf, &data, 1) == 0)  )
+    {
+        // Frame too long or out of buffers; discard rest of frame
+        hdlc_rx_frame_discard = TRUE;
+        return;
+    }
+
+    // Calculate checksum
+    hdlc_rx_frame_fcs = crc16_ccitt_calc_byte(hdlc_rx_frame_fcs,data);
+
+    // Go to next position in buffer
+    hdlc_rx_frame_index++;
+#else
     // Store received data
     hdlc_rx_frame[hdlc_rx_frame_index] = data;
 
     // Calculate checksum
-    crc16_ccitt_calc_byte(hdlc_rx_frame_fcs,data);
+    hdlc_rx_frame_fcs = crc16_ccitt_calc_byte(hdlc_rx_frame_fcs,data);
 
     // Go to next position in buffer
     hdlc_rx_frame_index++;
@@ -134,6 +203,29 @@ void hdlc_on_rx_byte(u8_t data)
         // Invalidate FCS so that packet will be rejected
         hdlc_rx_frame_fcs  ^= 0xFFFF;
     }
+#endif
+}
+
+/* _____FUNCTIONS_____________________________________________________ */
+void hdlc_init(hdlc_put_char_t    put_char,
+               hdlc_on_rx_frame_t on_rx_frame)
+{
+    hdlc_rx_frame_index = 0;
+    hdlc_rx_frame_fcs   = CRC16_CCITT_INIT_VAL;
+    hdlc_rx_char_esc    = FALSE;
+#if HDLC_PBUF
+    hdlc_rx_pbuf          = NULL;
+    hdlc_rx_frame_discard = FALSE;
+#endif
+    hdlc_put_char       = put_char;
+    hdlc_on_rx_frame    = on_rx_frame;
+}
+
+void hdlc_on_rx_byte(u8_t data)
+{
+    PROF_BEGIN(PROF_ID_HDLC_RX);
+    hdlc_process_rx_byte(data);
+    PROF_END(PROF_ID_HDLC_RX);
 }
 
 void hdlc_tx_frame(const u8_t *buffer, u8_t bytes_to_send)
@@ -151,51 +243,59 @@ void hdlc_tx_frame(const u8_t *buffer, u8_t bytes_to_send)
         data = *buffer++;
         
         // Update checksum
-        crc16_ccitt_calc_byte(fcs,data);
-        
-        // See if data should be escaped
-        if((data == HDLC_CONTROL_ESCAPE) || (data == HDLC_FLAG_SEQUENCE))
-        {
-            hdlc_tx_byte(HDLC_CONTROL_ESCAPE);
-            data ^= HDLC_ESCAPE_BIT;
-        }
+        fcs = crc16_ccitt_calc_byte(fcs,data);
         
         // Send data
-        hdlc_tx_byte(data);
+        hdlc_tx_escaped_byte(data);
         
         // decrement counter
         bytes_to_send--;
     }
 
-    // Invert checksum
-    fcs ^= 0xffff;
+    // Send FCS and end marker
+    hdlc_tx_end(fcs);
+}
 
-    // Low byte of inverted FCS
-    data = U16_LO8(fcs);
-    if((data == HDLC_CONTROL_ESCAPE) || (data == HDLC_FLAG_SEQUENCE))
-    {
-        hdlc_tx_byte(HDLC_CONTROL_ESCAPE);
-        data ^= HDLC_ESCAPE_BIT;
-    }
-    hdlc_tx_byte(data);
+#if HDLC_PBUF
+void hdlc_tx_pbuf(const pbuf_t *frame)
+{
+    const u8_t *buffer;
+    u16_t      bytes_to_send;
+    u16_t      fcs = CRC16_CCITT_INIT_VAL;    
 
-    // High byte of inverted FCS
-    data = U16_HI8(fcs);
-    if((data == HDLC_CONTROL_ESCAPE) || (data == HDLC_FLAG_SEQUENCE))
+    // Start marker
+    hdlc_tx_byte(HDLC_FLAG_SEQUENCE);
+
+    // Send escaped data of each buffer in chain
+    while(frame != NULL)
     {
-        hdlc_tx_byte(HDLC_CONTROL_ESCAPE);
-        data ^= HDLC_ESCAPE_BIT;
+        buffer        = frame->payload;
+        bytes_to_send = frame->len;
+        while(bytes_to_send)
+        {
+            fcs = crc16_ccitt_calc_byte(fcs,*buffer);
+            hdlc_tx_escaped_byte(*buffer++);
+            bytes_to_send--;
+        }
+        frame = frame->next;
     }
-    hdlc_tx_byte(data);
 
-    // End marker
-    hdlc_tx_byte(HDLC_FLAG_SEQUENCE);    
+    // Send FCS and end marker
+    hdlc_tx_end(fcs);
 }
+#endif
 
 /* _____LOG__________________________________________________________________ */
 /*
 
  2007-03-31 : Pieter Conradie
  - First release
+
+ 2026-10-19 : agent
+ - Fixed FCS calculation (return value of crc16_ccitt_calc_byte() was
+   discarded) and initial FCS value
+ - Removed dependency on uart1.h
+ - Added option to receive and send frames in packet buffers (HDLC_PBUF)
+ - Added profiler markers (PROF)
    
 */
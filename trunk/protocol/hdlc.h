@@ -90,6 +90,15 @@
  * @par Reference:
  *  - <a href="http://tools.ietf.org/html/rfc1662">RFC 1662 "PPP in HDLC-like Framing"</a>
  *  
+ *  @par Packet buffers
+ *  If #HDLC_PBUF is set to 1, frames are received directly into a chain of
+ *  @ref PBUF packet buffers instead of a static buffer of #HDLC_MRU bytes.
+ *  The frame handler receives ownership of the chain and must release it 
+ *  with pbuf_free(), or pass it on, e.g. to at45d_write_page_pbuf(). 
+ *  #HDLC_PBUF_RESERVE bytes are reserved in front of the data for a header
+ *  that the application adds with pbuf_header(). A chain can be sent with 
+ *  hdlc_tx_pbuf().
+ *
  *  @par Example:
  *  @include hdlc_test.c
  *
@@ -100,6 +109,9 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
+#if HDLC_PBUF
+#include "pbuf.h"
+#endif
 
 /* _____DEFINITIONS _________________________________________________________ */
 #ifndef HDLC_MRU
@@ -107,6 +119,16 @@
 #define HDLC_MRU    64
 #endif
 
+#ifndef HDLC_PBUF
+/// Flag to receive frames into packet buffers (see @ref PBUF)
+#define HDLC_PBUF   0
+#endif
+
+#ifndef HDLC_PBUF_RESERVE
+/// Number of bytes reserved in front of a received frame for a header
+#define HDLC_PBUF_RESERVE 0
+#endif
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /**
  * Definition for a pointer to a function that will be called to 
@@ -114,11 +136,19 @@
  */
 typedef void (*hdlc_put_char_t)(char data);
 
+#if HDLC_PBUF
+/**
+ * Definition for a pointer to a function that will be called once a frame 
+ * has been received. The handler becomes the owner of the frame.
+ */
+typedef void (*hdlc_on_rx_frame_t)(pbuf_t *frame);
+#else
 /**
  * Definition for a pointer to a function that will be called once a frame 
  * has been received.
  */
 typedef void (*hdlc_on_rx_frame_t)(const u8_t *buffer, u16_t bytes_received);
+#endif
 
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
@@ -151,6 +181,18 @@ extern void hdlc_on_rx_byte(u8_t data);
  */
 extern void hdlc_tx_frame(const u8_t *buffer, u8_t bytes_to_send);
 
+#if HDLC_PBUF
+/**
+ *  Encapsulate and send a chain of packet buffers as an HDLC frame.
+ * 
+ *  The chain is not released.
+ * 
+ *  @param[in] frame    First buffer of chain containing data for transmission
+ *
+ */
+extern void hdlc_tx_pbuf(const pbuf_t *frame);
+#endif
+
 /**
  *  @}
  */
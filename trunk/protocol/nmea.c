@@ -42,11 +42,16 @@
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "nmea.h"
+#include "prof.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 // Receive and transmit buffer size
 #define NMEA_BUFFER_SIZE    128
 
+#if NMEA_PBUF && (PBUF_DATA_SIZE < NMEA_BUFFER_SIZE)
+#error "PBUF_DATA_SIZE must be at least NMEA_BUFFER_SIZE"
+#endif
+
 typedef enum
 {
    NMEA_RX_STATE_START = 0,
@@ -67,7 +72,13 @@ static nmea_tx_byte_t           nmea_tx_byte_fn;
 static nmea_on_valid_str_t      nmea_on_valid_str_fn;
 static nmea_on_valid_gps_data_t nmea_on_valid_gps_data_fn;
 
+#if NMEA_PBUF
+static nmea_on_rx_pbuf_t        nmea_on_rx_pbuf_fn;
+static pbuf_t                   *nmea_rx_pbuf;
+static u8_t                     *nmea_rx_buffer;
+#else
 static u8_t                     nmea_rx_buffer[NMEA_BUFFER_SIZE];
+#endif
 static u16_t                    nmea_rx_index;
 static u8_t                     nmea_rx_checksum;
 static nmea_rx_state_t          nmea_rx_state;
@@ -398,24 +409,8 @@ static void nmea_on_rx_frame(char* buffer)
    }
 }
 
-/* _____GLOBAL FUNCTIONS_____________________________________________________ */
-void nmea_init(nmea_tx_byte_t           tx_byte,
-               nmea_on_valid_str_t      on_valid_str,
-               nmea_on_valid_gps_data_t on_valid_gps_data)
-{
-    // Save function pointers
-    nmea_tx_byte_fn           = tx_byte;
-    nmea_on_valid_str_fn      = on_valid_str;
-    nmea_on_valid_gps_data_fn = on_valid_gps_data;
-
-   // Reset state variables
-   nmea_rx_state            = NMEA_RX_STATE_START;
-   nmea_rx_index            = 0;
-   nmea_data.gga_valid_flag = FALSE;
-   nmea_data.vtg_valid_flag = FALSE;
-}
-
-void nmea_on_rx_byte(u8_t data)
+/// Process received byte (see nmea_on_rx_byte())
+static void nmea_process_rx_byte(u8_t data)
 {   
    switch(nmea_rx_state)
    {
@@ -426,6 +421,20 @@ void nmea_on_rx_byte(u8_t data)
          {
              break;
          }
+#if NMEA_PBUF
+         // Allocate buffer for sentence (rest of data area is header reserve)
+         if(nmea_rx_pbuf == NULL)
+         {
+             nmea_rx_pbuf = pbuf_alloc(NMEA_BUFFER_SIZE, 
+                                       PBUF_DATA_SIZE - NMEA_BUFFER_SIZE);
+             if(nmea_rx_pbuf == NULL)
+             {
+                 // Out of buffers; ignore sentence
+                 break;
+             }
+             nmea_rx_buffer = nmea_rx_pbuf->payload;
+         }
+#endif
          nmea_rx_state = NMEA_RX_STATE_PAYLOAD;
          // Reset index and checksum
          nmea_rx_checksum = 0;
@@ -502,6 +511,15 @@ void nmea_on_rx_byte(u8_t data)
          nmea_rx_buffer[nmea_rx_index] = '\0';
          // String successfully received
          nmea_on_rx_frame((char*)nmea_rx_buffer);
+#if NMEA_PBUF
+         // Pass on buffer with sentence; handler becomes owner
+         if(nmea_on_rx_pbuf_fn != NULL)
+         {
+             pbuf_trim(nmea_rx_pbuf, nmea_rx_index);
+             (*nmea_on_rx_pbuf_fn)(nmea_rx_pbuf);
+             nmea_rx_pbuf = NULL;
+         }
+#endif
          break;
       }   
    }
@@ -509,6 +527,37 @@ void nmea_on_rx_byte(u8_t data)
    nmea_rx_state = NMEA_RX_STATE_START;
 }
 
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void nmea_init(nmea_tx_byte_t           tx_byte,
+               nmea_on_valid_str_t      on_valid_str,
+               nmea_on_valid_gps_data_t on_valid_gps_data)
+{
+    // Save function pointers
+    nmea_tx_byte_fn           = tx_byte;
+    nmea_on_valid_str_fn      = on_valid_str;
+    nmea_on_valid_gps_data_fn = on_valid_gps_data;
+
+   // Reset state variables
+   nmea_rx_state            = NMEA_RX_STATE_START;
+   nmea_rx_index            = 0;
+   nmea_data.gga_valid_flag = FALSE;
+   nmea_data.vtg_valid_flag = FALSE;
+}
+
+void nmea_on_rx_byte(u8_t data)
+{
+    PROF_BEGIN(PROF_ID_NMEA_RX);
+    nmea_process_rx_byte(data);
+    PROF_END(PROF_ID_NMEA_RX);
+}
+
+#if NMEA_PBUF
+void nmea_set_rx_pbuf_handler(nmea_on_rx_pbuf_t on_rx_pbuf)
+{
+    nmea_on_rx_pbuf_fn = on_rx_pbuf;
+}
+#endif
+
 void nmea_tx_frame(char* frame)
 {
    u8_t  data;
@@ -554,5 +603,9 @@ void nmea_tx_frame(char* frame)
 
  2010/05/28 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added option to receive sentences in packet buffers (NMEA_PBUF)
+ - Added profiler markers (PROF)
    
 */
@@ -47,6 +47,13 @@
  *  
  *  Files: nmea.h & nmea.c
  *  
+ *  @par Packet buffers
+ *  If #NMEA_PBUF is set to 1, sentences are received directly into a 
+ *  @ref PBUF packet buffer. After the sentence has been parsed, the buffer 
+ *  is passed on to the handler set with nmea_set_rx_pbuf_handler(), e.g. to 
+ *  log raw sentences to DataFlash without copying them. The unused part of 
+ *  the data area in front of the sentence is available as header reserve.
+ *  
  *  @see http://en.wikipedia.org/wiki/NMEA_0183
  *  
  *  @{
@@ -58,6 +65,15 @@
 #include "common.h"
 
 /* _____DEFINITIONS _________________________________________________________ */
+#ifndef NMEA_PBUF
+/// Flag to receive sentences into packet buffers (see @ref PBUF)
+#define NMEA_PBUF 0
+#endif
+
+#if NMEA_PBUF
+#include "pbuf.h"
+#endif
+
 // NMEA output strings
 #define NMEA_GGA_STR "GGA" /* Time, position and fix type data. */
 #define NMEA_GLL_STR "GLL" /* Latitude, longitude, UTC time of position fix and status. */
@@ -87,6 +103,15 @@ typedef void (*nmea_on_valid_str_t)(const char* data);
  */
 typedef void (*nmea_on_valid_gps_data_t)(void);
 
+#if NMEA_PBUF
+/**
+ * Definition for a pointer to a function that will be called with the 
+ * packet buffer of a valid NMEA sentence. The handler becomes the owner of 
+ * the buffer.
+ */
+typedef void (*nmea_on_rx_pbuf_t)(pbuf_t *sentence);
+#endif
+
 /// Parsed time, position, quality data
 typedef struct
 {
@@ -137,6 +162,18 @@ extern void nmea_init      (nmea_tx_byte_t           tx_byte,
  */
 extern void nmea_on_rx_byte(u8_t data);
 
+#if NMEA_PBUF
+/**
+ * Set handler that receives the packet buffer of each valid sentence.
+ * 
+ * The payload is the sentence between '$' and '*' (without checksum). If 
+ * no handler is set, the buffer is reused for the next sentence.
+ * 
+ * @param on_rx_pbuf    Pointer to handler; NULL to remove handler
+ */
+extern void nmea_set_rx_pbuf_handler(nmea_on_rx_pbuf_t on_rx_pbuf);
+#endif
+
 /**
  * Function that is called to send an NMEA frame with the checksum appended.
  * 
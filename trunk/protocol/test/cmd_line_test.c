@@ -9,6 +9,9 @@ static cmd_line_t cmd_line_led;
 static cmd_line_t cmd_line_led_on;
 static cmd_line_t cmd_line_led_off;
 
+// Script that is executed in batch mode (no echo or prompt)
+static const char cmd_line_script[] = "led on\nled off\n";
+
 static const char* cmd_line_handler_led(int argc, char* argv[])
 {
     if(BIT_IS_HI(PORT_LED_O,BIT_LED_O))
@@ -60,6 +63,9 @@ void cmd_line_test(void)
     cmd_line_add_child(&cmd_line_led,&cmd_line_led_on, "on", &cmd_line_handler_led_on, "switch led on"        );
     cmd_line_add_child(&cmd_line_led,&cmd_line_led_off,"off",&cmd_line_handler_led_off,"switch led off"       );
 
+    // Execute script; only errors are reported
+    cmd_line_exec_buffer(cmd_line_script, sizeof(cmd_line_script)-1);
+
     PRINTF("\nCommand Line test\n\n");
 
     for(;;)
@@ -0,0 +1,234 @@
+/*
+ * Host (Linux) test and benchmark of the binary RPC channel vs. the text 
+ * command line over a pseudo terminal loopback.
+ * 
+ * The "device" runs in a child process on the slave side of the pty and 
+ * the client runs on the master side. Build with CMD_LINE_RPC=1, e.g.:
+ * 
+ * gcc -O2 -DCMD_LINE_RPC=1 -I. -I../general -I<dir with board.h> 
+ *     test/cmd_rpc_test.c cmd_rpc.c cmd_rpc_client.c cmd_line.c vt100.c 
+ *     hdlc.c crc16_ccitt.c -o cmd_rpc_test
+ */
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include "cmd_line.h"
+#include "cmd_rpc.h"
+#include "cmd_rpc_client.h"
+
+#define NR_OF_REQUESTS 10000
+
+static int  fd_tx;
+static u8_t tx_buffer[512];
+static int  tx_index;
+
+static cmd_line_t cmd_line_add_nr;
+
+static void put_char(char data)
+{
+    tx_buffer[tx_index++] = (u8_t)data;
+    if(tx_index == sizeof(tx_buffer))
+    {
+        write(fd_tx, tx_buffer, tx_index);
+        tx_index = 0;
+    }
+}
+
+static void flush(void)
+{
+    if(tx_index != 0)
+    {
+        write(fd_tx, tx_buffer, tx_index);
+        tx_index = 0;
+    }
+}
+
+static const char* cmd_line_handler_add(int argc, char* argv[])
+{
+    static char str[12];
+    long a;
+    long b;
+
+    if(  (argc != 2)
+       ||(!cmd_line_strtol(argv[0], &a, 0, 0x7fffffff))
+       ||(!cmd_line_strtol(argv[1], &b, 0, 0x7fffffff))  )
+    {
+        return "Error!";
+    }
+    sprintf(str, "%ld", a+b);
+    return str;
+}
+
+static u8_t cmd_rpc_handler_add(cmd_rpc_buf_t *args, cmd_rpc_buf_t *results)
+{
+    u32_t a;
+    u32_t b;
+
+    if(!cmd_rpc_get_u32(args, &a) || !cmd_rpc_get_u32(args, &b))
+    {
+        return CMD_RPC_ERR_ARGS;
+    }
+    cmd_rpc_put_u32(results, a+b);
+    return CMD_RPC_OK;
+}
+
+static void device(int fd)
+{
+    u8_t    buffer[256];
+    ssize_t i;
+    ssize_t n;
+
+    fd_tx = fd;
+    cmd_line_init(&put_char);
+    cmd_line_add(&cmd_line_add_nr, "add", &cmd_line_handler_add, "add two numbers");
+    cmd_line_set_rpc_handler(&cmd_line_add_nr, &cmd_rpc_handler_add);
+    cmd_rpc_init(&put_char);
+    flush();
+
+    while((n = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        for(i=0; i<n; i++)
+        {
+            cmd_rpc_on_rx_byte(buffer[i]);
+        }
+        flush();
+    }
+    exit(0);
+}
+
+static void wait_rsp(int fd)
+{
+    u8_t    buffer[256];
+    ssize_t i;
+    ssize_t n;
+
+    while(!cmd_rpc_client_rsp_received())
+    {
+        n = read(fd, buffer, sizeof(buffer));
+        for(i=0; i<n; i++)
+        {
+            cmd_rpc_client_on_rx_byte(buffer[i]);
+        }
+    }
+}
+
+static void wait_prompt(int fd)
+{
+    char data;
+
+    do
+    {
+        read(fd, &data, 1);
+    }
+    while(data != '>');
+}
+
+static double time_s(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec/1e6;
+}
+
+int main(void)
+{
+    int            fd_master;
+    int            fd_slave;
+    struct termios tio;
+    pid_t          pid;
+    u8_t           id;
+    u8_t           id_add = 0;
+    u8_t           parent_id;
+    const char    *name;
+    cmd_rpc_buf_t *buf;
+    u32_t          sum;
+    int            i;
+    double         t;
+
+    // Create pty loopback in raw mode
+    fd_master = posix_openpt(O_RDWR|O_NOCTTY);
+    grantpt(fd_master);
+    unlockpt(fd_master);
+    fd_slave  = open(ptsname(fd_master), O_RDWR|O_NOCTTY);
+    tcgetattr(fd_slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(fd_slave, TCSANOW, &tio);
+
+    pid = fork();
+    if(pid == 0)
+    {
+        close(fd_master);
+        device(fd_slave);
+    }
+    close(fd_slave);
+    fd_tx = fd_master;
+    cmd_rpc_client_init(&put_char);
+
+    // Initial prompt
+    wait_prompt(fd_master);
+
+    // Enumerate commands
+    for(id=1; ; id++)
+    {
+        buf = cmd_rpc_client_req_begin(CMD_RPC_ID_ENUM);
+        cmd_rpc_put_u8(buf, id);
+        cmd_rpc_client_req_send();
+        flush();
+        wait_rsp(fd_master);
+        if(cmd_rpc_client_rsp_status() != CMD_RPC_OK)
+        {
+            break;
+        }
+        buf = cmd_rpc_client_rsp_results();
+        cmd_rpc_get_str(buf, &name);
+        cmd_rpc_get_u8(buf, &parent_id);
+        printf("ID %d : %s (parent %d)\n", id, name, parent_id);
+        if((name[0] == 'a') && (parent_id == 0))
+        {
+            id_add = id;
+        }
+    }
+
+    // Binary RPC
+    t = time_s();
+    for(i=0; i<NR_OF_REQUESTS; i++)
+    {
+        buf = cmd_rpc_client_req_begin(id_add);
+        cmd_rpc_put_u32(buf, i);
+        cmd_rpc_put_u32(buf, 1);
+        cmd_rpc_client_req_send();
+        flush();
+        wait_rsp(fd_master);
+        if(  (cmd_rpc_client_rsp_status() != CMD_RPC_OK)
+           ||(!cmd_rpc_get_u32(cmd_rpc_client_rsp_results(), &sum))
+           ||(sum != (u32_t)(i+1))                                  )
+        {
+            printf("RPC FAILED at request %d\n", i);
+            return 1;
+        }
+    }
+    t = time_s() - t;
+    printf("Binary RPC : %.0f requests/s\n", NR_OF_REQUESTS/t);
+
+    // Text command line
+    t = time_s();
+    for(i=0; i<NR_OF_REQUESTS; i++)
+    {
+        char str[32];
+        int  n = sprintf(str, "add %d 1\r", i);
+        write(fd_master, str, n);
+        wait_prompt(fd_master);
+    }
+    t = time_s() - t;
+    printf("Text       : %.0f requests/s\n", NR_OF_REQUESTS/t);
+
+    kill(pid, SIGTERM);
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <avr/interrupt.h>
+
+#include "uart0.h"
+#include "systmr.h"
+#include "tmr.h"
+#include "vt100.h"
+
+// Off-screen copy of the dashboard
+static vt100_screen_t vt100_screen;
+
+static void main_put_char(char data)
+{
+    while(!uart0_tx_byte((u8_t)data))
+    {
+        ;
+    }
+}
+
+void vt100_test(void)
+{
+    tmr_t  tmr;
+    u16_t  seconds = 0;
+    u16_t  bytes_sent;
+    char   str[32];
+
+    // Initialise modules
+    uart0_init(115200,8,UART0_NO_PARITY,1);
+    systmr_init();
+
+    // Enable global interrupts
+    sei();
+
+    // Initialise VT100 terminal helper and screen model
+    vt100_init(&main_put_char);
+    vt100_screen_init(&vt100_screen);
+
+    // Static part of dashboard
+    vt100_screen_put_str(&vt100_screen, 0, 0, "VT100 dashboard test");
+    vt100_screen_put_str(&vt100_screen, 2, 0, "Uptime     :");
+    vt100_screen_put_str(&vt100_screen, 3, 0, "Bytes sent :");
+
+    tmr_start(&tmr, TMR_MS_TO_TICKS(1000));
+    for(;;)
+    {
+        // Update dashboard
+        sprintf(str, "%5u s", seconds);
+        vt100_screen_put_str(&vt100_screen, 2, 13, str);
+
+        // Only the changed cells are sent
+        bytes_sent = vt100_screen_render(&vt100_screen);
+
+        // Display number of bytes sent for previous refresh
+        sprintf(str, "%5u", bytes_sent);
+        vt100_screen_put_str(&vt100_screen, 3, 13, str);
+
+        // Wait until timer has expired
+        while(!tmr_has_expired(&tmr))
+        {
+            ;
+        }
+        tmr_reset(&tmr);
+        seconds++;
+    }
+}
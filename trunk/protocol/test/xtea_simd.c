@@ -0,0 +1,474 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          XTEA multi-block SIMD implementation for host tools
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <emmintrin.h>
+#include <immintrin.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "xtea_simd.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "xtea_simd.c requires an x86 or x86-64 host"
+#endif
+
+#define XTEA_DELTA          0x9E3779B9
+
+/// Number of round keys
+#define XTEA_SIMD_RK_WORDS  (2*XTEA_NUMBER_OF_ROUNDS)
+
+/**
+ * Number of blocks that are processed per group.
+ * 
+ * One vector alone is limited by the latency of the dependent operations
+ * in a round, so 4 independent vectors (a0..a3 = word 0, b0..b3 = word 1) 
+ * are interleaved in each round to keep the execution units busy. This 
+ * fits in the 16 SIMD registers of x86-64. AVX2 processes one group of
+ * 4 x 8 lanes per pass and SSE2 two groups of 4 x 4 lanes.
+ */
+#define XTEA_SIMD_LANES     32
+
+/* _____MACROS_______________________________________________________________ */
+/// Load big endian 32-bit value from byte array
+#define XTEA_LOAD_BE32(p)       (  (((u32_t)(p)[0])<<24) | (((u32_t)(p)[1])<<16) \
+                                 | (((u32_t)(p)[2])<<8)  | ((u32_t)(p)[3])       )
+
+/// Store 32-bit value in byte array in big endian order
+#define XTEA_STORE_BE32(p,val)  { (p)[0] = U32_HI8(val); (p)[1] = U32_MH8(val); \
+                                  (p)[2] = U32_ML8(val); (p)[3] = U32_LO8(val); }
+
+/// XTEA F-function on a vector: ((v << 4) ^ (v >> 5)) + v
+#define XTEA_SIMD_F128(v) \
+    _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(v, 4), _mm_srli_epi32(v, 5)), v)
+
+/// XTEA F-function on an AVX2 vector
+#define XTEA_SIMD_F256(v) \
+    _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(v, 4), _mm256_srli_epi32(v, 5)), v)
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Function that processes a group of #XTEA_SIMD_LANES blocks
+typedef void (*xtea_simd_group_t)(const u32_t *rk, u32_t *d0, u32_t *d1);
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+
+/* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+/// Get round keys from context (expanded here if XTEA_KEY_SCHEDULE is disabled)
+static const u32_t* xtea_simd_get_rk(const xtea_ctx_t *ctx, u32_t rk[XTEA_SIMD_RK_WORDS])
+{
+#if XTEA_KEY_SCHEDULE
+    (void)rk;
+    return ctx->key;
+#else
+    u8_t  i;
+    u32_t sum = 0;
+
+    for(i=0; i<XTEA_SIMD_RK_WORDS; i+=2)
+    {
+        rk[i]   = sum + ctx->key[sum & 3];
+        sum    += XTEA_DELTA;
+        rk[i+1] = sum + ctx->key[(sum>>11) & 3];
+    }
+    return rk;
+#endif
+}
+
+static void xtea_simd_encrypt_sse2(const u32_t *rk, u32_t *d0, u32_t *d1)
+{
+    u8_t    g;
+    u8_t    i;
+    __m128i a0, a1, a2, a3;
+    __m128i b0, b1, b2, b3;
+    __m128i k;
+
+    for(g=0; g<XTEA_SIMD_LANES; g+=16)
+    {
+        a0 = _mm_loadu_si128((const __m128i *)&d0[g+0]);
+        b0 = _mm_loadu_si128((const __m128i *)&d1[g+0]);
+        a1 = _mm_loadu_si128((const __m128i *)&d0[g+4]);
+        b1 = _mm_loadu_si128((const __m128i *)&d1[g+4]);
+        a2 = _mm_loadu_si128((const __m128i *)&d0[g+8]);
+        b2 = _mm_loadu_si128((const __m128i *)&d1[g+8]);
+        a3 = _mm_loadu_si128((const __m128i *)&d0[g+12]);
+        b3 = _mm_loadu_si128((const __m128i *)&d1[g+12]);
+        for(i=0; i<XTEA_SIMD_RK_WORDS; i+=2)
+        {
+            k  = _mm_set1_epi32(rk[i]);
+            a0 = _mm_add_epi32(a0, _mm_xor_si128(XTEA_SIMD_F128(b0), k));
+            a1 = _mm_add_epi32(a1, _mm_xor_si128(XTEA_SIMD_F128(b1), k));
+            a2 = _mm_add_epi32(a2, _mm_xor_si128(XTEA_SIMD_F128(b2), k));
+            a3 = _mm_add_epi32(a3, _mm_xor_si128(XTEA_SIMD_F128(b3), k));
+            k  = _mm_set1_epi32(rk[i+1]);
+            b0 = _mm_add_epi32(b0, _mm_xor_si128(XTEA_SIMD_F128(a0), k));
+            b1 = _mm_add_epi32(b1, _mm_xor_si128(XTEA_SIMD_F128(a1), k));
+            b2 = _mm_add_epi32(b2, _mm_xor_si128(XTEA_SIMD_F128(a2), k));
+            b3 = _mm_add_epi32(b3, _mm_xor_si128(XTEA_SIMD_F128(a3), k));
+        }
+        _mm_storeu_si128((__m128i *)&d0[g+0], a0);
+        _mm_storeu_si128((__m128i *)&d1[g+0], b0);
+        _mm_storeu_si128((__m128i *)&d0[g+4], a1);
+        _mm_storeu_si128((__m128i *)&d1[g+4], b1);
+        _mm_storeu_si128((__m128i *)&d0[g+8], a2);
+        _mm_storeu_si128((__m128i *)&d1[g+8], b2);
+        _mm_storeu_si128((__m128i *)&d0[g+12], a3);
+        _mm_storeu_si128((__m128i *)&d1[g+12], b3);
+    }
+}
+
+static void xtea_simd_decrypt_sse2(const u32_t *rk, u32_t *d0, u32_t *d1)
+{
+    u8_t    g;
+    u8_t    i;
+    __m128i a0, a1, a2, a3;
+    __m128i b0, b1, b2, b3;
+    __m128i k;
+
+    for(g=0; g<XTEA_SIMD_LANES; g+=16)
+    {
+        a0 = _mm_loadu_si128((const __m128i *)&d0[g+0]);
+        b0 = _mm_loadu_si128((const __m128i *)&d1[g+0]);
+        a1 = _mm_loadu_si128((const __m128i *)&d0[g+4]);
+        b1 = _mm_loadu_si128((const __m128i *)&d1[g+4]);
+        a2 = _mm_loadu_si128((const __m128i *)&d0[g+8]);
+        b2 = _mm_loadu_si128((const __m128i *)&d1[g+8]);
+        a3 = _mm_loadu_si128((const __m128i *)&d0[g+12]);
+        b3 = _mm_loadu_si128((const __m128i *)&d1[g+12]);
+        for(i=XTEA_SIMD_RK_WORDS; i!=0; i-=2)
+        {
+            k  = _mm_set1_epi32(rk[i-1]);
+            b0 = _mm_sub_epi32(b0, _mm_xor_si128(XTEA_SIMD_F128(a0), k));
+            b1 = _mm_sub_epi32(b1, _mm_xor_si128(XTEA_SIMD_F128(a1), k));
+            b2 = _mm_sub_epi32(b2, _mm_xor_si128(XTEA_SIMD_F128(a2), k));
+            b3 = _mm_sub_epi32(b3, _mm_xor_si128(XTEA_SIMD_F128(a3), k));
+            k  = _mm_set1_epi32(rk[i-2]);
+            a0 = _mm_sub_epi32(a0, _mm_xor_si128(XTEA_SIMD_F128(b0), k));
+            a1 = _mm_sub_epi32(a1, _mm_xor_si128(XTEA_SIMD_F128(b1), k));
+            a2 = _mm_sub_epi32(a2, _mm_xor_si128(XTEA_SIMD_F128(b2), k));
+            a3 = _mm_sub_epi32(a3, _mm_xor_si128(XTEA_SIMD_F128(b3), k));
+        }
+        _mm_storeu_si128((__m128i *)&d0[g+0], a0);
+        _mm_storeu_si128((__m128i *)&d1[g+0], b0);
+        _mm_storeu_si128((__m128i *)&d0[g+4], a1);
+        _mm_storeu_si128((__m128i *)&d1[g+4], b1);
+        _mm_storeu_si128((__m128i *)&d0[g+8], a2);
+        _mm_storeu_si128((__m128i *)&d1[g+8], b2);
+        _mm_storeu_si128((__m128i *)&d0[g+12], a3);
+        _mm_storeu_si128((__m128i *)&d1[g+12], b3);
+    }
+}
+
+__attribute__((target("avx2")))
+static void xtea_simd_encrypt_avx2(const u32_t *rk, u32_t *d0, u32_t *d1)
+{
+    u8_t    g;
+    u8_t    i;
+    __m256i a0, a1, a2, a3;
+    __m256i b0, b1, b2, b3;
+    __m256i k;
+
+    for(g=0; g<XTEA_SIMD_LANES; g+=32)
+    {
+        a0 = _mm256_loadu_si256((const __m256i *)&d0[g+0]);
+        b0 = _mm256_loadu_si256((const __m256i *)&d1[g+0]);
+        a1 = _mm256_loadu_si256((const __m256i *)&d0[g+8]);
+        b1 = _mm256_loadu_si256((const __m256i *)&d1[g+8]);
+        a2 = _mm256_loadu_si256((const __m256i *)&d0[g+16]);
+        b2 = _mm256_loadu_si256((const __m256i *)&d1[g+16]);
+        a3 = _mm256_loadu_si256((const __m256i *)&d0[g+24]);
+        b3 = _mm256_loadu_si256((const __m256i *)&d1[g+24]);
+        for(i=0; i<XTEA_SIMD_RK_WORDS; i+=2)
+        {
+            k  = _mm256_set1_epi32(rk[i]);
+            a0 = _mm256_add_epi32(a0, _mm256_xor_si256(XTEA_SIMD_F256(b0), k));
+            a1 = _mm256_add_epi32(a1, _mm256_xor_si256(XTEA_SIMD_F256(b1), k));
+            a2 = _mm256_add_epi32(a2, _mm256_xor_si256(XTEA_SIMD_F256(b2), k));
+            a3 = _mm256_add_epi32(a3, _mm256_xor_si256(XTEA_SIMD_F256(b3), k));
+            k  = _mm256_set1_epi32(rk[i+1]);
+            b0 = _mm256_add_epi32(b0, _mm256_xor_si256(XTEA_SIMD_F256(a0), k));
+            b1 = _mm256_add_epi32(b1, _mm256_xor_si256(XTEA_SIMD_F256(a1), k));
+            b2 = _mm256_add_epi32(b2, _mm256_xor_si256(XTEA_SIMD_F256(a2), k));
+            b3 = _mm256_add_epi32(b3, _mm256_xor_si256(XTEA_SIMD_F256(a3), k));
+        }
+        _mm256_storeu_si256((__m256i *)&d0[g+0], a0);
+        _mm256_storeu_si256((__m256i *)&d1[g+0], b0);
+        _mm256_storeu_si256((__m256i *)&d0[g+8], a1);
+        _mm256_storeu_si256((__m256i *)&d1[g+8], b1);
+        _mm256_storeu_si256((__m256i *)&d0[g+16], a2);
+        _mm256_storeu_si256((__m256i *)&d1[g+16], b2);
+        _mm256_storeu_si256((__m256i *)&d0[g+24], a3);
+        _mm256_storeu_si256((__m256i *)&d1[g+24], b3);
+    }
+}
+
+__attribute__((target("avx2")))
+static void xtea_simd_decrypt_avx2(const u32_t *rk, u32_t *d0, u32_t *d1)
+{
+    u8_t    g;
+    u8_t    i;
+    __m256i a0, a1, a2, a3;
+    __m256i b0, b1, b2, b3;
+    __m256i k;
+
+    for(g=0; g<XTEA_SIMD_LANES; g+=32)
+    {
+        a0 = _mm256_loadu_si256((const __m256i *)&d0[g+0]);
+        b0 = _mm256_loadu_si256((const __m256i *)&d1[g+0]);
+        a1 = _mm256_loadu_si256((const __m256i *)&d0[g+8]);
+        b1 = _mm256_loadu_si256((const __m256i *)&d1[g+8]);
+        a2 = _mm256_loadu_si256((const __m256i *)&d0[g+16]);
+        b2 = _mm256_loadu_si256((const __m256i *)&d1[g+16]);
+        a3 = _mm256_loadu_si256((const __m256i *)&d0[g+24]);
+        b3 = _mm256_loadu_si256((const __m256i *)&d1[g+24]);
+        for(i=XTEA_SIMD_RK_WORDS; i!=0; i-=2)
+        {
+            k  = _mm256_set1_epi32(rk[i-1]);
+            b0 = _mm256_sub_epi32(b0, _mm256_xor_si256(XTEA_SIMD_F256(a0), k));
+            b1 = _mm256_sub_epi32(b1, _mm256_xor_si256(XTEA_SIMD_F256(a1), k));
+            b2 = _mm256_sub_epi32(b2, _mm256_xor_si256(XTEA_SIMD_F256(a2), k));
+            b3 = _mm256_sub_epi32(b3, _mm256_xor_si256(XTEA_SIMD_F256(a3), k));
+            k  = _mm256_set1_epi32(rk[i-2]);
+            a0 = _mm256_sub_epi32(a0, _mm256_xor_si256(XTEA_SIMD_F256(b0), k));
+            a1 = _mm256_sub_epi32(a1, _mm256_xor_si256(XTEA_SIMD_F256(b1), k));
+            a2 = _mm256_sub_epi32(a2, _mm256_xor_si256(XTEA_SIMD_F256(b2), k));
+            a3 = _mm256_sub_epi32(a3, _mm256_xor_si256(XTEA_SIMD_F256(b3), k));
+        }
+        _mm256_storeu_si256((__m256i *)&d0[g+0], a0);
+        _mm256_storeu_si256((__m256i *)&d1[g+0], b0);
+        _mm256_storeu_si256((__m256i *)&d0[g+8], a1);
+        _mm256_storeu_si256((__m256i *)&d1[g+8], b1);
+        _mm256_storeu_si256((__m256i *)&d0[g+16], a2);
+        _mm256_storeu_si256((__m256i *)&d1[g+16], b2);
+        _mm256_storeu_si256((__m256i *)&d0[g+24], a3);
+        _mm256_storeu_si256((__m256i *)&d1[g+24], b3);
+    }
+}
+
+static bool_t xtea_simd_has_avx2(void)
+{
+    static s8_t avx2 = -1;
+
+    if(avx2 < 0)
+    {
+        __builtin_cpu_init();
+        avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return (avx2 != 0);
+}
+
+/// Run ECB over a buffer in groups of XTEA_SIMD_LANES blocks
+static void xtea_simd_ecb(const xtea_ctx_t *ctx,
+                          const u8_t       *in,
+                          u8_t             *out,
+                          size_t           length,
+                          bool_t           encrypt)
+{
+    u8_t              i;
+    u8_t              blocks;
+    u32_t             rk_buf[XTEA_SIMD_RK_WORDS];
+    const u32_t       *rk = xtea_simd_get_rk(ctx, rk_buf);
+    u32_t             d0[XTEA_SIMD_LANES];
+    u32_t             d1[XTEA_SIMD_LANES];
+    xtea_simd_group_t group;
+
+    if(xtea_simd_has_avx2())
+    {
+        group = encrypt ? xtea_simd_encrypt_avx2 : xtea_simd_decrypt_avx2;
+    }
+    else
+    {
+        group = encrypt ? xtea_simd_encrypt_sse2 : xtea_simd_decrypt_sse2;
+    }
+
+    while(length != 0)
+    {
+        // Gather group of blocks (unused lanes of last group are zero)
+        blocks = XTEA_SIMD_LANES;
+        if(length < XTEA_SIMD_LANES*XTEA_BLOCK_SIZE)
+        {
+            blocks = length / XTEA_BLOCK_SIZE;
+        }
+        for(i=0; i<XTEA_SIMD_LANES; i++)
+        {
+            if(i < blocks)
+            {
+                d0[i] = XTEA_LOAD_BE32(&in[8*i]);
+                d1[i] = XTEA_LOAD_BE32(&in[8*i+4]);
+            }
+            else
+            {
+                d0[i] = 0;
+                d1[i] = 0;
+            }
+        }
+
+        (*group)(rk, d0, d1);
+
+        // Scatter
+        for(i=0; i<blocks; i++)
+        {
+            XTEA_STORE_BE32(&out[8*i],   d0[i]);
+            XTEA_STORE_BE32(&out[8*i+4], d1[i]);
+        }
+
+        in     += blocks*XTEA_BLOCK_SIZE;
+        out    += blocks*XTEA_BLOCK_SIZE;
+        length -= blocks*XTEA_BLOCK_SIZE;
+    }
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+bool_t xtea_simd_ecb_encrypt(const xtea_ctx_t *ctx,
+                             const u8_t       *in,
+                             u8_t             *out,
+                             size_t           length)
+{
+    if((length % XTEA_BLOCK_SIZE) != 0)
+    {
+        return FALSE;
+    }
+    xtea_simd_ecb(ctx, in, out, length, TRUE);
+
+    return TRUE;
+}
+
+bool_t xtea_simd_ecb_decrypt(const xtea_ctx_t *ctx,
+                             const u8_t       *in,
+                             u8_t             *out,
+                             size_t           length)
+{
+    if((length % XTEA_BLOCK_SIZE) != 0)
+    {
+        return FALSE;
+    }
+    xtea_simd_ecb(ctx, in, out, length, FALSE);
+
+    return TRUE;
+}
+
+void xtea_simd_ctr_crypt(xtea_ctx_t *ctx,
+                         const u8_t *in,
+                         u8_t       *out,
+                         size_t     length)
+{
+    u8_t              i;
+    u8_t              blocks;
+    u32_t             rk_buf[XTEA_SIMD_RK_WORDS];
+    const u32_t       *rk = xtea_simd_get_rk(ctx, rk_buf);
+    u32_t             d0[XTEA_SIMD_LANES];
+    u32_t             d1[XTEA_SIMD_LANES];
+    u32_t             c0;
+    u32_t             c1;
+    size_t            head;
+    xtea_simd_group_t group;
+
+    group = xtea_simd_has_avx2() ? xtea_simd_encrypt_avx2 : xtea_simd_encrypt_sse2;
+
+    // Use remainder of key stream block of previous call
+    head = XTEA_BLOCK_SIZE - ctx->stream_index;
+    if(head > length)
+    {
+        head = length;
+    }
+    xtea_ctr_crypt(ctx, in, out, head);
+    in     += head;
+    out    += head;
+    length -= head;
+
+    // Process full blocks in groups
+    c0 = ctx->iv[0];
+    c1 = ctx->iv[1];
+    while(length >= XTEA_BLOCK_SIZE)
+    {
+        blocks = XTEA_SIMD_LANES;
+        if(length < XTEA_SIMD_LANES*XTEA_BLOCK_SIZE)
+        {
+            blocks = length / XTEA_BLOCK_SIZE;
+        }
+
+        // Counter blocks
+        for(i=0; i<XTEA_SIMD_LANES; i++)
+        {
+            d0[i] = c0;
+            d1[i] = c1;
+            if(i < blocks)
+            {
+                if(++c1 == 0)
+                {
+                    c0++;
+                }
+            }
+        }
+
+        (*group)(rk, d0, d1);
+
+        for(i=0; i<blocks; i++)
+        {
+            d0[i] ^= XTEA_LOAD_BE32(&in[8*i]);
+            d1[i] ^= XTEA_LOAD_BE32(&in[8*i+4]);
+            XTEA_STORE_BE32(&out[8*i],   d0[i]);
+            XTEA_STORE_BE32(&out[8*i+4], d1[i]);
+        }
+
+        in     += blocks*XTEA_BLOCK_SIZE;
+        out    += blocks*XTEA_BLOCK_SIZE;
+        length -= blocks*XTEA_BLOCK_SIZE;
+    }
+    ctx->iv[0] = c0;
+    ctx->iv[1] = c1;
+
+    // Last partial block
+    xtea_ctr_crypt(ctx, in, out, length);
+}
+
+const char* xtea_simd_get_isa(void)
+{
+    return xtea_simd_has_avx2() ? "AVX2" : "SSE2";
+}
+
+/* _____LOG__________________________________________________________________ */
+/*
+
+ 2026/10/19 : agent
+ - Created
+   
+*/
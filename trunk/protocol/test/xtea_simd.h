@@ -0,0 +1,153 @@
+#ifndef __XTEA_SIMD_H__
+#define __XTEA_SIMD_H__
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          XTEA multi-block SIMD implementation for host tools
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/** 
+ *  @ingroup PROTOCOL
+ *  @defgroup XTEA_SIMD xtea_simd.h : XTEA multi-block SIMD implementation
+ *
+ *  Encrypts/decrypts several independent 64-bit blocks in parallel with 
+ *  SSE2 (4 lanes) or AVX2 (8 lanes) for host tools, e.g. to encrypt firmware
+ *  images on a build server or to decrypt large DataFlash dumps.
+ *  
+ *  Files: test/xtea_simd.h & test/xtea_simd.c
+ *  
+ *  The files are in "protocol/test" and not in "protocol", because they 
+ *  only build for an x86 or x86-64 host and are not part of the target 
+ *  library.
+ *  
+ *  XTEA has a long chain of dependent additions per block, so a single 
+ *  block can not use the execution units of a modern PC. In ECB and CTR
+ *  mode the blocks are independent, so 32-bit word 0 and word 1 of 4 or 8 
+ *  blocks are kept in SIMD registers and each round is executed on all of
+ *  the lanes at once. CBC encryption is a chain and is not supported.
+ *  
+ *  The output is bit-identical to xtea_encrypt(), xtea_decrypt() and 
+ *  xtea_ctr_crypt() for the same key and #XTEA_NUMBER_OF_ROUNDS and the 
+ *  same #xtea_ctx_t is used, so the two implementations can be mixed, e.g. 
+ *  the CTR stream position is updated.
+ *  
+ *  AVX2 is selected at run time if the CPU supports it. This module requires
+ *  an x86 or x86-64 host and GCC or Clang; it is not intended for the 
+ *  microcontroller targets.
+ *  
+ *  Example:
+ *  @include test/xtea_simd_test.c
+ *  
+ *  @{
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stddef.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "xtea.h"
+
+/* _____DEFINITIONS _________________________________________________________ */
+
+/* _____TYPE DEFINITIONS_____________________________________________________ */
+
+/* _____GLOBAL VARIABLES_____________________________________________________ */
+
+/* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
+/**
+ * Encrypt independent blocks (ECB mode).
+ * 
+ * The input and output buffer may be the same (in-place operation). Each
+ * block gives the same result as xtea_encrypt() with the 32-bit words 
+ * stored in big endian order.
+ * 
+ * @param ctx       Pointer to context initialised with xtea_ctx_init()
+ * @param in        Plaintext
+ * @param out       Ciphertext
+ * @param length    Number of bytes; must be a multiple of #XTEA_BLOCK_SIZE
+ * 
+ * @retval TRUE     Data encrypted
+ * @retval FALSE    Length is not a multiple of #XTEA_BLOCK_SIZE
+ */
+extern bool_t xtea_simd_ecb_encrypt(const xtea_ctx_t *ctx,
+                                    const u8_t       *in,
+                                    u8_t             *out,
+                                    size_t           length);
+
+/**
+ * Decrypt independent blocks (ECB mode).
+ * 
+ * @param ctx       Pointer to context initialised with xtea_ctx_init()
+ * @param in        Ciphertext
+ * @param out       Plaintext
+ * @param length    Number of bytes; must be a multiple of #XTEA_BLOCK_SIZE
+ * 
+ * @retval TRUE     Data decrypted
+ * @retval FALSE    Length is not a multiple of #XTEA_BLOCK_SIZE
+ */
+extern bool_t xtea_simd_ecb_decrypt(const xtea_ctx_t *ctx,
+                                    const u8_t       *in,
+                                    u8_t             *out,
+                                    size_t           length);
+
+/**
+ * Encrypt or decrypt data in CTR mode.
+ * 
+ * Same as xtea_ctr_crypt(), but the full blocks are processed in parallel.
+ * 
+ * @param ctx       Pointer to context
+ * @param in        Input data
+ * @param out       Output data
+ * @param length    Number of bytes
+ */
+extern void xtea_simd_ctr_crypt(xtea_ctx_t *ctx,
+                                const u8_t *in,
+                                u8_t       *out,
+                                size_t     length);
+
+/**
+ * Get the name of the SIMD instruction set that is used.
+ * 
+ * @return const char*  "AVX2" or "SSE2"
+ */
+extern const char* xtea_simd_get_isa(void);
+
+/* _____MACROS_______________________________________________________________ */
+
+/**
+ * @}
+ */
+#endif
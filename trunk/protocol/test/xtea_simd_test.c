@@ -0,0 +1,212 @@
+/* =============================================================================
+
+    Copyright (c) 2026 The Piconomic Firmware Library contributors
+    All rights reserved.
+    
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+    
+    * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+    
+    * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in
+     the documentation and/or other materials provided with the
+     distribution.
+    
+    * Neither the name of the copyright holders nor the names of
+     contributors may be used to endorse or promote products derived
+     from this software without specific prior written permission.
+    
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+    POSSIBILITY OF SUCH DAMAGE.
+    
+    Title:          XTEA SIMD cross-check and benchmark (host)
+    Author(s):      agent
+    Creation Date:  2026/10/19
+    Revision Info:  $Id$
+
+============================================================================= */
+
+/* 
+ * Build on a PC (from the "trunk" directory):
+ *   gcc -O2 -Igeneral -Iprotocol -I<dir with empty board.h>
+ *       protocol/test/xtea_simd_test.c protocol/test/xtea_simd.c protocol/xtea.c
+ *       -o xtea_simd_test
+ * 
+ * Add -DXTEA_KEY_SCHEDULE=1 to test the precomputed round keys.
+ * 
+ * Output of the SIMD functions is compared with xtea_encrypt(), 
+ * xtea_decrypt() and xtea_ctr_crypt() for random keys, IVs, lengths and 
+ * chunk sizes. Then the throughput of both implementations is measured.
+ */
+
+/* _____STANDARD INCLUDES____________________________________________________ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* _____PROJECT INCLUDES_____________________________________________________ */
+#include "xtea.h"
+#include "xtea_simd.h"
+
+/* _____LOCAL DEFINITIONS____________________________________________________ */
+#define TEST_ITERATIONS 1000
+#define TEST_SIZE_MAX   1000
+#define BENCH_SIZE      (64ul*1024ul*1024ul)
+
+/* _____LOCAL VARIABLES______________________________________________________ */
+static u8_t buf_in[TEST_SIZE_MAX];
+static u8_t buf_ref[TEST_SIZE_MAX];
+static u8_t buf_out[TEST_SIZE_MAX];
+
+/* _____LOCAL FUNCTIONS______________________________________________________ */
+static void fill_random(u8_t *data, size_t length)
+{
+    while(length--)
+    {
+        *data++ = (u8_t)rand();
+    }
+}
+
+static double seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static bool_t cross_check(void)
+{
+    int        n;
+    size_t     i;
+    size_t     j;
+    size_t     length;
+    size_t     chunk;
+    u8_t       key[XTEA_KEY_SIZE];
+    u8_t       iv[XTEA_BLOCK_SIZE];
+    u32_t      k[4];
+    u32_t      d[2];
+    xtea_ctx_t ctx_ref;
+    xtea_ctx_t ctx;
+
+    for(n=0; n<TEST_ITERATIONS; n++)
+    {
+        fill_random(key, sizeof(key));
+        fill_random(iv, sizeof(iv));
+        length = rand() % TEST_SIZE_MAX;
+        fill_random(buf_in, length);
+
+        // ECB against xtea_encrypt()
+        for(i=0; i<4; i++)
+        {
+            k[i] = ((u32_t)key[4*i]<<24) | ((u32_t)key[4*i+1]<<16) 
+                 | ((u32_t)key[4*i+2]<<8) | key[4*i+3];
+        }
+        xtea_init(k);
+        xtea_ctx_init(&ctx, key, iv);
+        length &= ~(XTEA_BLOCK_SIZE-1);
+        xtea_simd_ecb_encrypt(&ctx, buf_in, buf_out, length);
+        for(i=0; i<length; i+=XTEA_BLOCK_SIZE)
+        {
+            d[0] = ((u32_t)buf_in[i]<<24)   | ((u32_t)buf_in[i+1]<<16) 
+                 | ((u32_t)buf_in[i+2]<<8)  | buf_in[i+3];
+            d[1] = ((u32_t)buf_in[i+4]<<24) | ((u32_t)buf_in[i+5]<<16) 
+                 | ((u32_t)buf_in[i+6]<<8)  | buf_in[i+7];
+            xtea_encrypt(d);
+            for(j=0; j<4; j++)
+            {
+                buf_ref[i+j]   = (u8_t)(d[0] >> (24 - 8*j));
+                buf_ref[i+4+j] = (u8_t)(d[1] >> (24 - 8*j));
+            }
+            if(memcmp(&buf_out[i], &buf_ref[i], XTEA_BLOCK_SIZE) != 0)
+            {
+                printf("ECB encrypt mismatch (iteration %d, block %u)\n", n, (unsigned)i/8);
+                return FALSE;
+            }
+        }
+        xtea_simd_ecb_decrypt(&ctx, buf_out, buf_out, length);
+        if(memcmp(buf_out, buf_in, length) != 0)
+        {
+            printf("ECB decrypt mismatch (iteration %d)\n", n);
+            return FALSE;
+        }
+
+        // CTR against xtea_ctr_crypt(), fed in random chunks
+        length = rand() % TEST_SIZE_MAX;
+        xtea_ctx_init(&ctx_ref, key, iv);
+        xtea_ctr_crypt(&ctx_ref, buf_in, buf_ref, length);
+        xtea_ctx_init(&ctx, key, iv);
+        for(i=0; i<length; i+=chunk)
+        {
+            chunk = 1 + rand() % 200;
+            if(chunk > length - i)
+            {
+                chunk = length - i;
+            }
+            xtea_simd_ctr_crypt(&ctx, &buf_in[i], &buf_out[i], chunk);
+        }
+        if(memcmp(buf_out, buf_ref, length) != 0)
+        {
+            printf("CTR mismatch (iteration %d)\n", n);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void benchmark(void)
+{
+    u8_t       *data = malloc(BENCH_SIZE);
+    u8_t       key[XTEA_KEY_SIZE] = {0};
+    u8_t       iv[XTEA_BLOCK_SIZE] = {0};
+    xtea_ctx_t ctx;
+    double     t;
+    double     t_ref;
+    double     t_simd;
+
+    fill_random(data, BENCH_SIZE);
+
+    xtea_ctx_init(&ctx, key, iv);
+    t = seconds();
+    xtea_ctr_crypt(&ctx, data, data, BENCH_SIZE);
+    t_ref = seconds() - t;
+
+    xtea_ctx_init(&ctx, key, iv);
+    t = seconds();
+    xtea_simd_ctr_crypt(&ctx, data, data, BENCH_SIZE);
+    t_simd = seconds() - t;
+
+    printf("CTR %u MB: xtea_ctr_crypt() %.1f MB/s, xtea_simd_ctr_crypt() [%s] %.1f MB/s (x%.1f)\n",
+           (unsigned)(BENCH_SIZE>>20), (BENCH_SIZE>>20)/t_ref,
+           xtea_simd_get_isa(), (BENCH_SIZE>>20)/t_simd, t_ref/t_simd);
+
+    free(data);
+}
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+int main(void)
+{
+    srand(1);
+
+    if(!cross_check())
+    {
+        return 1;
+    }
+    printf("Cross-check OK (%d iterations)\n", TEST_ITERATIONS);
+
+    benchmark();
+
+    return 0;
+}
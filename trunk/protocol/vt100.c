@@ -40,11 +40,25 @@
 /* _____STANDARD INCLUDES____________________________________________________ */
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
-#include "VT100.h"
+#include "vt100.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
 #define VT100_ASCII_ESC 0x1B
 
+/// \name Receive escape sequence states
+//@{
+#define VT100_STATE_NORMAL  0   ///< Normal characters
+#define VT100_STATE_ESC     1   ///< ESC received
+#define VT100_STATE_CSI     2   ///< ESC [ received; parameters follow
+#define VT100_STATE_SS3     3   ///< ESC O received; final character follows
+//@}
+
+/// Largest CSI parameter value that is stored (larger values are clipped)
+#define VT100_CSI_PARAM_VAL_MAX 9999
+
+/// Unknown cursor row
+#define VT100_CURSOR_UNKNOWN    0xff
+
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____LOCAL VARIABLES______________________________________________________ */
@@ -53,6 +67,11 @@ static vt100_put_char_t vt100_put_char;
 
 static u8_t vt100_esc_state;
 
+/// Parameters of last received CSI sequence
+static u16_t vt100_csi_param[VT100_CSI_PARAM_MAX];
+static u8_t  vt100_csi_nr_of_params;
+static char  vt100_csi_final;
+
 /* _____LOCAL FUNCTION PROTOTYPES____________________________________________ */
 
 /* _____MACROS_______________________________________________________________ */
@@ -67,6 +86,138 @@ static void vt100_send_array(const char* data, u8_t length)
     }
 }
 
+/// Send decimal number; returns number of characters sent
+static u8_t vt100_send_nr(u8_t nr)
+{
+    u8_t length = 1;
+
+    if(nr >= 100)
+    {
+        (*vt100_put_char)('0' + nr/100);
+        nr %= 100;
+        length++;
+        (*vt100_put_char)('0' + nr/10);
+        nr %= 10;
+        length++;
+    }
+    else if(nr >= 10)
+    {
+        (*vt100_put_char)('0' + nr/10);
+        nr %= 10;
+        length++;
+    }
+    (*vt100_put_char)('0' + nr);
+
+    return length;
+}
+
+/// Number of decimal digits of a number
+static u8_t vt100_nr_of_digits(u8_t nr)
+{
+    if(nr >= 100)
+    {
+        return 3;
+    }
+    if(nr >= 10)
+    {
+        return 2;
+    }
+    return 1;
+}
+
+/// Send "ESC [ row+1 ; col+1 H"; returns number of characters sent
+static u8_t vt100_send_cursor_pos(u8_t row, u8_t col)
+{
+    u8_t length = 4;
+
+    (*vt100_put_char)(VT100_ASCII_ESC);
+    (*vt100_put_char)('[');
+    length += vt100_send_nr(row+1);
+    (*vt100_put_char)(';');
+    length += vt100_send_nr(col+1);
+    (*vt100_put_char)('H');
+
+    return length;
+}
+
+/// Convert final character of CSI or SS3 sequence to a special value
+static char vt100_decode_final(char data)
+{
+    switch(data)
+    {
+    case 'A': return VT100_ARROW_UP;
+    case 'B': return VT100_ARROW_DN;
+    case 'C': return VT100_ARROW_RIGHT;
+    case 'D': return VT100_ARROW_LEFT;
+    case 'H': return VT100_HOME;
+    case 'F': return VT100_END;
+    case 'R': return VT100_CURSOR_POS;
+    case '~':
+        switch(vt100_csi_param[0])
+        {
+        case 1:
+        case 7: return VT100_HOME;
+        case 2: return VT100_INSERT;
+        case 3: return VT100_DELETE;
+        case 4:
+        case 8: return VT100_END;
+        case 5: return VT100_PAGE_UP;
+        case 6: return VT100_PAGE_DN;
+        default: return VT100_CSI_OTHER;
+        }
+    default:
+        return VT100_CSI_OTHER;
+    }
+}
+
+static void vt100_screen_mark_dirty(vt100_screen_t *screen, u8_t row, u8_t col)
+{
+    screen->dirty_cells[row][col>>3] |= (1<<(col&7));
+    screen->dirty_rows[row>>3]       |= (1<<(row&7));
+}
+
+/// Move terminal cursor with the cheapest sequence; returns number of characters sent
+static u8_t vt100_screen_move(vt100_screen_t *screen, u8_t row, u8_t col)
+{
+    u8_t n;
+    u8_t length;
+
+    if((screen->cursor_row == row)&&(screen->cursor_col <= col))
+    {
+        // Number of columns to move forward
+        n = col - screen->cursor_col;
+        if(n == 0)
+        {
+            return 0;
+        }
+
+        // Cheaper to resend (clean) cells than "ESC [ n C"?
+        if(n <= (3 + vt100_nr_of_digits(n)))
+        {
+            vt100_send_array(&screen->cells[row][screen->cursor_col], n);
+            return n;
+        }
+
+        // Cursor forward
+        (*vt100_put_char)(VT100_ASCII_ESC);
+        (*vt100_put_char)('[');
+        length = 3 + vt100_send_nr(n);
+        (*vt100_put_char)('C');
+        return length;
+    }
+
+    // Start of next line? (terminal cursor is not on the last row)
+    if((col == 0)&&(screen->cursor_row != VT100_CURSOR_UNKNOWN)&&(screen->cursor_row+1 == row))
+    {
+        (*vt100_put_char)(VT100_CR);
+        (*vt100_put_char)(VT100_LF);
+        return 2;
+    }
+
+    // Absolute position
+    return vt100_send_cursor_pos(row, col);
+}
+
 /* _____GLOBAL FUNCTIONS_____________________________________________________ */
 void vt100_init(vt100_put_char_t put_char)
 {
@@ -85,13 +236,15 @@ void vt100_init(vt100_put_char_t put_char)
 
 char vt100_process_rx_char(char data)
 {
+    u8_t i;
+
     switch(vt100_esc_state)
     {
-    case 0:
+    case VT100_STATE_NORMAL:
         if(data == VT100_ASCII_ESC)
         {
             // Escape sequence detected
-            vt100_esc_state++;
+            vt100_esc_state = VT100_STATE_ESC;
             // Indicate that received character should be ignored
             return VT100_NONE;
         }
@@ -100,46 +253,123 @@ char vt100_process_rx_char(char data)
             // Normal character received
             return data;
         }
-    case 1:
+
+    case VT100_STATE_ESC:
         if(data == '[')
         {
-            // Escape sequence detected
-            vt100_esc_state++;
-            // Indicate that received character should be ignored
-            return VT100_NONE;
+            // Control Sequence Introducer detected; reset parameters
+            vt100_esc_state        = VT100_STATE_CSI;
+            vt100_csi_nr_of_params = 0;
+            for(i=0; i<VT100_CSI_PARAM_MAX; i++)
+            {
+                vt100_csi_param[i] = 0;
+            }
+        }
+        else if(data == 'O')
+        {
+            // Single Shift 3 detected
+            vt100_esc_state        = VT100_STATE_SS3;
+            vt100_csi_nr_of_params = 0;
+            vt100_csi_param[0]     = 0;
         }
         else
         {
-            // Incorrect escape sequence
-            vt100_esc_state = 0;
-            // Indicate that received character should be ignored
+            // Unsupported escape sequence
+            vt100_esc_state = VT100_STATE_NORMAL;
+        }
+        // Indicate that received character should be ignored
+        return VT100_NONE;
+
+    case VT100_STATE_CSI:
+        if((data >= '0')&&(data <= '9'))
+        {
+            // Parameter digit
+            if(vt100_csi_nr_of_params == 0)
+            {
+                vt100_csi_nr_of_params = 1;
+            }
+            i = vt100_csi_nr_of_params-1;
+            if(i < VT100_CSI_PARAM_MAX)
+            {
+                if(vt100_csi_param[i] <= (VT100_CSI_PARAM_VAL_MAX-9)/10)
+                {
+                    vt100_csi_param[i] = vt100_csi_param[i]*10 + (data-'0');
+                }
+                else
+                {
+                    vt100_csi_param[i] = VT100_CSI_PARAM_VAL_MAX;
+                }
+            }
             return VT100_NONE;
-        }        
-    case 2:
-        if(data == 'A')
+        }
+        if(data == ';')
         {
-            return VT100_ARROW_UP;
+            // Parameter separator (an omitted parameter is 0)
+            if(vt100_csi_nr_of_params == 0)
+            {
+                vt100_csi_nr_of_params = 1;
+            }
+            if(vt100_csi_nr_of_params != 0xff)
+            {
+                vt100_csi_nr_of_params++;
+            }
+            return VT100_NONE;
         }
-        else if(data == 'B')
+        if((data >= 0x20)&&(data <= 0x3f))
         {
-            return VT100_ARROW_DN;
+            // Ignore private parameter and intermediate characters
+            return VT100_NONE;
         }
-        else if(data == 'C')
+        vt100_esc_state = VT100_STATE_NORMAL;
+        if((data >= 0x40)&&(data <= 0x7e))
         {
-            return VT100_ARROW_RIGHT;
+            // Final character
+            vt100_csi_final = data;
+            return vt100_decode_final(data);
         }
-        else if(data == 'D')
+        // Invalid sequence
+        return VT100_NONE;
+
+    case VT100_STATE_SS3:
+        vt100_esc_state = VT100_STATE_NORMAL;
+        vt100_csi_final = data;
+        if(data == 'R')
         {
-            return VT100_ARROW_LEFT;
+            // Not a cursor position report
+            return VT100_CSI_OTHER;
         }
-        // Fall through to default case...
+        return vt100_decode_final(data);
+
     default:
-        vt100_esc_state = 0;
+        vt100_esc_state = VT100_STATE_NORMAL;
         // Indicate that received character should be ignored
         return VT100_NONE;
     }
 }
 
+u8_t vt100_get_csi_nr_of_params(void)
+{
+    if(vt100_csi_nr_of_params > VT100_CSI_PARAM_MAX)
+    {
+        return VT100_CSI_PARAM_MAX;
+    }
+    return vt100_csi_nr_of_params;
+}
+
+u16_t vt100_get_csi_param(u8_t index)
+{
+    if(index >= VT100_CSI_PARAM_MAX)
+    {
+        return 0;
+    }
+    return vt100_csi_param[index];
+}
+
+char vt100_get_csi_final(void)
+{
+    return vt100_csi_final;
+}
+
 void vt100_clear_screen(void)
 {
     const char vt100_cmd[] = {VT100_ASCII_ESC,'[','2','J'};
@@ -154,10 +384,173 @@ void vt100_erase_line(void)
     vt100_send_array(vt100_cmd,ARRAY_LENGTH(vt100_cmd));
 }
 
+void vt100_set_cursor(u8_t row, u8_t col)
+{
+    vt100_send_cursor_pos(row, col);
+}
+
+void vt100_request_cursor_pos(void)
+{
+    const char vt100_cmd[] = {VT100_ASCII_ESC,'[','6','n'};
+
+    vt100_send_array(vt100_cmd,ARRAY_LENGTH(vt100_cmd));
+}
+
+void vt100_screen_init(vt100_screen_t *screen)
+{
+    u8_t row;
+    u8_t col;
+
+    // Fill with spaces; nothing is dirty
+    for(row=0; row<VT100_SCREEN_ROWS; row++)
+    {
+        for(col=0; col<VT100_SCREEN_COLS; col++)
+        {
+            screen->cells[row][col] = ' ';
+        }
+        for(col=0; col<(VT100_SCREEN_COLS+7)/8; col++)
+        {
+            screen->dirty_cells[row][col] = 0;
+        }
+    }
+    for(row=0; row<(VT100_SCREEN_ROWS+7)/8; row++)
+    {
+        screen->dirty_rows[row] = 0;
+    }
+
+    // Clear terminal screen and move cursor to top left
+    vt100_clear_screen();
+    vt100_send_cursor_pos(0, 0);
+    screen->cursor_row = 0;
+    screen->cursor_col = 0;
+}
+
+void vt100_screen_clear(vt100_screen_t *screen)
+{
+    u8_t row;
+    u8_t col;
+
+    for(row=0; row<VT100_SCREEN_ROWS; row++)
+    {
+        for(col=0; col<VT100_SCREEN_COLS; col++)
+        {
+            vt100_screen_put_char(screen, row, col, ' ');
+        }
+    }
+}
+
+void vt100_screen_invalidate(vt100_screen_t *screen)
+{
+    u8_t row;
+    u8_t col;
+
+    for(row=0; row<VT100_SCREEN_ROWS; row++)
+    {
+        for(col=0; col<VT100_SCREEN_COLS; col++)
+        {
+            vt100_screen_mark_dirty(screen, row, col);
+        }
+    }
+
+    // Position of terminal cursor can not be trusted
+    screen->cursor_row = VT100_CURSOR_UNKNOWN;
+}
+
+void vt100_screen_put_char(vt100_screen_t *screen, 
+                           u8_t           row,
+                           u8_t           col,
+                           char           data)
+{
+    // Ignore positions outside the screen
+    if((row >= VT100_SCREEN_ROWS)||(col >= VT100_SCREEN_COLS))
+    {
+        return;
+    }
+
+    // Replace control characters
+    if((data < 0x20)||(data > 0x7e))
+    {
+        data = ' ';
+    }
+
+    // Only mark cell as dirty if it changed
+    if(screen->cells[row][col] != data)
+    {
+        screen->cells[row][col] = data;
+        vt100_screen_mark_dirty(screen, row, col);
+    }
+}
+
+void vt100_screen_put_str(vt100_screen_t *screen,
+                          u8_t           row,
+                          u8_t           col,
+                          const char     *str)
+{
+    while((*str != '\0')&&(col < VT100_SCREEN_COLS))
+    {
+        vt100_screen_put_char(screen, row, col++, *str++);
+    }
+}
+
+u16_t vt100_screen_render(vt100_screen_t *screen)
+{
+    u16_t length = 0;
+    u8_t  row;
+    u8_t  col;
+    u8_t  dirty;
+
+    for(row=0; row<VT100_SCREEN_ROWS; row++)
+    {
+        // Skip clean rows
+        if(BIT_IS_LO(screen->dirty_rows[row>>3], (row&7)))
+        {
+            continue;
+        }
+        screen->dirty_rows[row>>3] &= ~(1<<(row&7));
+
+        for(col=0; col<VT100_SCREEN_COLS; col++)
+        {
+            // Skip a group of 8 clean cells quickly
+            dirty = screen->dirty_cells[row][col>>3];
+            if(dirty == 0)
+            {
+                col |= 7;
+                continue;
+            }
+            if(BIT_IS_LO(dirty, (col&7)))
+            {
+                continue;
+            }
+            screen->dirty_cells[row][col>>3] = dirty & ~(1<<(col&7));
+
+            // Move cursor and send cell
+            length += vt100_screen_move(screen, row, col);
+            (*vt100_put_char)(screen->cells[row][col]);
+            length++;
+
+            // Update cursor position
+            screen->cursor_row = row;
+            screen->cursor_col = col+1;
+            if(screen->cursor_col == VT100_SCREEN_COLS)
+            {
+                // Cursor position depends on terminal's line wrap handling
+                screen->cursor_row = VT100_CURSOR_UNKNOWN;
+            }
+        }
+    }
+
+    return length;
+}
+
 /* _____LOG__________________________________________________________________ */
 /*
 
  2008/08/04 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Replaced escape sequence detection with a CSI parameter parser. Fixed
+   state not being reset after an arrow key sequence.
+ - Added screen model with dirty cell tracking and diff rendering
    
 */
@@ -47,12 +47,27 @@
  *  
  *  Files: vt100.h & vt100.c
  *  
+ *  @par Screen model
+ *  A status dashboard that redraws the whole screen every second wastes 
+ *  bandwidth on a slow link, because most of the screen does not change.
+ *  A #vt100_screen_t object holds an off-screen copy of the screen. The 
+ *  application writes to it with vt100_screen_put_str() etc. and every cell 
+ *  that changes is marked as dirty (with a per-row flag so that clean rows 
+ *  are skipped quickly). vt100_screen_render() only sends the dirty cells and
+ *  chooses the cheapest cursor movement between them: re-sending a short 
+ *  run of clean cells, cursor forward (CSI n C) or an absolute position 
+ *  (CSI row;col H).
+ *  
+ *  The size of the screen is set with #VT100_SCREEN_ROWS and 
+ *  #VT100_SCREEN_COLS. The screen object is allocated by the application, 
+ *  so no RAM is used if the screen model is not used.
+ *  
  *  @see
  *  - http://en.wikipedia.org/wiki/ANSI_escape_code
  *  - http://www.termsys.demon.co.uk/vtansi.htm
  *  
  *  Example:
- *  @include test/cmd_line_test.c
+ *  @include test/vt100_test.c
  *  
  *  @{
  */
@@ -63,6 +78,33 @@
 #include "common.h"
 
 /* _____DEFINITIONS _________________________________________________________ */
+#ifndef VT100_SCREEN_ROWS
+/// Number of rows of screen model
+#define VT100_SCREEN_ROWS   24
+#endif
+
+#ifndef VT100_SCREEN_COLS
+/// Number of columns of screen model
+#define VT100_SCREEN_COLS   80
+#endif
+
+/*
+ * Rows and columns are indexed with u8_t. Row 0xff marks an unknown cursor 
+ * row and vt100_screen_render() skips clean cells in groups of 8, so the 
+ * column index must not wrap after it is rounded up to the end of a group.
+ */
+#if (VT100_SCREEN_ROWS > 255)
+#error "VT100_SCREEN_ROWS must be 255 or less"
+#endif
+
+#if (VT100_SCREEN_COLS > 248)
+#error "VT100_SCREEN_COLS must be 248 or less"
+#endif
+
+#ifndef VT100_CSI_PARAM_MAX
+/// Maximum number of CSI parameters that are stored
+#define VT100_CSI_PARAM_MAX 4
+#endif
 
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /*
@@ -85,8 +127,31 @@ typedef void (*vt100_put_char_t)(char data);
 #define VT100_ARROW_DN      0x81
 #define VT100_ARROW_LEFT    0x82
 #define VT100_ARROW_RIGHT   0x83
+#define VT100_HOME          0x84
+#define VT100_END           0x85
+#define VT100_INSERT        0x86
+#define VT100_DELETE        0x87
+#define VT100_PAGE_UP       0x88
+#define VT100_PAGE_DN       0x89
+#define VT100_CURSOR_POS    0x8A    ///< Cursor position report; see vt100_get_csi_param()
+#define VT100_CSI_OTHER     0x8B    ///< Other CSI sequence; see vt100_get_csi_final()
 //@}
 
+/// Screen model (see vt100_screen_init())
+typedef struct
+{
+    /// Content of screen
+    char cells[VT100_SCREEN_ROWS][VT100_SCREEN_COLS];
+    /// Bitmask of cells that differ from the terminal (one bit per cell)
+    u8_t dirty_cells[VT100_SCREEN_ROWS][(VT100_SCREEN_COLS+7)/8];
+    /// Bitmask of rows that contain dirty cells (one bit per row)
+    u8_t dirty_rows[(VT100_SCREEN_ROWS+7)/8];
+    /// Row of terminal cursor (0 to VT100_SCREEN_ROWS-1); 0xff if unknown
+    u8_t cursor_row;
+    /// Column of terminal cursor (0 to VT100_SCREEN_COLS-1)
+    u8_t cursor_col;
+} vt100_screen_t;
+
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____GLOBAL FUNCTION DECLARATIONS_________________________________________ */
@@ -104,8 +169,13 @@ extern void vt100_init(vt100_put_char_t put_char);
  * returned to indicate that received character should be ignored, otherwise 
  * the received character is returned. 
  *  
- * If up, down, left or right arrow sequence is received, it is indicated with 
- * the special ASCII sequence. 
+ * Control Sequence Introducer sequences (ESC [ params final) are parsed 
+ * completely, including numeric parameters separated by ';'. SS3 sequences 
+ * (ESC O final) sent by terminals in application cursor key mode are 
+ * also recognised. When a sequence is complete, it is indicated with one 
+ * of the special values, e.g. #VT100_ARROW_UP, #VT100_PAGE_DN or 
+ * #VT100_CURSOR_POS. The parameters of the last sequence can be fetched 
+ * with vt100_get_csi_param().
  * 
  * @param data      Received character
  * 
@@ -115,6 +185,33 @@ extern void vt100_init(vt100_put_char_t put_char);
  */
 extern char vt100_process_rx_char(char data);
 
+/**
+ * Get the number of parameters of the last received CSI sequence.
+ * 
+ * @return u8_t     Number of parameters (0 to #VT100_CSI_PARAM_MAX)
+ */
+extern u8_t vt100_get_csi_nr_of_params(void);
+
+/**
+ * Get a numeric parameter of the last received CSI sequence.
+ * 
+ * For example, after #VT100_CURSOR_POS has been returned (in response to 
+ * vt100_request_cursor_pos()), parameter 0 is the row and parameter 1 is the 
+ * column (both starting at 1).
+ * 
+ * @param index     Parameter index (0 to #VT100_CSI_PARAM_MAX-1)
+ * 
+ * @return u16_t    Parameter value; 0 if parameter was omitted
+ */
+extern u16_t vt100_get_csi_param(u8_t index);
+
+/**
+ * Get the final character of the last received CSI sequence.
+ * 
+ * @return char     Final character, e.g. 'A' or '~'
+ */
+extern char vt100_get_csi_final(void);
+
 /**
  * Send 'clear screen' command to terminal
  */
@@ -125,6 +222,89 @@ extern void vt100_clear_screen(void);
  */
 extern void vt100_erase_line(void);
 
+/**
+ * Move cursor to specified position.
+ * 
+ * @param row       Row (0 is the top row)
+ * @param col       Column (0 is the left column)
+ */
+extern void vt100_set_cursor(u8_t row, u8_t col);
+
+/**
+ * Request a cursor position report from the terminal.
+ * 
+ * The terminal responds with a CSI sequence that is reported by
+ * vt100_process_rx_char() as #VT100_CURSOR_POS.
+ */
+extern void vt100_request_cursor_pos(void);
+
+/**
+ * Initialise screen model.
+ * 
+ * The screen model is filled with spaces and the terminal screen is cleared
+ * so that both are in the same state.
+ * 
+ * @param screen    Pointer to screen object
+ */
+extern void vt100_screen_init(vt100_screen_t *screen);
+
+/**
+ * Fill screen model with spaces.
+ * 
+ * Only cells that are not already empty are marked as dirty.
+ * 
+ * @param screen    Pointer to screen object
+ */
+extern void vt100_screen_clear(vt100_screen_t *screen);
+
+/**
+ * Mark all cells as dirty so that the whole screen is sent with the next
+ * vt100_screen_render(), e.g. when a terminal has been (re)connected.
+ * 
+ * @param screen    Pointer to screen object
+ */
+extern void vt100_screen_invalidate(vt100_screen_t *screen);
+
+/**
+ * Write a character to the screen model.
+ * 
+ * Positions outside the screen are ignored and control characters are
+ * replaced with a space.
+ * 
+ * @param screen    Pointer to screen object
+ * @param row       Row (0 to #VT100_SCREEN_ROWS-1)
+ * @param col       Column (0 to #VT100_SCREEN_COLS-1)
+ * @param data      Character
+ */
+extern void vt100_screen_put_char(vt100_screen_t *screen, 
+                                  u8_t           row,
+                                  u8_t           col,
+                                  char           data);
+
+/**
+ * Write a string to the screen model.
+ * 
+ * The string is clipped at the end of the row.
+ * 
+ * @param screen    Pointer to screen object
+ * @param row       Row (0 to #VT100_SCREEN_ROWS-1)
+ * @param col       Column of first character (0 to #VT100_SCREEN_COLS-1)
+ * @param str       Zero terminated string
+ */
+extern void vt100_screen_put_str(vt100_screen_t *screen,
+                                 u8_t           row,
+                                 u8_t           col,
+                                 const char     *str);
+
+/**
+ * Send the dirty cells of the screen model to the terminal.
+ * 
+ * @param screen    Pointer to screen object
+ * 
+ * @return u16_t    Number of bytes sent
+ */
+extern u16_t vt100_screen_render(vt100_screen_t *screen);
+
 /* _____MACROS_______________________________________________________________ */
 
 /**
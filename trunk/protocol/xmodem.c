@@ -63,6 +63,10 @@
 #define XMODEM_C                 0x43 ///< ASCII C
 //@}
 
+#if XMODEM_PBUF && (PBUF_DATA_SIZE < XMODEM_PACKET_SIZE)
+#error "PBUF_DATA_SIZE must be at least XMODEM_PACKET_SIZE (133)"
+#endif
+
 /// XMODEM error list
 typedef enum
 {
@@ -77,8 +81,16 @@ typedef enum
 } xmodem_error_t;
 
 /* _____LOCAL VARIABLES______________________________________________________ */
+#if XMODEM_PBUF
+/// Packet buffer that contains the buffer
+static pbuf_t *xmodem_packet_pbuf;
+
+/// Buffer
+static u8_t   *xmodem_packet_buffer;
+#else
 /// Buffer
 static u8_t xmodem_packet_buffer[XMODEM_PACKET_SIZE];
+#endif
 
 /// Variable to keep track of current packet number
 static u8_t xmodem_packet_number;
@@ -101,11 +113,56 @@ static void xmodem_tx_char(char data)
     (*xmodem_tx_char_fn)(data);
 }
 
+#if XMODEM_PBUF
+static void xmodem_on_rx_data(u8_t *data, u8_t bytes_received)
+{
+    pbuf_t *p = xmodem_packet_pbuf;
+
+    // Remove packet header and CRC; pass ownership on to handler
+    pbuf_header(p, -(s16_t)(data - p->payload));
+    pbuf_trim(p, bytes_received);
+    xmodem_packet_pbuf = NULL;
+    (*xmodem_on_rx_data_fn)(p);
+}
+
+/// Allocate packet buffer (if it has not been allocated yet)
+static bool_t xmodem_packet_buffer_alloc(void)
+{
+    if(xmodem_packet_pbuf == NULL)
+    {
+        xmodem_packet_pbuf = pbuf_alloc(XMODEM_PACKET_SIZE, 0);
+        if(xmodem_packet_pbuf == NULL)
+        {
+            return FALSE;
+        }
+        xmodem_packet_buffer = xmodem_packet_pbuf->payload;
+    }
+    return TRUE;
+}
+
+/// Release packet buffer
+static void xmodem_packet_buffer_release(void)
+{
+    pbuf_free(xmodem_packet_pbuf);
+    xmodem_packet_pbuf = NULL;
+}
+#else
 static void xmodem_on_rx_data(u8_t *data, u8_t bytes_received)
 {
     (*xmodem_on_rx_data_fn)(data, bytes_received);
 }
 
+static bool_t xmodem_packet_buffer_alloc(void)
+{
+    // Static buffer is used
+    return TRUE;
+}
+
+static void xmodem_packet_buffer_release(void)
+{
+}
+#endif
+
 static bool_t xmodem_on_tx_data(u8_t *data, u8_t bytes_to_send)
 {
     return (*xmodem_on_tx_data_fn)(data, bytes_to_send);
@@ -314,6 +371,12 @@ bool_t xmodem_rx_file(void)
             xmodem_tx_char(XMODEM_C);
         }
 
+        // Make sure that there is a buffer to receive the packet
+        if(!xmodem_packet_buffer_alloc())
+        {
+            return FALSE;
+        }
+
         // Receive packet
         error = xmodem_rx_packet();
         
@@ -334,6 +397,8 @@ bool_t xmodem_rx_file(void)
             break;
 
         case XMODEM_RECEIVED_EOT:           
+            // Buffer is not needed anymore
+            xmodem_packet_buffer_release();
             // Acknowledge EOT and make sure sender has received ACK
             XMODEM_EOT_STATE:
             while(--retry_count)
@@ -380,6 +445,8 @@ bool_t xmodem_rx_file(void)
         }        
     }
 
+    xmodem_packet_buffer_release();
+
     // File not successfully transferred
     return FALSE;
 }
@@ -402,6 +469,12 @@ bool_t xmodem_tx_file(void)
         return FALSE;
     }
 
+    // Buffer for packets
+    if(!xmodem_packet_buffer_alloc())
+    {
+        return FALSE;
+    }
+
     // Get data packet to send
     while(xmodem_on_tx_data(xmodem_packet_buffer+3, XMODEM_DATA_SIZE) == TRUE)
     {
@@ -433,6 +506,7 @@ bool_t xmodem_tx_file(void)
         // See if retry count was exceeded
         if(retry_count == 0)
         {
+            xmodem_packet_buffer_release();
             return FALSE;
         }
 
@@ -440,6 +514,8 @@ bool_t xmodem_tx_file(void)
         xmodem_packet_number++;
     }
 
+    xmodem_packet_buffer_release();
+
     // Send "End Of Transfer"
     xmodem_tx_char(XMODEM_EOT);
 
@@ -455,5 +531,8 @@ bool_t xmodem_tx_file(void)
  
  2010-04-23 : Pieter.Conradie
  - Added xmodem_tx_file(...)
+
+ 2026-10-19 : agent
+ - Added option to receive packets in packet buffers (XMODEM_PBUF)
    
 */
@@ -60,6 +60,15 @@
  *  - NAK (0x15) : Not Acknowledge
  *  - EOT (0x04) : End of Transmission 
  *  
+ *  @par Packet buffers
+ *  If #XMODEM_PBUF is set to 1, each packet is received directly into a 
+ *  @ref PBUF packet buffer and the data handler receives ownership of a 
+ *  buffer that contains the 128 data bytes (with the 3 header bytes 
+ *  available as header reserve). It must release it with pbuf_free() or 
+ *  pass it on, e.g. to at45d_write_page_pbuf(). #PBUF_DATA_SIZE must be at 
+ *  least 133 bytes so that a packet fits in one buffer. The static packet 
+ *  buffer is not used.
+ *  
  *  @see http://en.wikipedia.org/wiki/XMODEM
  *  
  *  @{
@@ -68,6 +77,16 @@
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
 
+/* _____DEFINITIONS _________________________________________________________ */
+#ifndef XMODEM_PBUF
+/// Flag to receive packets into packet buffers (see @ref PBUF)
+#define XMODEM_PBUF 0
+#endif
+
+#if XMODEM_PBUF
+#include "pbuf.h"
+#endif
+
 /* _____TYPE DEFINITIONS_____________________________________________________ */
 /**
  * Definition for a pointer to a function that will be called to 
@@ -81,11 +100,19 @@ typedef bool_t (*xmodem_rx_char_t)(char* data);
  */
 typedef void (*xmodem_tx_char_t)(char data);
 
+#if XMODEM_PBUF
+/** 
+ * Definition for a pointer to a function that will be called once a frame
+ * has been received. The handler becomes the owner of the buffer.
+ */
+typedef void (*xmodem_on_rx_data_t)(pbuf_t *data);
+#else
 /** 
  * Definition for a pointer to a function that will be called once a frame
  * has been received.
  */
 typedef void (*xmodem_on_rx_data_t)(u8_t *data, u8_t bytes_received);
+#endif
 
 /**
  *  Definition for a pointer to a function that will be called to provide
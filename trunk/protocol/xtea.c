@@ -43,75 +43,338 @@
 #include "xtea.h"
 
 /* _____LOCAL DEFINITIONS____________________________________________________ */
-#ifndef XTEA_NUMBER_OF_ROUNDS
-#define XTEA_NUMBER_OF_ROUNDS 16
-#endif
-
 #define XTEA_DELTA            0x9E3779B9
 
+#if XTEA_KEY_SCHEDULE && (XTEA_NUMBER_OF_ROUNDS & 1)
+#error "XTEA_NUMBER_OF_ROUNDS must be even if XTEA_KEY_SCHEDULE is enabled"
+#endif
+
 /* _____MACROS_______________________________________________________________ */
+/// Load big endian 32-bit value from byte array
+#define XTEA_LOAD_BE32(p)       (  (((u32_t)(p)[0])<<24) | (((u32_t)(p)[1])<<16) \
+                                 | (((u32_t)(p)[2])<<8)  | ((u32_t)(p)[3])       )
+
+/// Store 32-bit value in byte array in big endian order
+#define XTEA_STORE_BE32(p,val)  { (p)[0] = U32_HI8(val); (p)[1] = U32_MH8(val); \
+                                  (p)[2] = U32_ML8(val); (p)[3] = U32_LO8(val); }
+
+/// One encryption cycle (two Feistel rounds) with precomputed round keys
+#define XTEA_ENCRYPT_CYCLE(d0, d1, k) \
+    d0 += (((d1 << 4) ^ (d1 >> 5)) + d1) ^ (k)[0]; \
+    d1 += (((d0 << 4) ^ (d0 >> 5)) + d0) ^ (k)[1];
+
+/// One decryption cycle (two Feistel rounds) with precomputed round keys
+#define XTEA_DECRYPT_CYCLE(d0, d1, k) \
+    d1 -= (((d0 << 4) ^ (d0 >> 5)) + d0) ^ (k)[1]; \
+    d0 -= (((d1 << 4) ^ (d1 >> 5)) + d1) ^ (k)[0];
 
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
 /* _____LOCAL VARIABLES______________________________________________________ */
-static u32_t xtea_key[4];
+static u32_t xtea_key[XTEA_KEY_WORDS];
 
 /* _____LOCAL FUNCTION DECLARATIONS__________________________________________ */
 
 /* _____LOCAL FUNCTIONS______________________________________________________ */
-
-/* _____GLOBAL FUNCTIONS_____________________________________________________ */
-void xtea_init(const u32_t key[4])
+/// Copy key or expand it into round keys
+static void xtea_set_key(u32_t dst[XTEA_KEY_WORDS], const u32_t key[4])
 {
-    u8_t i;
+    u8_t  i;
+#if XTEA_KEY_SCHEDULE
+    u32_t sum = 0;
 
+    for(i=0; i<XTEA_KEY_WORDS; i+=2)
+    {
+        dst[i]   = sum + key[sum & 3];
+        sum     += XTEA_DELTA;
+        dst[i+1] = sum + key[(sum>>11) & 3];
+    }
+#else
     for(i=0;i<4;i++)
     {
-        xtea_key[i] = key[i];
+        dst[i] = key[i];
     }
+#endif
 }
 
-void xtea_encrypt(u32_t data[2])
+#if XTEA_KEY_SCHEDULE
+
+/// Encrypt one block with precomputed round keys
+static inline void xtea_encrypt_block(const u32_t key[XTEA_KEY_WORDS], u32_t *v0, u32_t *v1)
+{
+    const u32_t *k   = key;
+    const u32_t *end = &key[XTEA_KEY_WORDS];
+    u32_t       d0   = *v0;
+    u32_t       d1   = *v1;
+
+    // Two cycles per iteration
+    do
+    {
+        XTEA_ENCRYPT_CYCLE(d0, d1, &k[0]);
+        XTEA_ENCRYPT_CYCLE(d0, d1, &k[2]);
+        k += 4;
+    }
+    while(k != end);
+
+    *v0 = d0;
+    *v1 = d1;
+}
+
+/// Decrypt one block with precomputed round keys
+static inline void xtea_decrypt_block(const u32_t key[XTEA_KEY_WORDS], u32_t *v0, u32_t *v1)
 {
-    u8_t i;
+    const u32_t *k = &key[XTEA_KEY_WORDS];
+    u32_t       d0 = *v0;
+    u32_t       d1 = *v1;
 
-    u32_t d0  = data[0];
-    u32_t d1  = data[1];
+    // Two cycles per iteration
+    do
+    {
+        k -= 4;
+        XTEA_DECRYPT_CYCLE(d0, d1, &k[2]);
+        XTEA_DECRYPT_CYCLE(d0, d1, &k[0]);
+    }
+    while(k != key);
+
+    *v0 = d0;
+    *v1 = d1;
+}
+
+#else
+
+/// Encrypt one block with the specified key
+static inline void xtea_encrypt_block(const u32_t key[4], u32_t *v0, u32_t *v1)
+{
+    u8_t  i;
+    u32_t d0  = *v0;
+    u32_t d1  = *v1;
     u32_t sum = 0;
 
     for (i=XTEA_NUMBER_OF_ROUNDS; i != 0; i--)
     {
-        d0  += (((d1 << 4) ^ (d1 >> 5)) + d1) ^ (sum + xtea_key[sum & 3]);
+        d0  += (((d1 << 4) ^ (d1 >> 5)) + d1) ^ (sum + key[sum & 3]);
         sum += XTEA_DELTA;
-        d1  += (((d0 << 4) ^ (d0 >> 5)) + d0) ^ (sum + xtea_key[(sum>>11) & 3]);
+        d1  += (((d0 << 4) ^ (d0 >> 5)) + d0) ^ (sum + key[(sum>>11) & 3]);
     }
-    data[0] = d0;
-    data[1] = d1;
+    *v0 = d0;
+    *v1 = d1;
 }
 
-void xtea_decrypt(u32_t data[2])
+/// Decrypt one block with the specified key
+static inline void xtea_decrypt_block(const u32_t key[4], u32_t *v0, u32_t *v1)
 {
-    u8_t i;
-
-    u32_t d0  = data[0];
-    u32_t d1  = data[1];
+    u8_t  i;
+    u32_t d0  = *v0;
+    u32_t d1  = *v1;
     u32_t sum = XTEA_DELTA*XTEA_NUMBER_OF_ROUNDS;
 
     for (i=XTEA_NUMBER_OF_ROUNDS; i != 0; i--)
     {
-        d1  -= (((d0 << 4) ^ (d0 >> 5)) + d0) ^ (sum + xtea_key[(sum>>11) & 3]);
+        d1  -= (((d0 << 4) ^ (d0 >> 5)) + d0) ^ (sum + key[(sum>>11) & 3]);
         sum -= XTEA_DELTA;
-        d0  -= (((d1 << 4) ^ (d1 >> 5)) + d1) ^ (sum + xtea_key[sum & 3]);
+        d0  -= (((d1 << 4) ^ (d1 >> 5)) + d1) ^ (sum + key[sum & 3]);
     }
-    data[0] = d0;
-    data[1] = d1;
+    *v0 = d0;
+    *v1 = d1;
+}
+
+#endif
+
+/* _____GLOBAL FUNCTIONS_____________________________________________________ */
+void xtea_init(const u32_t key[4])
+{
+    xtea_set_key(xtea_key, key);
+}
+
+void xtea_encrypt(u32_t data[2])
+{
+    xtea_encrypt_block(xtea_key, &data[0], &data[1]);
 }
 
+void xtea_decrypt(u32_t data[2])
+{
+    xtea_decrypt_block(xtea_key, &data[0], &data[1]);
+}
+
+void xtea_ctx_init(xtea_ctx_t *ctx,
+                   const u8_t key[XTEA_KEY_SIZE],
+                   const u8_t iv[XTEA_BLOCK_SIZE])
+{
+    u8_t  i;
+    u32_t k[4];
+
+    for(i=0;i<4;i++)
+    {
+        k[i] = XTEA_LOAD_BE32(&key[4*i]);
+    }
+    xtea_set_key(ctx->key, k);
+    xtea_ctx_set_iv(ctx, iv);
+}
+
+void xtea_ctx_set_iv(xtea_ctx_t *ctx,
+                     const u8_t iv[XTEA_BLOCK_SIZE])
+{
+    ctx->iv[0]        = XTEA_LOAD_BE32(&iv[0]);
+    ctx->iv[1]        = XTEA_LOAD_BE32(&iv[4]);
+
+    // Key stream is empty
+    ctx->stream_index = XTEA_BLOCK_SIZE;
+}
+
+void xtea_ctr_crypt(xtea_ctx_t *ctx,
+                    const u8_t *in,
+                    u8_t       *out,
+                    size_t     length)
+{
+    u8_t  i;
+    u32_t c0;
+    u32_t c1;
+    u32_t k0;
+    u32_t k1;
+
+    // Use remainder of key stream block of previous call
+    while((ctx->stream_index < XTEA_BLOCK_SIZE) && (length != 0))
+    {
+        *out++ = *in++ ^ ctx->stream[ctx->stream_index++];
+        length--;
+    }
+
+    // Process full blocks; counter is kept in local variables
+    c0 = ctx->iv[0];
+    c1 = ctx->iv[1];
+    while(length >= XTEA_BLOCK_SIZE)
+    {
+        k0 = c0;
+        k1 = c1;
+        xtea_encrypt_block(ctx->key, &k0, &k1);
+
+        // Increment 64-bit counter
+        if(++c1 == 0)
+        {
+            c0++;
+        }
+
+        k0 ^= XTEA_LOAD_BE32(&in[0]);
+        k1 ^= XTEA_LOAD_BE32(&in[4]);
+        XTEA_STORE_BE32(&out[0], k0);
+        XTEA_STORE_BE32(&out[4], k1);
+
+        in     += XTEA_BLOCK_SIZE;
+        out    += XTEA_BLOCK_SIZE;
+        length -= XTEA_BLOCK_SIZE;
+    }
+
+    // Generate key stream block for last partial block
+    if(length != 0)
+    {
+        k0 = c0;
+        k1 = c1;
+        xtea_encrypt_block(ctx->key, &k0, &k1);
+        if(++c1 == 0)
+        {
+            c0++;
+        }
+        XTEA_STORE_BE32(&ctx->stream[0], k0);
+        XTEA_STORE_BE32(&ctx->stream[4], k1);
+
+        for(i=0; i<length; i++)
+        {
+            out[i] = in[i] ^ ctx->stream[i];
+        }
+        ctx->stream_index = i;
+    }
+
+    ctx->iv[0] = c0;
+    ctx->iv[1] = c1;
+}
+
+bool_t xtea_cbc_encrypt(xtea_ctx_t *ctx,
+                        const u8_t *in,
+                        u8_t       *out,
+                        size_t     length)
+{
+    u32_t d0;
+    u32_t d1;
+
+    if((length % XTEA_BLOCK_SIZE) != 0)
+    {
+        return FALSE;
+    }
+
+    // Chaining value is kept in local variables
+    d0 = ctx->iv[0];
+    d1 = ctx->iv[1];
+    while(length != 0)
+    {
+        d0 ^= XTEA_LOAD_BE32(&in[0]);
+        d1 ^= XTEA_LOAD_BE32(&in[4]);
+        xtea_encrypt_block(ctx->key, &d0, &d1);
+        XTEA_STORE_BE32(&out[0], d0);
+        XTEA_STORE_BE32(&out[4], d1);
+
+        in     += XTEA_BLOCK_SIZE;
+        out    += XTEA_BLOCK_SIZE;
+        length -= XTEA_BLOCK_SIZE;
+    }
+    ctx->iv[0] = d0;
+    ctx->iv[1] = d1;
+
+    return TRUE;
+}
+
+bool_t xtea_cbc_decrypt(xtea_ctx_t *ctx,
+                        const u8_t *in,
+                        u8_t       *out,
+                        size_t     length)
+{
+    u32_t c0;
+    u32_t c1;
+    u32_t d0;
+    u32_t d1;
+    u32_t prev0;
+    u32_t prev1;
+
+    if((length % XTEA_BLOCK_SIZE) != 0)
+    {
+        return FALSE;
+    }
+
+    // Chaining value is kept in local variables
+    prev0 = ctx->iv[0];
+    prev1 = ctx->iv[1];
+    while(length != 0)
+    {
+        // Save ciphertext (in and out may be the same buffer)
+        c0 = XTEA_LOAD_BE32(&in[0]);
+        c1 = XTEA_LOAD_BE32(&in[4]);
+        d0 = c0;
+        d1 = c1;
+        xtea_decrypt_block(ctx->key, &d0, &d1);
+        d0 ^= prev0;
+        d1 ^= prev1;
+        XTEA_STORE_BE32(&out[0], d0);
+        XTEA_STORE_BE32(&out[4], d1);
+        prev0 = c0;
+        prev1 = c1;
+
+        in     += XTEA_BLOCK_SIZE;
+        out    += XTEA_BLOCK_SIZE;
+        length -= XTEA_BLOCK_SIZE;
+    }
+    ctx->iv[0] = prev0;
+    ctx->iv[1] = prev1;
+
+    return TRUE;
+}
 
 /* _____LOG__________________________________________________________________ */
 /*
 
  2010/05/03 : Pieter.Conradie
  - Created
+
+ 2026/10/19 : agent
+ - Added CTR and CBC modes of operation with a per-context key
+ - Added precomputed round key schedule (XTEA_KEY_SCHEDULE)
    
 */
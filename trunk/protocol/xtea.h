@@ -47,19 +47,91 @@
  *  
  *  Files: xtea.h & xtea.c
  *  
+ *  xtea_init(), xtea_encrypt() and xtea_decrypt() operate on a single 64-bit
+ *  block with a global key. For buffers of arbitrary size, the CTR and CBC 
+ *  modes of operation are provided with a per-context key (#xtea_ctx_t). 
+ *  The round state is kept in local variables for all of the blocks of a 
+ *  buffer, so there is only one function call per buffer instead of one per
+ *  8 bytes.
+ *  
+ *  With #XTEA_KEY_SCHEDULE enabled (disabled by default), the round keys 
+ *  are precomputed when the key is set and the rounds are unrolled. 
+ *  
+ *  The byte order is explicit: 32-bit words of the key, IV and data are
+ *  big endian, as in the reference implementation. 
+ *  
+ *  @par CTR mode
+ *  A 64-bit counter block (initialised with the IV and incremented after 
+ *  each block) is encrypted to generate a key stream that is XOR'd with the
+ *  data. Encryption and decryption is the same operation, the data does not
+ *  have to be a multiple of 8 bytes and the key stream position is retained
+ *  between calls, so data can be processed in chunks as it arrives. The same 
+ *  key and IV combination must never be used for more than one message.
+ *  
+ *  @par CBC mode
+ *  Each plaintext block is XOR'd with the previous ciphertext block (the IV 
+ *  for the first one) before it is encrypted. The data must be a multiple 
+ *  of 8 bytes. The chaining value is retained between calls.
+ *  
+ *  @see http://en.wikipedia.org/wiki/Block_cipher_modes_of_operation
+ *  
  *  @see http://en.wikipedia.org/wiki/XTEA
  *  
  *  @{
  */
 
 /* _____STANDARD INCLUDES____________________________________________________ */
+#include <stddef.h>
 
 /* _____PROJECT INCLUDES_____________________________________________________ */
 #include "common.h"
 
 /* _____DEFINITIONS _________________________________________________________ */
+#ifndef XTEA_NUMBER_OF_ROUNDS
+/// Number of cycles (a cycle is two Feistel rounds); must be even
+#define XTEA_NUMBER_OF_ROUNDS 16
+#endif
+
+#ifndef XTEA_KEY_SCHEDULE
+/**
+ * Flag to precompute the round keys in xtea_init() and xtea_ctx_init().
+ * 
+ * The value (sum + key[...]) that is added in each round depends only on 
+ * the key, so it can be calculated once when the key is set instead of for
+ * every block. This removes the indexed 32-bit loads and the update of 
+ * 'sum' from the inner loop, but uses 2 x #XTEA_NUMBER_OF_ROUNDS x 4 bytes
+ * of RAM per key (128 bytes for 16 cycles) instead of 16 bytes.
+ * 
+ * Disabled by default, so that existing users keep the compact 
+ * implementation. Set to 1 where speed is more important than RAM.
+ */
+#define XTEA_KEY_SCHEDULE 0
+#endif
+
+#if XTEA_KEY_SCHEDULE
+/// Number of 32-bit words to store a key (precomputed round keys)
+#define XTEA_KEY_WORDS  (2*XTEA_NUMBER_OF_ROUNDS)
+#else
+/// Number of 32-bit words to store a key
+#define XTEA_KEY_WORDS  4
+#endif
+
+
+/// Block size in bytes
+#define XTEA_BLOCK_SIZE 8
+
+/// Key size in bytes
+#define XTEA_KEY_SIZE   16
 
 /* _____TYPE DEFINITIONS_____________________________________________________ */
+/// Context for CTR and CBC modes of operation
+typedef struct
+{
+    u32_t key[XTEA_KEY_WORDS];      ///< 128-bit key or precomputed round keys
+    u32_t iv[2];                    ///< CTR counter block or CBC chaining value
+    u8_t  stream[XTEA_BLOCK_SIZE];  ///< CTR key stream block
+    u8_t  stream_index;             ///< Index of next unused byte in key stream block
+} xtea_ctx_t;
 
 /* _____GLOBAL VARIABLES_____________________________________________________ */
 
@@ -85,6 +157,77 @@ extern void xtea_encrypt(u32_t data[2]);
  */
 extern void xtea_decrypt(u32_t data[2]);
 
+/**
+ * Initialise a context with a 128-bit key and a 64-bit IV.
+ * 
+ * @param ctx   Pointer to context
+ * @param key   #XTEA_KEY_SIZE bytes
+ * @param iv    #XTEA_BLOCK_SIZE bytes (initial counter block or CBC IV)
+ */
+extern void xtea_ctx_init(xtea_ctx_t *ctx,
+                          const u8_t key[XTEA_KEY_SIZE],
+                          const u8_t iv[XTEA_BLOCK_SIZE]);
+
+/**
+ * Set a new IV, e.g. to start a new message with the same key.
+ * 
+ * @param ctx   Pointer to context
+ * @param iv    #XTEA_BLOCK_SIZE bytes (initial counter block or CBC IV)
+ */
+extern void xtea_ctx_set_iv(xtea_ctx_t *ctx,
+                            const u8_t iv[XTEA_BLOCK_SIZE]);
+
+/**
+ * Encrypt or decrypt data in CTR mode.
+ * 
+ * The input and output buffer may be the same (in-place operation).
+ * 
+ * @param ctx       Pointer to context
+ * @param in        Input data
+ * @param out       Output data
+ * @param length    Number of bytes
+ */
+extern void xtea_ctr_crypt(xtea_ctx_t *ctx,
+                           const u8_t *in,
+                           u8_t       *out,
+                           size_t     length);
+
+/**
+ * Encrypt data in CBC mode.
+ * 
+ * The input and output buffer may be the same (in-place operation).
+ * 
+ * @param ctx       Pointer to context
+ * @param in        Plaintext
+ * @param out       Ciphertext
+ * @param length    Number of bytes; must be a multiple of #XTEA_BLOCK_SIZE
+ * 
+ * @retval TRUE     Data encrypted
+ * @retval FALSE    Length is not a multiple of #XTEA_BLOCK_SIZE
+ */
+extern bool_t xtea_cbc_encrypt(xtea_ctx_t *ctx,
+                               const u8_t *in,
+                               u8_t       *out,
+                               size_t     length);
+
+/**
+ * Decrypt data in CBC mode.
+ * 
+ * The input and output buffer may be the same (in-place operation).
+ * 
+ * @param ctx       Pointer to context
+ * @param in        Ciphertext
+ * @param out       Plaintext
+ * @param length    Number of bytes; must be a multiple of #XTEA_BLOCK_SIZE
+ * 
+ * @retval TRUE     Data decrypted
+ * @retval FALSE    Length is not a multiple of #XTEA_BLOCK_SIZE
+ */
+extern bool_t xtea_cbc_decrypt(xtea_ctx_t *ctx,
+                               const u8_t *in,
+                               u8_t       *out,
+                               size_t     length);
+
 /* _____MACROS_______________________________________________________________ */
 
 /**